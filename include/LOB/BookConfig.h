@@ -0,0 +1,76 @@
+/**
+ * @file BookConfig.h
+ * @brief Construction-time tuning parameters for the Order Book.
+ * @details Everything that sizes memory or shapes the data layout of an OrderBook is decided once,
+ * at construction, and gathered here. Nothing in this struct is consulted on the hot path beyond
+ * what the individual components cache for themselves.
+ */
+#pragma once
+#include <cstddef>
+#include "Order.h"
+#include "OrderIndex.h"
+
+namespace LOB {
+
+    /**
+     * @struct BookConfig
+     * @brief Aggregate of sizing knobs passed to the OrderBook constructor.
+     * @note Default values reproduce the behaviour of the original, hard-coded book.
+     */
+    struct BookConfig {
+        // --- Flat Price Ladder (ignored by the std::map backend) ---
+
+        /** First price of the initial tick window. 0 means "centre the window on the first order". */
+        Price basePrice = 0;
+
+        /** Minimum price increment. Orders whose price is not a multiple of it are rejected. 0 is treated as 1. */
+        Price tickSize = 1;
+
+        /** Number of tick slots in the initial window. The ladder grows if the book outgrows it. */
+        size_t ladderTicks = 4096;
+
+        /** Most tick slots the window may grow to. A price the window cannot reach within it is rejected (InvalidPrice). */
+        size_t maxLadderTicks = size_t{1} << 20;
+
+        // --- Memory Pools ---
+
+        /** Order slots reserved (and pre-touched) at construction. Also the size of every growth slab. */
+        size_t orderPoolCapacity = 10000;
+
+        /** Grow by another slab instead of rejecting orders when the pool is exhausted. */
+        bool orderPoolGrowable = false;
+
+        /** Back the pool slabs with 2 MB pages where supported, to cut TLB misses. */
+        bool useHugePages = false;
+
+        /** mlock every pool slab once it is pre-touched, so it can never be paged out (best effort). */
+        bool lockPages = false;
+
+        /** LimitLevel slots per side for the std::map backend (grows by slabs of this size, never rejects). */
+        size_t levelPoolCapacity = 1024;
+
+        // --- Order Index ---
+
+        /** Hashed (any ID pattern) or Dense (monotonically increasing IDs, direct-mapped). */
+        OrderIndexMode orderIndexMode = OrderIndexMode::Hashed;
+
+        /** Expected live orders used to pre-size the index. 0 means "same as orderPoolCapacity". */
+        size_t orderIndexCapacity = 0;
+
+        // --- Execution Sink ---
+
+        /** Slots in the QueueSink event queue (ignored by NullSink). */
+        size_t eventQueueCapacity = 65536;
+
+        /** Shared-memory gateway region a SharedMemorySink publishes into (see SharedMemoryGateway.h). */
+        const char* gatewayName = nullptr;
+
+        // --- Pre-Trade Risk (RiskSink only, see RiskGate.h) ---
+
+        /** Accounts tracked by the risk ledger (AccountIds 0 .. riskAccounts - 1). */
+        size_t riskAccounts = 64;
+
+        /** Working orders the risk ledger can attribute at once. 0 means "same as orderPoolCapacity". */
+        size_t riskOrderCapacity = 0;
+    };
+}
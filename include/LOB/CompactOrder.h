@@ -0,0 +1,130 @@
+/**
+ * @file CompactOrder.h
+ * @brief Opt-in compact order layout: 32-bit pool links, side packed into spare bits, configurable widths.
+ * @details The default Order is 48 bytes (three uint64_t, a Side plus padding, two 64-bit pointers), so a
+ * queue walk touches more than one cache line per order. CompactOrder trades pointers for IndexPool handles:
+ *
+ * | Field      | Order    | CompactOrder<uint64_t, uint64_t> | CompactOrder<uint32_t, uint32_t> |
+ * | :---       | :---     | :---                             | :---                             |
+ * | id         | 8        | 8                                | 8                                |
+ * | price, qty | 16       | 16                               | 8                                |
+ * | side       | 1 (+7)   | bit 31 of the prev link          | bit 31 of the prev link          |
+ * | next, prev | 16       | 8                                | 8                                |
+ * | **Total**  | **48**   | **32 (2 per line)**              | **24**                           |
+ *
+ * CompactLevel is the matching FIFO queue (head/tail are indices too). It resolves links through the
+ * IndexPool passed to each call, so the level itself stays 24 bytes.
+ */
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "Order.h"
+#include "IndexPool.h"
+
+namespace LOB {
+
+    /**
+     * @struct CompactOrder
+     * @brief Limit order whose list links are 32-bit IndexPool handles.
+     * @tparam PriceT Unsigned integer type wide enough for the instrument's prices (in ticks).
+     * @tparam QtyT Unsigned integer type wide enough for its order sizes.
+     * @note Up to 2^31 - 1 orders per pool: the top bit of the prev link stores the side.
+     */
+    template <typename PriceT = uint32_t, typename QtyT = uint32_t>
+    struct CompactOrder {
+        static_assert(std::is_unsigned_v<PriceT> && std::is_unsigned_v<QtyT>, "Price/quantity widths must be unsigned");
+
+        using Index = uint32_t;
+        static constexpr Index NIL = 0x7FFFFFFFu;       /**< Null link (31 bits). */
+        static constexpr uint32_t SIDE_BIT = 0x80000000u;
+
+        OrderId id;
+        PriceT price;
+        QtyT quantity;
+
+        Index next = NIL;
+        uint32_t prevAndSide = NIL; // bits 0..30: prev link, bit 31: 1 = Sell
+
+        CompactOrder() = default;
+
+        CompactOrder(OrderId id, PriceT price, QtyT qty, Side side)
+            : id(id), price(price), quantity(qty),
+              prevAndSide(NIL | (side == Side::Sell ? SIDE_BIT : 0)) {}
+
+        Side side() const { return (prevAndSide & SIDE_BIT) ? Side::Sell : Side::Buy; }
+        Index prev() const { return prevAndSide & ~SIDE_BIT; }
+        void setPrev(Index idx) { prevAndSide = (prevAndSide & SIDE_BIT) | idx; }
+    };
+
+    static_assert(sizeof(CompactOrder<uint64_t, uint64_t>) == 32, "Two wide compact orders must share a cache line");
+    static_assert(sizeof(CompactOrder<uint32_t, uint32_t>) == 24, "Narrow compact order must stay 24 bytes");
+
+    /**
+     * @class CompactLevel
+     * @brief FIFO queue of CompactOrders at one price (the index-linked counterpart of LimitLevel).
+     * @tparam OrderT A CompactOrder instantiation.
+     */
+    template <typename OrderT>
+    class CompactLevel {
+        public:
+            using Index = typename OrderT::Index;
+            using Pool = IndexPool<OrderT>;
+
+        private:
+            Price price_;
+            Quantity totalVolume_ = 0;
+            Index head_ = OrderT::NIL;
+            Index tail_ = OrderT::NIL;
+
+        public:
+            explicit CompactLevel(Price p) : price_(p) {}
+
+            /**
+             * @brief Adds an order to the tail.
+             * @note Complexity: O(1)
+             */
+            void append(Index idx, Pool& pool){
+                OrderT& order = pool[idx];
+                order.next = OrderT::NIL;
+                order.setPrev(tail_);
+
+                if(tail_ == OrderT::NIL) head_ = idx;
+                else pool[tail_].next = idx;
+                tail_ = idx;
+
+                totalVolume_ += order.quantity;
+            }
+
+            /**
+             * @brief Unlinks an order from anywhere in the queue.
+             * @note Complexity: O(1)
+             */
+            void remove(Index idx, Pool& pool){
+                OrderT& order = pool[idx];
+                Index prev = order.prev();
+
+                if(prev != OrderT::NIL) pool[prev].next = order.next;
+                else head_ = order.next;
+
+                if(order.next != OrderT::NIL) pool[order.next].setPrev(prev);
+                else tail_ = prev;
+
+                order.next = OrderT::NIL;
+                order.setPrev(OrderT::NIL);
+                totalVolume_ -= order.quantity;
+            }
+
+            /**
+             * @brief Executes part (or all) of an order in place.
+             */
+            void fill(Index idx, Quantity qty, Pool& pool){
+                pool[idx].quantity -= static_cast<decltype(pool[idx].quantity)>(qty);
+                totalVolume_ -= qty;
+            }
+
+            bool isEmpty() const { return head_ == OrderT::NIL; }
+            Price getPrice() const { return price_; }
+            Quantity getVolume() const { return totalVolume_; }
+            Index getHead() const { return head_; }
+    };
+}
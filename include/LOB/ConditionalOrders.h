@@ -0,0 +1,174 @@
+/**
+ * @file ConditionalOrders.h
+ * @brief Side structures for the order types that are not plain limits: parked stops and iceberg reserves.
+ * @details Neither feature touches Order, the price ladders or the plain-limit path of the book:
+ * 1. **StopBook:** Stops wait here, off the book, indexed by trigger price (buy stops ascending, sell stops
+ *    descending, FIFO within a price). The two nearest triggers are cached, so the book asks isTriggered() only
+ *    when a match moved the last trade price, and walks the structure only when a boundary was actually crossed.
+ * 2. **IcebergTable:** The hidden reserve and display size of each iceberg, by ID. The displayed slice is an ordinary
+ *    resting Order; the book consults the table only on levels whose LimitLevel::getIcebergCount() is non-zero.
+ *
+ * Both allocate when a stop or an iceberg is submitted, never on the matching path of plain orders.
+ */
+#pragma once
+#include <map>
+#include <functional>
+#include <limits>
+#include <cstddef>
+#include <unordered_map>
+#include "Order.h"
+#include "OrderRequest.h"
+
+namespace LOB {
+
+    /**
+     * @struct StopOrder
+     * @brief An order held back until the last trade price reaches 'stopPrice'.
+     */
+    struct StopOrder {
+        OrderId id;
+        Price stopPrice;    /**< Buy: triggers once a trade prints at or above it. Sell: at or below it. */
+        Price price;        /**< Limit price of the released order (ignored for Market). */
+        Quantity qty;
+        Side side;
+        OrderType type;     /**< How the order is submitted once triggered (Market = stop, Limit = stop-limit). */
+    };
+
+    /**
+     * @class StopBook
+     * @brief Price-indexed trigger structure of the parked stops of one book.
+     */
+    class StopBook {
+        private:
+            // Buy stops trigger lowest first, sell stops highest first (multimap keeps arrival order per price).
+            std::multimap<Price, StopOrder> buys_;
+            std::multimap<Price, StopOrder, std::greater<Price>> sells_;
+            std::unordered_map<OrderId, std::pair<Side, Price>> ids_;
+
+            // Nearest triggers: a trade at or beyond either one releases stops.
+            Price buyTrigger_ = std::numeric_limits<Price>::max();
+            Price sellTrigger_ = 0;
+            bool hasSells_ = false;
+
+            void refresh(){
+                buyTrigger_ = buys_.empty() ? std::numeric_limits<Price>::max() : buys_.begin()->first;
+                hasSells_ = !sells_.empty();
+                sellTrigger_ = hasSells_ ? sells_.begin()->first : 0;
+            }
+
+            template <typename Map>
+            static bool eraseId(Map& map, Price stopPrice, OrderId id, Quantity& qty){
+                auto [first, last] = map.equal_range(stopPrice);
+                for(auto it = first; it != last; ++it){
+                    if(it->second.id == id){
+                        qty = it->second.qty;
+                        map.erase(it);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+        public:
+            /**
+             * @brief Parks 'stop'. The caller has checked that its ID is unique and that it is not triggered yet.
+             */
+            void add(const StopOrder& stop){
+                ids_.emplace(stop.id, std::make_pair(stop.side, stop.stopPrice));
+                if(stop.side == Side::Buy) buys_.emplace(stop.stopPrice, stop);
+                else sells_.emplace(stop.stopPrice, stop);
+                refresh();
+            }
+
+            /**
+             * @brief Removes a parked stop.
+             * @param qty Receives its quantity.
+             * @return false if no stop with this ID is parked.
+             */
+            bool cancel(OrderId id, Quantity& qty){
+                auto it = ids_.find(id);
+                if(it == ids_.end()) return false;
+                auto [side, stopPrice] = it->second;
+                ids_.erase(it);
+                bool found = (side == Side::Buy) ? eraseId(buys_, stopPrice, id, qty) : eraseId(sells_, stopPrice, id, qty);
+                refresh();
+                return found;
+            }
+
+            /**
+             * @brief Would a trade at 'lastTrade' release at least one stop?
+             * @note Two compares against cached bounds: this is all the matching path ever evaluates.
+             */
+            bool isTriggered(Price lastTrade) const {
+                return lastTrade >= buyTrigger_ || (hasSells_ && lastTrade <= sellTrigger_);
+            }
+
+            /**
+             * @brief Removes the next stop released by 'lastTrade' (buy stops first, nearest trigger first).
+             * @return false if none is triggered.
+             */
+            bool popTriggered(Price lastTrade, StopOrder& out){
+                if(lastTrade >= buyTrigger_){
+                    out = buys_.begin()->second;
+                    buys_.erase(buys_.begin());
+                }
+                else if(hasSells_ && lastTrade <= sellTrigger_){
+                    out = sells_.begin()->second;
+                    sells_.erase(sells_.begin());
+                }
+                else{
+                    return false;
+                }
+                ids_.erase(out.id);
+                refresh();
+                return true;
+            }
+
+            /**
+             * @brief Visits every parked stop: buy stops then sell stops, nearest trigger first, FIFO within a price.
+             * @details Re-adding them in this sequence rebuilds the same trigger order (see Persistence.h).
+             */
+            template <typename F>
+            void forEach(F&& visit) const {
+                for(auto const& [stopPrice, stop] : buys_) visit(stop);
+                for(auto const& [stopPrice, stop] : sells_) visit(stop);
+            }
+
+            /**
+             * @brief Is a stop with this ID parked? (Every order entry asks: free without stops.)
+             */
+            bool contains(OrderId id) const { return !ids_.empty() && ids_.count(id) != 0; }
+            size_t size() const { return ids_.size(); }
+    };
+
+    /**
+     * @struct Iceberg
+     * @brief What the book does not show of an iceberg order.
+     */
+    struct Iceberg {
+        Quantity displayQty;    /**< Size of each displayed slice. */
+        Quantity reserve;       /**< Hidden quantity not yet displayed (> 0 while the entry exists). */
+    };
+
+    /**
+     * @class IcebergTable
+     * @brief Hidden reserves by order ID. An entry is dropped as soon as its last slice is displayed.
+     */
+    class IcebergTable {
+        private:
+            std::unordered_map<OrderId, Iceberg> entries_;
+
+        public:
+            void insert(OrderId id, const Iceberg& iceberg){ entries_[id] = iceberg; }
+            Iceberg* find(OrderId id){
+                auto it = entries_.find(id);
+                return it == entries_.end() ? nullptr : &it->second;
+            }
+            const Iceberg* find(OrderId id) const {
+                auto it = entries_.find(id);
+                return it == entries_.end() ? nullptr : &it->second;
+            }
+            void erase(OrderId id){ entries_.erase(id); }
+            size_t size() const { return entries_.size(); }
+    };
+}
@@ -0,0 +1,77 @@
+/**
+ * @file DepthBook.h
+ * @brief Consumer-side L2 replica of an OrderBook, maintained from its event stream.
+ * @details The matching thread never renders or copies depth. It publishes BookUpdate deltas (and a full
+ * snapshot on request) into its QueueSink; dashboards, gateways and loggers feed the events they drain to a
+ * DepthBook and read aggregated price levels from there, on their own thread.
+ * 1. **Deltas:** A BookUpdate sets the volume of one level (0 removes it).
+ * 2. **Snapshots:** A BookSnapshot marker clears the replica; the BookUpdates that follow rebuild it.
+ * Uses std::map, so it allocates - it is never on the matching path.
+ */
+#pragma once
+#include <map>
+#include <span>
+#include <iosfwd>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "Events.h"
+
+namespace LOB {
+
+    /**
+     * @struct DepthLevel
+     * @brief One aggregated price level.
+     */
+    struct DepthLevel {
+        Price price;
+        Quantity volume;
+    };
+
+    /**
+     * @class DepthBook
+     * @brief Aggregated bid/ask levels rebuilt from BookUpdate / BookSnapshot events.
+     */
+    class DepthBook {
+        private:
+            std::map<Price, Quantity, std::greater<Price>> bids_;
+            std::map<Price, Quantity> asks_;
+            uint64_t updates_ = 0;
+            uint64_t snapshots_ = 0;
+
+        public:
+            /**
+             * @brief Applies one event from the book's stream (non-depth events are ignored).
+             * @return true if the depth changed.
+             */
+            bool apply(const ExecutionEvent& event);
+
+            /**
+             * @brief Copies up to out.size() bid levels, best first.
+             * @return Number of levels written.
+             */
+            size_t getBids(std::span<DepthLevel> out) const;
+
+            /**
+             * @brief Copies up to out.size() ask levels, best first.
+             * @return Number of levels written.
+             */
+            size_t getAsks(std::span<DepthLevel> out) const;
+
+            size_t getBidLevelCount() const { return bids_.size(); }
+            size_t getAskLevelCount() const { return asks_.size(); }
+
+            /**
+             * @brief Deltas and snapshot markers applied so far.
+             */
+            uint64_t getUpdateCount() const { return updates_; }
+            uint64_t getSnapshotCount() const { return snapshots_; }
+
+            void clear();
+
+            /**
+             * @brief Renders the top 'depth' levels as two columns (bids left, asks right).
+             */
+            void print(std::ostream& os, size_t depth) const;
+    };
+}
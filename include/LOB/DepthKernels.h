@@ -0,0 +1,226 @@
+/**
+ * @file DepthKernels.h
+ * @brief Vectorized scans over a contiguous array of per-tick volumes (aggregated depth queries).
+ * @details FlatPriceLadder mirrors the volume of every tick slot into one dense Quantity array, ordered
+ * from the touch outward. Depth questions then become scans over that array instead of level walks:
+ * - **sumVolume():** Volume within N ticks of the touch (one add per lane).
+ * - **scanToFill():** Where the running volume first reaches a target, with what it needs to price the fill:
+ *   an in-register prefix sum (log2(lanes) shift + add steps) is offset by the carry, its last lane is
+ *   compared with the target, and whole blocks are consumed until the target falls inside one.
+ *   The sum of the running volumes it also accumulates gives sum(volume[d] * d) without a multiply.
+ *
+ * The AVX-512 and AVX2 kernels are compiled through function target attributes and chosen once at run time
+ * (activeSimd()), so the build needs no -march flag. Elsewhere, or on older CPUs, the scalar kernel runs.
+ * @note Volumes are assumed to sum below 2^63.
+ */
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include "Order.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NANOBOOK_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace LOB {
+
+    /**
+     * @struct FillEstimate
+     * @brief What sweeping the book for a quantity would do (computed without touching any order).
+     */
+    struct FillEstimate {
+        Quantity filled = 0;      /**< Fillable quantity (the requested one when enough liquidity is in reach). */
+        size_t levels = 0;        /**< Non-empty levels the fill touches. */
+        Price worstPrice = 0;     /**< Last (worst) price reached, 0 if nothing fills. */
+        uint64_t notional = 0;    /**< Sum of price x quantity over the fill. */
+
+        /**
+         * @brief Volume-weighted average price of the fill (0 if nothing fills).
+         */
+        double vwap() const { return filled ? static_cast<double>(notional) / static_cast<double>(filled) : 0.0; }
+    };
+
+    /**
+     * @struct DepthScan
+     * @brief Result of scanToFill() over slots [0, n).
+     */
+    struct DepthScan {
+        size_t index = 0;         /**< First slot where the running volume reaches the target (n if never). */
+        Quantity before = 0;      /**< Volume of slots [0, index). */
+        uint64_t prefixSum = 0;   /**< Sum over d < index of the running volume through slot d. */
+        size_t nonEmpty = 0;      /**< Non-empty slots in [0, index). */
+    };
+
+    /**
+     * @brief Instruction set used by the depth kernels.
+     */
+    enum class SimdLevel : uint8_t { Scalar, Avx2, Avx512 };
+
+    namespace DepthKernels {
+
+        /**
+         * @brief Best instruction set the running CPU supports.
+         */
+        inline SimdLevel detectSimd(){
+#if defined(NANOBOOK_X86_SIMD)
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+            if(__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        /**
+         * @brief detectSimd(), evaluated once.
+         */
+        inline SimdLevel activeSimd(){
+            static const SimdLevel level = detectSimd();
+            return level;
+        }
+
+        // --- Scalar (reference, and the tail of the vector kernels) ---
+
+        inline Quantity sumVolumeScalar(const Quantity* v, size_t n, size_t from = 0, Quantity total = 0){
+            for(size_t i = from; i < n; ++i) total += v[i];
+            return total;
+        }
+
+        inline DepthScan scanToFillScalar(const Quantity* v, size_t n, Quantity target, size_t from = 0, DepthScan acc = {}){
+            for(size_t i = from; i < n; ++i){
+                Quantity q = v[i];
+                if(acc.before + q >= target){
+                    acc.index = i;
+                    return acc;
+                }
+                acc.before += q;
+                acc.prefixSum += acc.before;
+                acc.nonEmpty += (q != 0);
+            }
+            acc.index = n;
+            return acc;
+        }
+
+#if defined(NANOBOOK_X86_SIMD)
+        // --- AVX2: 4 slots per step ---
+
+        __attribute__((target("avx2"))) inline Quantity sumVolumeAvx2(const Quantity* v, size_t n){
+            __m256i acc = _mm256_setzero_si256();
+            size_t i = 0;
+            for(; i + 4 <= n; i += 4){
+                acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i)));
+            }
+            __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+            Quantity total = static_cast<Quantity>(_mm_cvtsi128_si64(half)) + static_cast<Quantity>(_mm_extract_epi64(half, 1));
+            return sumVolumeScalar(v, n, i, total);
+        }
+
+        __attribute__((target("avx2,popcnt"))) inline DepthScan scanToFillAvx2(const Quantity* v, size_t n, Quantity target){
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i prefixes = zero;
+            DepthScan acc;
+            size_t i = 0;
+            for(; i + 4 <= n; i += 4){
+                __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i));
+
+                // 1. Inclusive prefix sum of the 4 lanes: shift by one lane and add, then by two.
+                __m256i p = _mm256_add_epi64(raw, _mm256_blend_epi32(_mm256_permute4x64_epi64(raw, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+                p = _mm256_add_epi64(p, _mm256_blend_epi32(_mm256_permute4x64_epi64(p, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+                p = _mm256_add_epi64(p, _mm256_set1_epi64x(static_cast<long long>(acc.before)));
+
+                // 2. The target lies in this block: the scalar tail resolves the exact slot.
+                Quantity last = static_cast<Quantity>(_mm256_extract_epi64(p, 3));
+                if(last >= target) break;
+
+                // 3. Consume the whole block.
+                prefixes = _mm256_add_epi64(prefixes, p);
+                unsigned empty = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(raw, zero))));
+                acc.nonEmpty += 4 - static_cast<size_t>(std::popcount(empty));
+                acc.before = last;
+            }
+            __m128i half = _mm_add_epi64(_mm256_castsi256_si128(prefixes), _mm256_extracti128_si256(prefixes, 1));
+            acc.prefixSum = static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+            return scanToFillScalar(v, n, target, i, acc);
+        }
+
+        // --- AVX-512: 8 slots per step ---
+
+        // GCC's AVX-512 intrinsics start from deliberately undefined vectors (_mm512_undefined_*), which -Wall
+        // reports as uninitialized in every function that inlines them. The values are never read.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+        __attribute__((target("avx512f"))) inline Quantity sumVolumeAvx512(const Quantity* v, size_t n){
+            __m512i acc = _mm512_setzero_si512();
+            size_t i = 0;
+            for(; i + 8 <= n; i += 8){
+                acc = _mm512_add_epi64(acc, _mm512_loadu_si512(v + i));
+            }
+            return sumVolumeScalar(v, n, i, static_cast<Quantity>(_mm512_reduce_add_epi64(acc)));
+        }
+
+        __attribute__((target("avx512f,popcnt"))) inline DepthScan scanToFillAvx512(const Quantity* v, size_t n, Quantity target){
+            const __m512i zero = _mm512_setzero_si512();
+            __m512i prefixes = zero;
+            DepthScan acc;
+            size_t i = 0;
+            for(; i + 8 <= n; i += 8){
+                __m512i raw = _mm512_loadu_si512(v + i);
+
+                // 1. Inclusive prefix sum of the 8 lanes: alignr against zero shifts by 1, 2, then 4 lanes.
+                __m512i p = _mm512_add_epi64(raw, _mm512_alignr_epi64(raw, zero, 7));
+                p = _mm512_add_epi64(p, _mm512_alignr_epi64(p, zero, 6));
+                p = _mm512_add_epi64(p, _mm512_alignr_epi64(p, zero, 4));
+                p = _mm512_add_epi64(p, _mm512_set1_epi64(static_cast<long long>(acc.before)));
+
+                // 2. Compare the block total (lane 7) with the target.
+                Quantity last = static_cast<Quantity>(_mm_extract_epi64(_mm512_extracti32x4_epi32(p, 3), 1));
+                if(last >= target) break;
+
+                // 3. Consume the whole block.
+                prefixes = _mm512_add_epi64(prefixes, p);
+                acc.nonEmpty += 8 - static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm512_cmpeq_epu64_mask(raw, zero))));
+                acc.before = last;
+            }
+            acc.prefixSum = static_cast<uint64_t>(_mm512_reduce_add_epi64(prefixes));
+            return scanToFillScalar(v, n, target, i, acc);
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+        // --- Dispatch ---
+
+        /**
+         * @brief Total of v[0, n).
+         */
+        inline Quantity sumVolume(const Quantity* v, size_t n, SimdLevel level = activeSimd()){
+#if defined(NANOBOOK_X86_SIMD)
+            if(level == SimdLevel::Avx512) return sumVolumeAvx512(v, n);
+            if(level == SimdLevel::Avx2) return sumVolumeAvx2(v, n);
+#else
+            (void)level;
+#endif
+            return sumVolumeScalar(v, n);
+        }
+
+        /**
+         * @brief Scans v[0, n) until the running volume reaches 'target'.
+         * @note 'level' must not exceed detectSimd() (tests pass it explicitly to compare the kernels).
+         */
+        inline DepthScan scanToFill(const Quantity* v, size_t n, Quantity target, SimdLevel level = activeSimd()){
+#if defined(NANOBOOK_X86_SIMD)
+            if(level == SimdLevel::Avx512) return scanToFillAvx512(v, n, target);
+            if(level == SimdLevel::Avx2) return scanToFillAvx2(v, n, target);
+#else
+            (void)level;
+#endif
+            return scanToFillScalar(v, n, target);
+        }
+    }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file Engine.h
+ * @brief Defines the multi-instrument matching engine: many OrderBooks, hash-partitioned across shards.
+ * @details One OrderBook per symbol, and one matching thread per shard:
+ * 1. **Partitioning:** A symbol always maps to the same shard (Fibonacci hash of the SymbolId), so every
+ *    book is owned by exactly one thread and no book state is ever shared or locked.
+ * 2. **Per-Shard Ingress:** The router (submit()) pushes into the owning shard's SPSC LockFreeQueue.
+ *    Shards never communicate, so throughput scales with the number of cores.
+ * 3. **Shard-Local Memory:** Each shard thread pins itself, then constructs its own ingress queue and books
+ *    (and therefore their pools, indices and ladders), so under Linux's first-touch policy every page lands
+ *    on the NUMA node of the core that will use it. With lockMemory the process is then mlocked, so no
+ *    page fault can reach the matching loop.
+ *
+ * Lifecycle: addSymbol() for every instrument -> start() -> submit() ... -> stop() -> inspect books.
+ * Each book reports into its own sink. With QueueSink books (Engine) a consumer must drain every symbol's
+ * getSink(symbol).events() while the engine runs, or each book starts dropping (and counting) events once
+ * its queue is full. Engines nobody listens to should use a NullSink book (SilentEngine).
+ */
+#pragma once
+#include <span>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include "OrderBook.h"
+#include "EventSink.h"
+#include "OrderRequest.h"
+#include "LockFreeQueue.h"
+#include "Latency.h"
+
+namespace LOB {
+
+    /**
+     * @struct EngineConfig
+     * @brief Construction-time parameters of the Engine.
+     */
+    struct EngineConfig {
+        /** Number of matching threads (symbols are hash-partitioned across them). */
+        size_t shardCount = 1;
+
+        /** Slots in each shard's ingress queue. */
+        size_t shardQueueCapacity = 65536;
+
+        /** Requests handed to a book per applyBatch() call (and per queue release). */
+        size_t maxBatch = 64;
+
+        /** Pin shard i to core (firstCore + i). */
+        bool pinThreads = false;
+        unsigned firstCore = 0;
+
+        /** Explicit core per shard (with pinThreads): shard i runs on shardCores[i], overriding firstCore + i. */
+        std::vector<unsigned> shardCores;
+
+        /** mlockall() once every shard has built its memory (best effort, see isMemoryLocked()). */
+        bool lockMemory = false;
+
+        /** Applied to every book (pool sizes, ladder, event queue). */
+        BookConfig book;
+    };
+
+    /**
+     * @class BasicEngine
+     * @brief Owns the books and shard threads, and routes requests to them.
+     * @tparam Book The per-symbol book type (e.g., OrderBook, FlatOrderBook).
+     * @note submit() is single-producer: call it from one router/gateway thread only.
+     */
+    template <typename Book>
+    class BasicEngine {
+        private:
+            struct alignas(64) Shard {
+                std::optional<LockFreeQueue<OrderRequest>> ingress; // built on the shard thread
+                std::vector<SymbolId> symbols;                    // registered before start()
+                std::vector<std::unique_ptr<Book>> books;         // built on the shard thread
+                std::unordered_map<SymbolId, Book*> lookup;       // read-only once running
+                std::thread thread;
+
+                std::atomic<uint64_t> processed{0};
+                std::atomic<uint64_t> unknownSymbol{0};
+                bool pinned = false;
+                int numaNode = -1;
+
+                [[no_unique_address]] LatencyTracker latency;     // QueueWait (push -> pop) of this shard
+
+            };
+
+            EngineConfig config_;
+            std::vector<std::unique_ptr<Shard>> shards_;
+            std::atomic<bool> running_{false};
+            std::atomic<bool> accepting_{false};   // every shard's queue and books are built (start() .. stop())
+            std::atomic<size_t> readyShards_{0};
+            bool memoryLocked_ = false;
+
+            /**
+             * @brief The core shard 'index' is pinned to.
+             */
+            unsigned coreFor(size_t index) const {
+                return index < config_.shardCores.size() ? config_.shardCores[index]
+                                                          : config_.firstCore + static_cast<unsigned>(index);
+            }
+
+            /**
+             * @brief Body of one matching thread.
+             */
+            void runShard(size_t index);
+
+            /**
+             * @brief Hands one contiguous run of requests to their books, grouping consecutive same-symbol requests.
+             */
+            void dispatch(Shard& shard, std::span<const OrderRequest> batch);
+
+        public:
+            explicit BasicEngine(const EngineConfig& config = EngineConfig{});
+            ~BasicEngine();
+
+            BasicEngine(const BasicEngine&) = delete;
+            BasicEngine& operator=(const BasicEngine&) = delete;
+
+            /**
+             * @brief Registers an instrument while the engine is stopped (before start(), or between stop() and a
+             * restart: its book is built by the next start()).
+             * @return false if it is already registered or the engine is running.
+             */
+            bool addSymbol(SymbolId symbol);
+
+            /**
+             * @brief Launches the shard threads and waits until every queue and book is built, then locks memory if configured.
+             */
+            void start();
+
+            /**
+             * @brief Lets every shard drain its queue, then joins the threads.
+             */
+            void stop();
+
+            /**
+             * @brief Routes a request to its shard (single router thread, after start()).
+             * @return false if that shard's queue is full (the caller decides whether to spin or drop),
+             * or if the engine is not running (before start() or after stop()): nothing is queued then.
+             */
+            bool submit(const OrderRequest& request){
+                // Acquire: pairs with start(), so the shard queues built on the shard threads are visible here.
+                if(!accepting_.load(std::memory_order_acquire)) [[unlikely]] {
+                    return false;
+                }
+                return shards_[shardFor(request.symbol)]->ingress->push(request);
+            }
+
+            /**
+             * @brief The shard that owns 'symbol'.
+             */
+            size_t shardFor(SymbolId symbol) const {
+                return static_cast<size_t>((static_cast<uint64_t>(symbol) * 0x9E3779B97F4A7C15ull) >> 32) % shards_.size();
+            }
+
+            /**
+             * @brief The book of one symbol, or nullptr if unknown / not built yet.
+             * @warning Only safe to inspect while the engine is stopped.
+             */
+            Book* getBook(SymbolId symbol);
+
+            /**
+             * @brief The execution sink of one symbol's book, or nullptr if unknown / not started yet.
+             * @details Unlike getBook(), usable while the engine runs: the sink is the book's output side, and the
+             * shard thread is its only producer. One consumer thread per sink may drain it (QueueSink::events()).
+             */
+            auto* getSink(SymbolId symbol){
+                Book* book = getBook(symbol);
+                return book ? &book->getSink() : nullptr;
+            }
+
+            size_t getShardCount() const { return shards_.size(); }
+
+            /**
+             * @brief Requests processed by one shard so far (readable while running).
+             */
+            uint64_t getProcessedCount(size_t shard) const { return shards_[shard]->processed.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Requests that named a symbol nobody registered.
+             */
+            uint64_t getUnknownSymbolCount(size_t shard) const { return shards_[shard]->unknownSymbol.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Whether pinning succeeded for one shard (false if disabled or unsupported).
+             */
+            bool isPinned(size_t shard) const { return shards_[shard]->pinned; }
+
+            /**
+             * @brief NUMA node one shard ran on when it built its memory (-1 before start() or if unknown).
+             */
+            int getNumaNode(size_t shard) const { return shards_[shard]->numaNode; }
+
+            /**
+             * @brief Whether lockMemory was requested and granted (needs CAP_IPC_LOCK or a large RLIMIT_MEMLOCK).
+             */
+            bool isMemoryLocked() const { return memoryLocked_; }
+
+            /**
+             * @brief Queue-wait histogram of one shard (book-side stages live in each book's getLatency()).
+             */
+            const LatencyTracker& getLatency(size_t shard) const { return shards_[shard]->latency; }
+    };
+
+    /**
+     * @brief The default multi-instrument engine (std::map ladders, events into each book's LockFreeQueue).
+     */
+    using Engine = BasicEngine<OrderBook>;
+
+    /**
+     * @brief An engine whose books discard their events (benchmarks, or when only book state matters).
+     */
+    using SilentEngine = BasicEngine<BasicOrderBook<MapPriceLadder, OrderIndex, NullSink>>;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file EventDigest.h
+ * @brief Rolling per-instruction digests of a book's event stream (determinism checks).
+ * @details Two book configurations are equivalent if, fed the same requests, every instruction produces
+ * the same events. DigestSink folds the events of instruction 'seq' into a chained XXH64:
+ * @code
+ * digest[seq] = XXH64(canonical events of instruction seq, seed = digest[seq - 1])
+ * @endcode
+ * so comparing two digest arrays finds the first sequence number whose output differs, and the last entry
+ * alone vouches for the whole run.
+ * - **Canonical Form:** Trades, cancels, modifies, rejects and snapshot headers are hashed in emission
+ *   order, field by field (no padding bytes). BookUpdates are reduced to the final volume of each level
+ *   touched and hashed sorted by (side, price), so two kernels that publish the same level changes in a
+ *   different order or with different coalescing still agree.
+ * - **Sequencing:** The book flushes its sink exactly once per instruction (addOrder, cancelOrder,
+ *   modifyOrder, or one request of a batch): every flush() closes one sequence number.
+ * - **Capture:** captureAt(seq) keeps the canonical events of one instruction, to print a divergence.
+ */
+#pragma once
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include "Events.h"
+#include "BookConfig.h"
+
+namespace LOB {
+
+    namespace XXH64 {
+
+        constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t P3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t P5 = 0x27D4EB2F165667C5ull;
+
+        inline uint64_t read64(const unsigned char* p){ uint64_t v; std::memcpy(&v, p, 8); return v; }
+        inline uint32_t read32(const unsigned char* p){ uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+        inline uint64_t round(uint64_t acc, uint64_t input){
+            acc += input * P2;
+            return std::rotl(acc, 31) * P1;
+        }
+
+        inline uint64_t merge(uint64_t acc, uint64_t value){
+            acc ^= round(0, value);
+            return acc * P1 + P4;
+        }
+
+        /**
+         * @brief XXH64 of 'len' bytes (the reference algorithm, little-endian reads).
+         */
+        inline uint64_t hash(const void* data, size_t len, uint64_t seed){
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            const unsigned char* end = p + len;
+            uint64_t h;
+
+            // 1. Four lanes over 32-byte stripes
+            if(len >= 32){
+                uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+                for(; p + 32 <= end; p += 32){
+                    v1 = round(v1, read64(p));
+                    v2 = round(v2, read64(p + 8));
+                    v3 = round(v3, read64(p + 16));
+                    v4 = round(v4, read64(p + 24));
+                }
+                h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+                h = merge(merge(merge(merge(h, v1), v2), v3), v4);
+            }
+            else{
+                h = seed + P5;
+            }
+            h += static_cast<uint64_t>(len);
+
+            // 2. Tail: 8, 4, then 1 byte at a time
+            for(; p + 8 <= end; p += 8){
+                h ^= round(0, read64(p));
+                h = std::rotl(h, 27) * P1 + P4;
+            }
+            if(p + 4 <= end){
+                h ^= static_cast<uint64_t>(read32(p)) * P1;
+                h = std::rotl(h, 23) * P2 + P3;
+                p += 4;
+            }
+            for(; p < end; ++p){
+                h ^= static_cast<uint64_t>(*p) * P5;
+                h = std::rotl(h, 11) * P1;
+            }
+
+            // 3. Avalanche
+            h ^= h >> 33;
+            h *= P2;
+            h ^= h >> 29;
+            h *= P3;
+            h ^= h >> 32;
+            return h;
+        }
+    }
+
+    /**
+     * @class DigestSink
+     * @brief Execution Sink that records one chained XXH64 per instruction instead of publishing events.
+     * @note Meant for verification runs: the digest array grows with the stream (8 bytes per instruction).
+     */
+    class DigestSink {
+        public:
+            static constexpr uint64_t NO_CAPTURE = ~uint64_t{0};
+
+        private:
+            std::vector<uint64_t> words_;        // canonical encoding of the open instruction
+            std::vector<BookUpdate> levels_;     // final volume of each level it touched
+            std::vector<uint64_t> digests_;      // digests_[seq]
+            uint64_t chain_ = 0;
+
+            uint64_t captureSeq_ = NO_CAPTURE;
+            std::vector<ExecutionEvent> pending_;
+            std::vector<ExecutionEvent> captured_;
+
+            void append(EventType type, uint64_t a, uint64_t b = 0, uint64_t c = 0, uint64_t d = 0){
+                words_.insert(words_.end(), {static_cast<uint64_t>(type), a, b, c, d});
+            }
+
+            bool capturing() const { return captureSeq_ == digests_.size(); }
+
+            template <typename Event>
+            void keep(const Event& event){
+                if(capturing()) [[unlikely]] pending_.emplace_back(event);
+            }
+
+        public:
+            explicit DigestSink(const BookConfig&) {
+                words_.reserve(64);
+                levels_.reserve(16);
+            }
+
+            void onTrade(const Trade& t){
+                append(EventType::Trade, t.buyOrderId, t.sellOrderId, t.price, t.quantity);
+                keep(t);
+            }
+            void onCancel(const Cancel& c){
+                append(EventType::Cancel, c.orderId, c.remainingQuantity);
+                keep(c);
+            }
+            void onModify(const Modify& m){
+                append(EventType::Modify, m.orderId, m.price, m.quantity);
+                keep(m);
+            }
+            void onReject(const Reject& r){
+                append(EventType::Reject, r.orderId, static_cast<uint64_t>(r.reason));
+                keep(r);
+            }
+            void onSnapshot(const BookSnapshot& s){
+                append(EventType::BookSnapshot, s.depth);
+                keep(s);
+            }
+            void onBookUpdate(const BookUpdate& update){
+                for(BookUpdate& level : levels_){
+                    if(level.price == update.price && level.side == update.side){
+                        level.volume = update.volume;
+                        return;
+                    }
+                }
+                levels_.push_back(update);
+            }
+
+            /**
+             * @brief Closes the instruction: appends the sorted level deltas and chains its digest.
+             */
+            void flush(){
+                std::sort(levels_.begin(), levels_.end(), [](const BookUpdate& a, const BookUpdate& b){
+                    return a.side != b.side ? a.side < b.side : a.price < b.price;
+                });
+                for(const BookUpdate& level : levels_){
+                    append(EventType::BookUpdate, level.price, level.volume, static_cast<uint64_t>(level.side));
+                    keep(level);
+                }
+
+                chain_ = XXH64::hash(words_.data(), words_.size() * sizeof(uint64_t), chain_);
+                if(capturing()) [[unlikely]] captured_.swap(pending_);
+                digests_.push_back(chain_);
+                words_.clear();
+                levels_.clear();
+            }
+
+            /**
+             * @brief Keep the canonical events of instruction 'seq' (see getCaptured()).
+             */
+            void captureAt(uint64_t seq){ captureSeq_ = seq; }
+
+            /**
+             * @brief Rolling digest after each instruction: getDigests()[seq].
+             */
+            const std::vector<uint64_t>& getDigests() const { return digests_; }
+
+            /**
+             * @brief Digest of the whole stream so far (0 before the first instruction).
+             */
+            uint64_t getDigest() const { return chain_; }
+
+            /**
+             * @brief The events of the captured instruction, in canonical order.
+             */
+            const std::vector<ExecutionEvent>& getCaptured() const { return captured_; }
+    };
+}
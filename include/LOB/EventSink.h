@@ -0,0 +1,136 @@
+/**
+ * @file EventSink.h
+ * @brief Execution Sink policies: where the OrderBook sends its Trade/Cancel/Reject/BookUpdate/... events.
+ * @details The sink is a template parameter of BasicOrderBook, so every call is resolved (and inlined)
+ * at compile time. A sink is any type that is constructible from a BookConfig and provides:
+ * @code
+ * void onTrade(const Trade&);
+ * void onCancel(const Cancel&);
+ * void onModify(const Modify&);
+ * void onReject(const Reject&);
+ * void onBookUpdate(const BookUpdate&);
+ * void onSnapshot(const BookSnapshot&);
+ * void flush();  // the book finished one instruction: publish anything held back
+ * @endcode
+ * Shipped policies:
+ * 1. **QueueSink:** Pushes events into an SPSC LockFreeQueue for an off-thread consumer (the default).
+ * 2. **NullSink:** Empty inline functions. The optimizer removes the calls entirely (benchmarks).
+ * Sinks that publish level updates off-thread coalesce them per instruction through a LevelCoalescer.
+ */
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "Events.h"
+#include "BookConfig.h"
+#include "LockFreeQueue.h"
+
+namespace LOB {
+
+    /**
+     * @struct NullSink
+     * @brief Discards every event. Compiles down to nothing.
+     */
+    struct NullSink {
+        explicit NullSink(const BookConfig&) {}
+
+        void onTrade(const Trade&) {}
+        void onCancel(const Cancel&) {}
+        void onModify(const Modify&) {}
+        void onReject(const Reject&) {}
+        void onBookUpdate(const BookUpdate&) {}
+        void onSnapshot(const BookSnapshot&) {}
+        void flush() {}
+    };
+
+    /**
+     * @class LevelCoalescer
+     * @brief Holds back the level updates of one instruction, keeping only the latest volume per level.
+     * @details add() marks a level dirty; drain() hands every dirty level to a publish callable once, in the order
+     * the levels were first touched. A sweep that fills ten orders at one price costs one delta instead of ten.
+     */
+    class LevelCoalescer {
+        private:
+            // Enough for any normal instruction; a deeper sweep drains early (still exact, just less coalesced).
+            static constexpr size_t MAX_DIRTY_LEVELS = 16;
+
+            BookUpdate dirty_[MAX_DIRTY_LEVELS];
+            size_t dirtyCount_ = 0;
+
+        public:
+            template <typename Publish>
+            void add(const BookUpdate& update, Publish&& publish){
+                for(size_t i = 0; i < dirtyCount_; ++i){
+                    if(dirty_[i].price == update.price && dirty_[i].side == update.side){
+                        dirty_[i].volume = update.volume;
+                        return;
+                    }
+                }
+                if(dirtyCount_ == MAX_DIRTY_LEVELS) [[unlikely]] {
+                    drain(publish);
+                }
+                dirty_[dirtyCount_++] = update;
+            }
+
+            template <typename Publish>
+            void drain(Publish&& publish){
+                for(size_t i = 0; i < dirtyCount_; ++i) publish(dirty_[i]);
+                dirtyCount_ = 0;
+            }
+    };
+
+    /**
+     * @class QueueSink
+     * @brief Publishes events into a LockFreeQueue.
+     * @details The matching thread is the single producer; a logger/gateway thread is the single consumer
+     * and drains events() at its own pace. The matcher never blocks: if the consumer falls behind and
+     * the queue is full, the event is dropped and counted instead (consumers resync via a snapshot).
+     *
+     * Level updates are coalesced (LevelCoalescer): onBookUpdate() only marks the level dirty and flush()
+     * publishes one BookUpdate per dirty level at the end of the instruction.
+     */
+    class QueueSink {
+        private:
+            LockFreeQueue<ExecutionEvent> queue_;
+            uint64_t dropped_ = 0;
+            LevelCoalescer levels_;
+
+            void publish(const ExecutionEvent& event){
+                if(!queue_.push(event)) [[unlikely]] {
+                    ++dropped_;
+                }
+            }
+
+        public:
+            /**
+             * @brief Construct the sink with a queue of BookConfig::eventQueueCapacity slots.
+             */
+            explicit QueueSink(const BookConfig& config) : queue_(config.eventQueueCapacity) {}
+
+            void onTrade(const Trade& trade) { publish(trade); }
+            void onCancel(const Cancel& cancel) { publish(cancel); }
+            void onModify(const Modify& modify) { publish(modify); }
+            void onReject(const Reject& reject) { publish(reject); }
+            void onBookUpdate(const BookUpdate& update){
+                levels_.add(update, [this](const BookUpdate& level){ publish(level); });
+            }
+
+            void onSnapshot(const BookSnapshot& snapshot){
+                flush();
+                publish(snapshot);
+            }
+
+            void flush(){
+                levels_.drain([this](const BookUpdate& level){ publish(level); });
+            }
+
+            /**
+             * @brief The consumer end of the stream. Only ONE thread may pop from it.
+             */
+            LockFreeQueue<ExecutionEvent>& events() { return queue_; }
+
+            /**
+             * @brief Number of events lost because the consumer was too slow (read on the producer thread).
+             */
+            uint64_t getDroppedCount() const { return dropped_; }
+    };
+}
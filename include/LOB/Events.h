@@ -0,0 +1,131 @@
+/**
+ * @file Events.h
+ * @brief Defines the structured execution events emitted by the matching engine.
+ * @details Instead of formatting text on the hot path, the OrderBook reports every state change as a small
+ * POD struct handed to its Execution Sink (see EventSink.h):
+ * - **Trade:** Two orders crossed.
+ * - **Cancel:** A resting order was removed on request, or the unfilled part of a Market / IOC / FOK order was discarded.
+ * - **Modify:** A resting order was amended (new price and/or open quantity).
+ * - **Reject:** An instruction could not be applied (duplicate ID, unknown order, ...).
+ * - **BookUpdate:** The aggregate volume at a price level changed (0 = level removed). These are the L2 deltas:
+ *   the book coalesces them so each level touched by one instruction is reported once, with its final volume.
+ * - **BookSnapshot:** Marks the start of a depth snapshot (the BookUpdates that follow are the whole top of book).
+ *
+ * All structs are trivially copyable so they can travel through the LockFreeQueue untouched.
+ */
+#pragma once
+#include <iosfwd>
+#include <cstdint>
+#include "Order.h"
+
+namespace LOB {
+
+    /**
+     * @enum EventType
+     * @brief Discriminator for ExecutionEvent.
+     */
+    enum class EventType : uint8_t { Trade, Cancel, Reject, BookUpdate, Modify, BookSnapshot };
+
+    /**
+     * @enum RejectReason
+     * @brief Why an instruction was refused.
+     */
+    enum class RejectReason : uint8_t {
+        DuplicateOrderId,   /**< An order with this ID is already resting. */
+        UnknownOrder,       /**< Cancel / modify for an ID that is not in the book. */
+        InvalidPrice,       /**< Price is not representable (off the tick grid). */
+        PoolExhausted,      /**< No free Order slot left in the ObjectPool. */
+        RiskUnknownAccount, /**< Pre-trade risk: the account is not configured. */
+        RiskOrderSize,      /**< Pre-trade risk: quantity is 0 or above the account's maxOrderQty. */
+        RiskPriceCollar,    /**< Pre-trade risk: price too far from the BBO reference. */
+        RiskPosition,       /**< Pre-trade risk: position + working orders would exceed maxPosition. */
+        RiskNotional,       /**< Pre-trade risk: working notional would exceed maxNotional. */
+        RiskCapacity        /**< Pre-trade risk: the working-order table has no free slot for this ID. */
+    };
+
+    /**
+     * @struct Trade
+     * @brief A fill between a buy and a sell order.
+     */
+    struct Trade {
+        OrderId buyOrderId;
+        OrderId sellOrderId;
+        Price price;
+        Quantity quantity;
+    };
+
+    /**
+     * @struct Cancel
+     * @brief A resting order was cancelled, or an immediate order's remainder was discarded.
+     */
+    struct Cancel {
+        OrderId orderId;
+        Quantity remainingQuantity; /**< Open (or unfilled) quantity at the time of cancellation. */
+    };
+
+    /**
+     * @struct Modify
+     * @brief A resting order was amended. Reported before any trade the amendment causes.
+     */
+    struct Modify {
+        OrderId orderId;
+        Price price;        /**< Price after the amendment. */
+        Quantity quantity;  /**< Open quantity after the amendment. */
+    };
+
+    /**
+     * @struct Reject
+     * @brief An add/cancel instruction was refused.
+     */
+    struct Reject {
+        OrderId orderId;
+        RejectReason reason;
+    };
+
+    /**
+     * @struct BookUpdate
+     * @brief New aggregate volume of one price level.
+     */
+    struct BookUpdate {
+        Price price;
+        Quantity volume; /**< Total volume left at this price. 0 means the level is gone. */
+        Side side;
+    };
+
+    /**
+     * @struct BookSnapshot
+     * @brief Header of a depth snapshot: consumers drop their depth and rebuild it from the BookUpdates that follow.
+     */
+    struct BookSnapshot {
+        uint64_t depth; /**< Levels per side included (0 = every level). */
+    };
+
+    /**
+     * @struct ExecutionEvent
+     * @brief Tagged union of all event types, used as the LockFreeQueue payload.
+     */
+    struct ExecutionEvent {
+        EventType type;
+        union {
+            Trade trade;
+            Cancel cancel;
+            Reject reject;
+            BookUpdate update;
+            Modify modify;
+            BookSnapshot snapshot;
+        };
+
+        ExecutionEvent() : type(EventType::Trade), trade{} {}
+        ExecutionEvent(const Trade& t) : type(EventType::Trade), trade(t) {}
+        ExecutionEvent(const Cancel& c) : type(EventType::Cancel), cancel(c) {}
+        ExecutionEvent(const Reject& r) : type(EventType::Reject), reject(r) {}
+        ExecutionEvent(const BookUpdate& u) : type(EventType::BookUpdate), update(u) {}
+        ExecutionEvent(const Modify& m) : type(EventType::Modify), modify(m) {}
+        ExecutionEvent(const BookSnapshot& s) : type(EventType::BookSnapshot), snapshot(s) {}
+    };
+
+    /**
+     * @brief Human-readable rendering of an event (for off-thread loggers, never the hot path).
+     */
+    std::ostream& operator<<(std::ostream& os, const ExecutionEvent& event);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file GatewayIngress.h
+ * @brief Defines the lock-free multi-producer ingress path into a single matching thread.
+ * @details ThreadSafeOrderBook lets every caller into the book behind one SpinLock, so under load the lock's
+ * cache line (and the book's) ping-pongs between cores. GatewayIngress never lets a gateway touch the book:
+ * 1. **One Lane per Gateway:** Each producer thread owns its own SPSC LockFreeQueue, so producers never
+ *    contend with each other and no CAS loop is needed anywhere.
+ * 2. **Round-Robin Polling:** The engine thread visits the lanes in fixed order (0, 1, ..., N-1) and takes at
+ *    most 'quantum' requests from each per round. A busy gateway can therefore delay the others by at most
+ *    one quantum, and for the same lane contents the interleaving is always the same.
+ * 3. **Zero-Copy Hand-Off:** Requests are passed to the handler as in-place spans (peek_bulk), which pair
+ *    directly with OrderBook::applyBatch().
+ */
+#pragma once
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include "LockFreeQueue.h"
+
+namespace LOB {
+
+    /**
+     * @class GatewayIngress
+     * @brief N single-producer lanes drained by one consumer.
+     * @tparam T The message type (e.g., OrderRequest).
+     */
+    template <typename T>
+    class GatewayIngress {
+        private:
+            // unique_ptr: each queue is cache-line aligned and non-movable, and lanes must not share lines.
+            std::vector<std::unique_ptr<LockFreeQueue<T>>> lanes_;
+
+        public:
+            /**
+             * @brief Construct the ingress.
+             * @param gateways Number of producer threads (one lane each).
+             * @param laneCapacity Slots per lane (rounded up to a power of two).
+             */
+            GatewayIngress(size_t gateways, size_t laneCapacity){
+                lanes_.reserve(gateways);
+                for(size_t i = 0; i < gateways; ++i){
+                    lanes_.push_back(std::make_unique<LockFreeQueue<T>>(laneCapacity));
+                }
+            }
+
+            /**
+             * @brief The lane owned by one gateway thread (Producer side).
+             * @note Exactly one thread may push into a given lane.
+             */
+            LockFreeQueue<T>& lane(size_t gateway) { return *lanes_[gateway]; }
+
+            /**
+             * @brief One polling round (Consumer only).
+             * @param handler Called as handler(std::span<const T> batch, size_t gateway) for every non-empty lane.
+             * @param quantum Maximum requests taken from each lane in this round.
+             * @return Total number of requests handed to the handler.
+             */
+            template <typename Handler>
+            size_t poll(Handler&& handler, size_t quantum = 64){
+                size_t total = 0;
+                for(size_t gateway = 0; gateway < lanes_.size(); ++gateway){
+                    LockFreeQueue<T>& q = *lanes_[gateway];
+                    std::span<const T> batch = q.peek_bulk(quantum);
+                    if(batch.empty()) continue;
+
+                    handler(batch, gateway);
+                    q.release(batch.size());
+                    total += batch.size();
+                }
+                return total;
+            }
+
+            /**
+             * @brief Requests waiting across all lanes (approximate while producers are running).
+             */
+            size_t pending() const {
+                size_t total = 0;
+                for(const auto& q : lanes_) total += q->size();
+                return total;
+            }
+
+            size_t getGatewayCount() const { return lanes_.size(); }
+    };
+}
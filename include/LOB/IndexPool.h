@@ -0,0 +1,96 @@
+/**
+ * @file IndexPool.h
+ * @brief Defines a fixed-capacity object pool addressed by 32-bit indices instead of pointers.
+ * @details Pointers are 8 bytes; a link that only ever references slots of one pool fits in 4.
+ * IndexPool keeps all slots in ONE contiguous, cache-line aligned slab, so index -> object is a single
+ * "base + index" computation. It is the backing store of the compact order layout (CompactOrder.h).
+ * - Allocation: O(1) - Pops a free index (the free list is threaded through the slots themselves).
+ * - Deallocation: O(1) - Pushes the index back.
+ * - Capacity is fixed at construction: 32-bit links are only meaningful inside one slab.
+ */
+#pragma once
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "SlabMemory.h"
+
+namespace LOB {
+
+    /**
+     * @class IndexPool
+     * @brief Pool of T slots handing out uint32_t handles.
+     * @tparam T The type of object to store (e.g., CompactOrder).
+     */
+    template <typename T>
+    class IndexPool {
+        public:
+            using Index = uint32_t;
+            static constexpr Index NIL = 0xFFFFFFFFu; /**< "No slot" marker, also returned on exhaustion. */
+
+        private:
+            union Slot {
+                Index nextFree;
+                alignas(T) unsigned char storage[sizeof(T)];
+            };
+
+            SlabBlock block_;
+            Slot* slots_;
+            Index freeHead_ = NIL;
+            size_t capacity_;
+            size_t inUse_ = 0;
+
+        public:
+            /**
+             * @brief Construct the pool and pre-touch every slot.
+             * @param capacity Number of slots (must be below 2^32 - 1).
+             * @param hugePages Back the slab with 2 MB pages where supported.
+             */
+            explicit IndexPool(size_t capacity, bool hugePages = false) : capacity_(capacity) {
+                block_ = SlabMemory::acquire(capacity_ * sizeof(Slot), hugePages);
+                if(!block_.ptr) throw std::bad_alloc();
+                slots_ = static_cast<Slot*>(block_.ptr);
+
+                for(size_t i = capacity_; i-- > 0;){
+                    slots_[i].nextFree = freeHead_;
+                    freeHead_ = static_cast<Index>(i);
+                }
+            }
+
+            ~IndexPool(){ SlabMemory::release(block_); }
+
+            IndexPool(const IndexPool&) = delete;
+            IndexPool& operator=(const IndexPool&) = delete;
+
+            /**
+             * @brief Constructs an object in a free slot.
+             * @return The slot index, or NIL if the pool is exhausted.
+             */
+            template <typename... Args>
+            Index allocate(Args&&... args){
+                if(freeHead_ == NIL) [[unlikely]] return NIL;
+
+                Index idx = freeHead_;
+                freeHead_ = slots_[idx].nextFree;
+                ++inUse_;
+                ::new (static_cast<void*>(slots_[idx].storage)) T(std::forward<Args>(args)...);
+                return idx;
+            }
+
+            /**
+             * @brief Destroys the object at 'idx' and recycles the slot.
+             */
+            void deallocate(Index idx){
+                (*this)[idx].~T();
+                slots_[idx].nextFree = freeHead_;
+                freeHead_ = idx;
+                --inUse_;
+            }
+
+            T& operator[](Index idx) { return *std::launder(reinterpret_cast<T*>(slots_[idx].storage)); }
+            const T& operator[](Index idx) const { return *std::launder(reinterpret_cast<const T*>(slots_[idx].storage)); }
+
+            size_t getCapacity() const { return capacity_; }
+            size_t getFreeCount() const { return capacity_ - inUse_; }
+    };
+}
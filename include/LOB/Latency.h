@@ -0,0 +1,291 @@
+/**
+ * @file Latency.h
+ * @brief Low-overhead per-stage latency instrumentation: timestamps and HDR-style log-linear histograms.
+ * @details A request is timestamped at three points and the gaps are recorded per pipeline stage:
+ *
+ * | Stage     | From (timestamp)        | To (timestamp)                      | Recorded by            |
+ * | :---      | :---                    | :---                                | :---                   |
+ * | QueueWait | push (OrderRequest)     | pop (consumer)                      | the consuming thread   |
+ * | Ingress   | push                    | book entry (addOrder / batch)       | the book               |
+ * | Match     | book entry              | first trade emitted for the order   | the book               |
+ * | EndToEnd  | push                    | first trade emitted for the order   | the book               |
+ *
+ * - **Clock:** rdtsc on x86 (a few ns, calibrated once against steady_clock), steady_clock elsewhere.
+ * - **Histogram:** 32 linear sub-buckets per power of two, so every recorded value is within ~3% of the
+ *   truth, up to 2^40 ns, in a fixed 9 KB array. Recording is a bucket computation plus three relaxed
+ *   stores; each histogram has a single writer (the thread owning the book), readers never block it.
+ * - **Compile-Time Switch:** Tracking is compiled in only when NANOBOOK_LATENCY is 1. Otherwise
+ *   LatencyTracker is an empty type whose calls vanish (like NullSink) and OrderRequest has no timestamp field.
+ */
+#pragma once
+#include <bit>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NANOBOOK_HAS_RDTSC 1
+#endif
+
+#ifndef NANOBOOK_LATENCY
+#define NANOBOOK_LATENCY 0
+#endif
+
+namespace LOB {
+
+    /** Raw clock reading (TSC ticks or steady_clock nanoseconds, see LatencyClock). */
+    using Timestamp = uint64_t;
+
+    inline constexpr bool LATENCY_ENABLED = NANOBOOK_LATENCY != 0;
+
+    namespace LatencyClock {
+
+        /**
+         * @brief Current time in clock ticks.
+         */
+        inline Timestamp now(){
+#if defined(NANOBOOK_HAS_RDTSC)
+            return __rdtsc();
+#else
+            return static_cast<Timestamp>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /**
+         * @brief Nanoseconds per tick (measured once against steady_clock on first use).
+         */
+        inline double nanosPerTick(){
+#if defined(NANOBOOK_HAS_RDTSC)
+            static const double ratio = []{
+                auto wallStart = std::chrono::steady_clock::now();
+                Timestamp tickStart = now();
+                while(std::chrono::steady_clock::now() - wallStart < std::chrono::milliseconds(5)) {}
+                double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - wallStart).count());
+                return ns / static_cast<double>(now() - tickStart);
+            }();
+            return ratio;
+#else
+            return 1.0;
+#endif
+        }
+
+        /**
+         * @brief Elapsed nanoseconds between two readings (0 if 'end' precedes 'start').
+         */
+        inline uint64_t elapsedNanos(Timestamp start, Timestamp end){
+            return end > start ? static_cast<uint64_t>(static_cast<double>(end - start) * nanosPerTick()) : 0;
+        }
+    }
+
+    /**
+     * @class LatencyHistogram
+     * @brief Log-linear (HDR-style) histogram of nanosecond values.
+     * @note Single writer. Any thread may read concurrently (values are relaxed atomics).
+     */
+    class LatencyHistogram {
+        public:
+            static constexpr unsigned SUB_BITS = 5;                       /**< 32 sub-buckets per power of two */
+            static constexpr unsigned MAX_BITS = 40;                      /**< Values clamp at 2^40 - 1 ns (~18 min) */
+            static constexpr size_t SUB_COUNT = size_t{1} << SUB_BITS;
+            static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+        private:
+            std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+            std::atomic<uint64_t> count_{0};
+            std::atomic<uint64_t> max_{0};
+            std::atomic<uint64_t> sum_{0};
+
+            static void bump(std::atomic<uint64_t>& a, uint64_t by){
+                a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+            }
+
+        public:
+            /**
+             * @brief Bucket holding 'value' (values below 32 get an exact bucket each).
+             */
+            static size_t bucketOf(uint64_t value){
+                if(value >= (uint64_t{1} << MAX_BITS)) value = (uint64_t{1} << MAX_BITS) - 1;
+                if(value < SUB_COUNT) return static_cast<size_t>(value);
+
+                unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SUB_BITS;
+                return (shift + 1) * SUB_COUNT + static_cast<size_t>((value >> shift) - SUB_COUNT);
+            }
+
+            /**
+             * @brief Largest value that falls into 'bucket' (what percentiles report).
+             */
+            static uint64_t bucketUpperBound(size_t bucket){
+                if(bucket < SUB_COUNT) return bucket;
+                unsigned shift = static_cast<unsigned>(bucket / SUB_COUNT) - 1;
+                uint64_t low = (SUB_COUNT + bucket % SUB_COUNT) << shift;
+                return low + (uint64_t{1} << shift) - 1;
+            }
+
+            /**
+             * @brief Records one value (Writer thread only).
+             * @note Complexity: O(1), no allocation.
+             */
+            void record(uint64_t nanos){
+                bump(counts_[bucketOf(nanos)], 1);
+                bump(count_, 1);
+                bump(sum_, nanos);
+                if(nanos > max_.load(std::memory_order_relaxed)) max_.store(nanos, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Value at percentile 'p' (0 < p <= 100), e.g. 99.9. 0 if empty.
+             * @details Reported as the upper bound of the bucket, capped at the exact maximum.
+             */
+            uint64_t percentile(double p) const {
+                uint64_t total = count_.load(std::memory_order_relaxed);
+                if(total == 0) return 0;
+
+                uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.999999);
+                if(rank == 0) rank = 1;
+                if(rank > total) rank = total;
+
+                uint64_t seen = 0;
+                for(size_t b = 0; b < BUCKETS; ++b){
+                    seen += counts_[b].load(std::memory_order_relaxed);
+                    if(seen >= rank) return std::min(bucketUpperBound(b), getMax());
+                }
+                return getMax();
+            }
+
+            /**
+             * @brief Adds another histogram's samples into this one (e.g. to combine per-thread histograms).
+             */
+            void merge(const LatencyHistogram& other){
+                for(size_t b = 0; b < BUCKETS; ++b) bump(counts_[b], other.counts_[b].load(std::memory_order_relaxed));
+                bump(count_, other.getCount());
+                bump(sum_, other.sum_.load(std::memory_order_relaxed));
+                if(other.getMax() > getMax()) max_.store(other.getMax(), std::memory_order_relaxed);
+            }
+
+            void reset(){
+                for(auto& c : counts_) c.store(0, std::memory_order_relaxed);
+                count_.store(0, std::memory_order_relaxed);
+                max_.store(0, std::memory_order_relaxed);
+                sum_.store(0, std::memory_order_relaxed);
+            }
+
+            uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+            uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+            double getMean() const {
+                uint64_t n = getCount();
+                return n ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+            }
+    };
+
+    /**
+     * @brief Prints "label: n=.. p50=..ns p99=..ns p99.9=..ns max=..ns".
+     */
+    std::ostream& printSummary(std::ostream& os, const char* label, const LatencyHistogram& histogram);
+
+    /**
+     * @enum LatencyStage
+     * @brief The pipeline gaps being measured (see the table at the top of the file).
+     */
+    enum class LatencyStage : uint8_t { QueueWait, Ingress, Match, EndToEnd };
+
+    inline constexpr size_t LATENCY_STAGE_COUNT = 4;
+
+    /**
+     * @brief Printable name of a stage.
+     */
+    const char* toString(LatencyStage stage);
+
+    /**
+     * @class BasicLatencyTracker
+     * @brief One histogram per stage plus the in-flight order's timestamps, owned by one thread.
+     * @tparam Enabled false yields an empty tracker whose calls compile away.
+     */
+    template <bool Enabled>
+    class BasicLatencyTracker {
+        private:
+            std::array<LatencyHistogram, LATENCY_STAGE_COUNT> stages_;
+            Timestamp sentAt_ = 0;
+            Timestamp enteredAt_ = 0;
+            bool awaitingTrade_ = false;
+
+        public:
+            BasicLatencyTracker(){ LatencyClock::nanosPerTick(); } // calibrate off the hot path
+
+            /**
+             * @brief Records the gap between two timestamps into one stage.
+             */
+            void record(LatencyStage stage, Timestamp start, Timestamp end){
+                stages_[static_cast<size_t>(stage)].record(LatencyClock::elapsedNanos(start, end));
+            }
+
+            /**
+             * @brief Called when an order enters the book.
+             * @param sentAt Its push timestamp, or 0 if it did not come through a queue.
+             */
+            void beginOrder(Timestamp sentAt){
+                enteredAt_ = LatencyClock::now();
+                sentAt_ = sentAt;
+                awaitingTrade_ = true;
+                if(sentAt) record(LatencyStage::Ingress, sentAt, enteredAt_);
+            }
+
+            /**
+             * @brief Called for every trade; only the first one after beginOrder() is timed.
+             */
+            void onTrade(){
+                if(!awaitingTrade_) return;
+                awaitingTrade_ = false;
+                Timestamp t = LatencyClock::now();
+                record(LatencyStage::Match, enteredAt_, t);
+                if(sentAt_) record(LatencyStage::EndToEnd, sentAt_, t);
+            }
+
+            /**
+             * @brief Called when the instruction ends: a later trade belongs to another order and must not use this stamp.
+             */
+            void endOrder(){ awaitingTrade_ = false; }
+
+            const LatencyHistogram& get(LatencyStage stage) const { return stages_[static_cast<size_t>(stage)]; }
+
+            /**
+             * @brief Adds another tracker's histograms into this one.
+             */
+            void merge(const BasicLatencyTracker& other){
+                for(size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) stages_[i].merge(other.stages_[i]);
+            }
+
+            /**
+             * @brief Prints one summary line per non-empty stage.
+             */
+            void print(std::ostream& os) const;
+    };
+
+    /**
+     * @brief Disabled tracker: no state, no clock reads.
+     */
+    template <>
+    class BasicLatencyTracker<false> {
+        public:
+            void record(LatencyStage, Timestamp, Timestamp) {}
+            void beginOrder(Timestamp) {}
+            void onTrade() {}
+            void endOrder() {}
+            void merge(const BasicLatencyTracker&) {}
+            void print(std::ostream& os) const;
+    };
+
+    // BasicLatencyTracker<true>::print() is defined (and the class explicitly instantiated) in Latency.cpp.
+    extern template class BasicLatencyTracker<true>;
+
+    /**
+     * @brief The tracker selected by NANOBOOK_LATENCY.
+     */
+    using LatencyTracker = BasicLatencyTracker<LATENCY_ENABLED>;
+}
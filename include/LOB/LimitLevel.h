@@ -27,6 +27,12 @@ namespace LOB {
             // Tail of the queue (Last order added)
             Order* tail_ = nullptr;
 
+            // Number of orders in the queue (published with the top of book)
+            uint32_t orderCount_ = 0;
+
+            // Number of those orders with a hidden reserve (icebergs, see ConditionalOrders.h)
+            uint32_t icebergCount_ = 0;
+
         public:
             /**
              * @brief Construct a new Limit Level object.
@@ -49,6 +55,46 @@ namespace LOB {
              */
             void remove(Order* order);
 
+            /**
+             * @brief Executes part (or all) of an order in place.
+             * @details Decrements both the order's open quantity and the cached level volume,
+             * keeping getVolume() exact across partial fills.
+             * @param order Pointer to an order resting at this level.
+             * @param qty Filled quantity (must not exceed order->quantity).
+             * @note Complexity: O(1)
+             */
+            void fill(Order* order, Quantity qty);
+
+            /**
+             * @brief Shrinks a resting order in place (an amendment, not a fill).
+             * @details The order keeps its position in the queue; only the quantities change.
+             * @param order Pointer to an order resting at this level.
+             * @param newQty New open quantity (must not exceed order->quantity).
+             * @note Complexity: O(1)
+             */
+            void reduce(Order* order, Quantity newQty);
+
+            /**
+             * @brief Shows the next slice of an iceberg whose displayed quantity was just filled.
+             * @details The order goes to the back of the queue (a new slice has no time priority) with 'slice' open.
+             * Cheaper than remove() + append(): the order count does not change.
+             * @param order Pointer to a fully filled order resting at this level.
+             * @param slice Newly displayed quantity.
+             * @note Complexity: O(1)
+             */
+            void replenish(Order* order, Quantity slice);
+
+            /**
+             * @brief Counts an order of this level that has a hidden reserve (or no longer has one).
+             */
+            void addIceberg() { ++icebergCount_; }
+            void removeIceberg() { --icebergCount_; }
+
+            /**
+             * @brief Number of orders here with a hidden reserve. 0 lets the matcher skip the replenishment logic.
+             */
+            uint32_t getIcebergCount() const { return icebergCount_; }
+
             /**
              * @brief Checks if the level has no orders.
              * @return true if empty, false otherwise.
@@ -66,6 +112,11 @@ namespace LOB {
              */
             Quantity getVolume() const { return totalVolume_;}
 
+            /**
+             * @brief Gets the number of orders queued at this price.
+             */
+            uint32_t getOrderCount() const { return orderCount_; }
+
             /**
              * @brief Access the oldest order at this level (for matching).
              * @return Pointer to the head order, or nullptr if empty.
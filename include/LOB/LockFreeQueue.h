@@ -4,10 +4,28 @@
  * @details This class implements a circular buffer that allows two threads (Network and Engine)
  * to exchange data without using mutexes. It relies on C++20 std::atomic with Acquire-Release memory
  * ordering to ensure data consistency with minimal CPU overhead.
+ *
+ * Layout for throughput:
+ * 1. **Power-of-Two Capacity:** Indices are free-running counters; the slot is (index & mask), never a modulo.
+ * 2. **Padded Indices:** The consumer's head and the producer's tail live on separate cache lines, so the
+ *    two cores never false-share a line.
+ * 3. **Cached Peer Index:** Each side keeps a private copy of the other side's index and only re-reads
+ *    the shared atomic when that copy says the queue is full (producer) or empty (consumer).
+ *
+ * Besides push()/pop(), both sides have batch and zero-copy forms:
+ * - push_bulk()/pop_bulk(): move up to N items with a single index publication.
+ * - try_claim()/try_claim_bulk()/commit(): the producer builds messages directly inside their slots.
+ * - front()/peek_bulk()/release(): the consumer reads messages in place and frees the slots afterwards.
+ *
+ * For monitoring, size() gives the current depth and getFullCount() how often the producer found the ring full
+ * (its retries / drops). Both are plain loads, safe from any thread.
  */
 #pragma once
 #include <vector>
 #include <atomic>
+#include <cstddef>
+#include <span>
+#include <algorithm>
 
 namespace LOB {
 
@@ -19,20 +37,42 @@ namespace LOB {
     template <typename T>
     class LockFreeQueue {
         private:
+            static constexpr size_t CACHE_LINE = 64;
+
+            static size_t roundUpPow2(size_t n){
+                size_t p = 1;
+                while(p < n) p <<= 1;
+                return p;
+            }
+
             std::vector<T> buffer_;
+            size_t mask_;
+
+            // --- Consumer Line ---
+            alignas(CACHE_LINE) std::atomic<size_t> head_ = {0}; /**<Read Index (Owned by Consumer) */
+            size_t cachedTail_ = 0;                              /**<Consumer's last view of tail_ */
+
+            // --- Producer Line ---
+            alignas(CACHE_LINE) std::atomic<size_t> tail_ = {0}; /**<Write Index (Owned by Producer) */
+            size_t cachedHead_ = 0;                              /**<Producer's last view of head_ */
+            std::atomic<size_t> fullCount_ = {0};                /**<Pushes refused by a full ring (Producer-written) */
 
-            // alignas(64) prevents "False Sharing" by ensuring head and tail
-            // reside on different cache lines.
-            std::atomic<size_t> head_ = {0}; /**<Read Index (Owned by Consumer) */
-            std::atomic<size_t> tail_ = {0}; /**<Write Index (Owned by Producer) */
-            size_t capacity_;
+            // Keeps whatever follows the queue off the producer's line.
+            char pad_[CACHE_LINE - 2 * sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+            /**
+             * @brief Records one refused push. Single writer: a load and a store, no atomic RMW.
+             */
+            void countFull(){
+                fullCount_.store(fullCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
 
         public:
             /**
              * @brief Construct a new Lock Free Queue.
-             * @param size The maximum capacity of the queue.
+             * @param size The minimum capacity of the queue (rounded up to a power of two).
              */
-            explicit LockFreeQueue(size_t size) : buffer_(size + 1), capacity_(size + 1) {}
+            explicit LockFreeQueue(size_t size) : buffer_(roundUpPow2(size)), mask_(buffer_.size() - 1) {}
 
             /**
              * @brief Pushes an item onto the queue (Producer only).
@@ -43,19 +83,22 @@ namespace LOB {
             bool push(const T& item){
                 // Relaxed: We are the only thread writing to tail_, so we just need the value.
                 size_t currentTail = tail_.load(std::memory_order_relaxed);
-                size_t nextTail = (currentTail + 1) % capacity_;
 
-                // Acquire: Sync with Consumer. Ensure we read the latest 'head_'
-                // to avoid overwriting unread data.
-                if(nextTail == head_.load(std::memory_order_acquire)) {
-                    return false;
+                // Only when our cached view says "full" do we pay for the cross-core read.
+                // Acquire: Sync with Consumer, so we never overwrite unread data.
+                if(currentTail - cachedHead_ == buffer_.size()){
+                    cachedHead_ = head_.load(std::memory_order_acquire);
+                    if(currentTail - cachedHead_ == buffer_.size()){
+                        countFull();
+                        return false;
+                    }
                 }
 
-                buffer_[currentTail] = item;
+                buffer_[currentTail & mask_] = item;
 
                 // Release: Publish the new tail. Guarantees that the write to 'buffer_'
                 // is visible to the consumer BEFORE they see the new tail index.
-                tail_.store(nextTail, std::memory_order_release);
+                tail_.store(currentTail + 1, std::memory_order_release);
                 return true;
             }
 
@@ -66,20 +109,172 @@ namespace LOB {
              * @note Uses std::memory_order_acquire to synch with the producer.
              */
             bool pop(T& item){
-                // Released: We are the only thread writing to head_.
+                // Relaxed: We are the only thread writing to head_.
                 size_t currentHead = head_.load(std::memory_order_relaxed);
 
-                // Acquire: Sync with Producer. Ensure we read the latest 'tail_'
-                // to see if the new data is available.
-                if(currentHead == tail_.load(std::memory_order_acquire)){
-                    return false;
+                // Acquire (only on a cache miss): Sync with Producer to see newly published data.
+                if(currentHead == cachedTail_){
+                    cachedTail_ = tail_.load(std::memory_order_acquire);
+                    if(currentHead == cachedTail_) return false;
                 }
 
-                item = buffer_[currentHead];
+                item = buffer_[currentHead & mask_];
 
                 // Release: Notify Producer that a slot has been freed.
-                head_.store((currentHead + 1) % capacity_, std::memory_order_release);
+                head_.store(currentHead + 1, std::memory_order_release);
                 return true;
             }
+
+            /**
+             * @brief Pushes up to 'count' items and publishes them with one tail update (Producer only).
+             * @return The number of items actually pushed (less than 'count' if the queue filled up).
+             */
+            size_t push_bulk(const T* items, size_t count){
+                size_t currentTail = tail_.load(std::memory_order_relaxed);
+
+                size_t space = buffer_.size() - (currentTail - cachedHead_);
+                if(space < count){
+                    cachedHead_ = head_.load(std::memory_order_acquire);
+                    space = buffer_.size() - (currentTail - cachedHead_);
+                }
+                size_t n = std::min(count, space);
+                if(n < count) countFull();
+                if(n == 0) return 0;
+
+                // At most two contiguous runs: up to the end of the buffer, then from the start.
+                size_t first = std::min(n, buffer_.size() - (currentTail & mask_));
+                std::copy_n(items, first, buffer_.begin() + (currentTail & mask_));
+                std::copy_n(items + first, n - first, buffer_.begin());
+
+                tail_.store(currentTail + n, std::memory_order_release);
+                return n;
+            }
+
+            /**
+             * @brief Pops up to 'max' items and frees their slots with one head update (Consumer only).
+             * @return The number of items written to 'out' (0 if the queue was empty).
+             */
+            size_t pop_bulk(T* out, size_t max){
+                size_t currentHead = head_.load(std::memory_order_relaxed);
+
+                size_t available = cachedTail_ - currentHead;
+                if(available < max){
+                    cachedTail_ = tail_.load(std::memory_order_acquire);
+                    available = cachedTail_ - currentHead;
+                }
+                size_t n = std::min(max, available);
+                if(n == 0) return 0;
+
+                size_t first = std::min(n, buffer_.size() - (currentHead & mask_));
+                std::copy_n(buffer_.begin() + (currentHead & mask_), first, out);
+                std::copy_n(buffer_.begin(), n - first, out + first);
+
+                head_.store(currentHead + n, std::memory_order_release);
+                return n;
+            }
+
+            // --- Zero-Copy Producer ---
+
+            /**
+             * @brief Reserves the next slot for in-place construction (Producer only).
+             * @return A pointer to the slot, or nullptr if the queue is full. Nothing is visible to the consumer until commit().
+             */
+            T* try_claim(){
+                size_t currentTail = tail_.load(std::memory_order_relaxed);
+                if(currentTail - cachedHead_ == buffer_.size()){
+                    cachedHead_ = head_.load(std::memory_order_acquire);
+                    if(currentTail - cachedHead_ == buffer_.size()){
+                        countFull();
+                        return nullptr;
+                    }
+                }
+                return &buffer_[currentTail & mask_];
+            }
+
+            /**
+             * @brief Reserves up to 'max' consecutive slots for in-place construction (Producer only).
+             * @details The run stops at the physical end of the buffer, like peek_bulk(). Fill a prefix of it,
+             * then publish that prefix with a single commit(count).
+             * @return The claimed slots (empty if the queue is full).
+             */
+            std::span<T> try_claim_bulk(size_t max){
+                size_t currentTail = tail_.load(std::memory_order_relaxed);
+                size_t space = buffer_.size() - (currentTail - cachedHead_);
+                if(space < max){
+                    cachedHead_ = head_.load(std::memory_order_acquire);
+                    space = buffer_.size() - (currentTail - cachedHead_);
+                    if(space == 0){
+                        countFull();
+                        return {};
+                    }
+                }
+                size_t offset = currentTail & mask_;
+                return std::span<T>(buffer_.data() + offset, std::min({max, space, buffer_.size() - offset}));
+            }
+
+            /**
+             * @brief Publishes the first 'count' slots of the last successful try_claim() / try_claim_bulk() (Producer only).
+             */
+            void commit(size_t count = 1){
+                tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+
+            // --- Zero-Copy Consumer ---
+
+            /**
+             * @brief Returns the oldest item without removing it (Consumer only).
+             * @return A pointer into the ring, or nullptr if the queue is empty. Valid until release().
+             */
+            const T* front(){
+                size_t currentHead = head_.load(std::memory_order_relaxed);
+                if(currentHead == cachedTail_){
+                    cachedTail_ = tail_.load(std::memory_order_acquire);
+                    if(currentHead == cachedTail_) return nullptr;
+                }
+                return &buffer_[currentHead & mask_];
+            }
+
+            /**
+             * @brief Returns up to 'max' of the oldest items as one contiguous view (Consumer only).
+             * @details The view stops at the physical end of the buffer, so a wrapped run takes two calls.
+             * Feed it straight into OrderBook::applyBatch(), then release(view.size()).
+             */
+            std::span<const T> peek_bulk(size_t max){
+                size_t currentHead = head_.load(std::memory_order_relaxed);
+                size_t available = cachedTail_ - currentHead;
+                if(available < max){
+                    cachedTail_ = tail_.load(std::memory_order_acquire);
+                    available = cachedTail_ - currentHead;
+                }
+                size_t offset = currentHead & mask_;
+                size_t n = std::min({max, available, buffer_.size() - offset});
+                return std::span<const T>(buffer_.data() + offset, n);
+            }
+
+            /**
+             * @brief Frees the 'count' oldest slots obtained through front() or peek_bulk() (Consumer only).
+             */
+            void release(size_t count = 1){
+                head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+
+            /**
+             * @brief Number of slots (a power of two).
+             */
+            size_t getCapacity() const { return buffer_.size(); }
+
+            /**
+             * @brief Approximate number of queued items (exact when called from either owning thread while the other is idle).
+             */
+            size_t size() const {
+                // Head first: tail_ can only move further ahead, so the difference never underflows.
+                size_t head = head_.load(std::memory_order_acquire);
+                return tail_.load(std::memory_order_acquire) - head;
+            }
+
+            /**
+             * @brief Number of push() / try_claim() calls refused, and push_bulk() calls cut short, by a full ring.
+             */
+            size_t getFullCount() const { return fullCount_.load(std::memory_order_relaxed); }
     };
-}
\ No newline at end of file
+}
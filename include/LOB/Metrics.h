@@ -0,0 +1,105 @@
+/**
+ * @file Metrics.h
+ * @brief Live operational counters and gauges of one book, written by its matching thread only.
+ * @details Complements the latency histograms (Latency.h) with "how much, how full":
+ *
+ * | Kind    | Name                          | Updated                                   |
+ * | :---    | :---                          | :---                                      |
+ * | Counter | instructions, orders, modifies | per instruction / new order / amendment   |
+ * | Counter | trades, traded quantity        | per fill                                  |
+ * | Counter | cancels, rejects               | per Cancel / Reject event                 |
+ * | Gauge   | resting orders, index capacity | end of every instruction (load factor)    |
+ * | Gauge   | pool in use, pool capacity     | end of every instruction (pool occupancy) |
+ * | Gauge   | bid levels, ask levels         | end of every instruction                  |
+ *
+ * - **No RMW:** Every value has a single writer, so a bump is a relaxed load + store (a plain add on x86),
+ *   never a lock-prefixed instruction. Readers (the exporter, MetricsExporter.h) load relaxed.
+ * - **Isolation:** The block is aligned to its own cache lines, so sampling it never invalidates the
+ *   lines holding the book's matching state.
+ * - **Compile-Time Switch:** Compiled in only when NANOBOOK_METRICS is 1. Otherwise BookMetrics is an empty
+ *   type whose calls vanish and every read returns 0.
+ */
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#ifndef NANOBOOK_METRICS
+#define NANOBOOK_METRICS 0
+#endif
+
+namespace LOB {
+
+    inline constexpr bool METRICS_ENABLED = NANOBOOK_METRICS != 0;
+
+    /**
+     * @enum Counter
+     * @brief Monotonic totals (exported as Prometheus counters).
+     */
+    enum class Counter : uint8_t { Instructions, Orders, Modifies, Trades, TradedQuantity, Cancels, Rejects };
+
+    inline constexpr size_t COUNTER_COUNT = 7;
+
+    /**
+     * @enum Gauge
+     * @brief Point-in-time values, refreshed at the end of every instruction.
+     */
+    enum class Gauge : uint8_t { RestingOrders, IndexCapacity, PoolInUse, PoolCapacity, BidLevels, AskLevels };
+
+    inline constexpr size_t GAUGE_COUNT = 6;
+
+    /**
+     * @brief Exported (snake_case) name of a counter / gauge.
+     */
+    const char* toString(Counter counter);
+    const char* toString(Gauge gauge);
+
+    /**
+     * @class BasicBookMetrics
+     * @brief The counters and gauges of one book.
+     * @tparam Enabled false yields an empty block whose calls compile away.
+     */
+    template <bool Enabled>
+    class alignas(64) BasicBookMetrics {
+        private:
+            std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters_{};
+            std::array<std::atomic<uint64_t>, GAUGE_COUNT> gauges_{};
+
+        public:
+            /**
+             * @brief Adds 'by' to a counter (writer thread only).
+             */
+            void count(Counter counter, uint64_t by = 1){
+                std::atomic<uint64_t>& value = counters_[static_cast<size_t>(counter)];
+                value.store(value.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Overwrites a gauge (writer thread only).
+             */
+            void set(Gauge gauge, uint64_t value){
+                gauges_[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+            }
+
+            uint64_t get(Counter counter) const { return counters_[static_cast<size_t>(counter)].load(std::memory_order_relaxed); }
+            uint64_t get(Gauge gauge) const { return gauges_[static_cast<size_t>(gauge)].load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Disabled metrics: no storage, no code.
+     */
+    template <>
+    class BasicBookMetrics<false> {
+        public:
+            void count(Counter, uint64_t = 1) {}
+            void set(Gauge, uint64_t) {}
+            uint64_t get(Counter) const { return 0; }
+            uint64_t get(Gauge) const { return 0; }
+    };
+
+    /**
+     * @brief The block every book carries (empty unless NANOBOOK_METRICS).
+     */
+    using BookMetrics = BasicBookMetrics<METRICS_ENABLED>;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file MetricsExporter.h
+ * @brief Samples book and queue metrics on a background thread and publishes them (Prometheus text / shared memory).
+ * @details The matching thread only bumps its BookMetrics (Metrics.h) and the queues their own counters; all
+ * formatting, rates and I/O happen here, on the exporter's thread:
+ * 1. **Registry:** Books and queues are registered once, before the exporter starts. A sample is a set of
+ *    relaxed loads: it never takes a lock and never writes to a line the hot threads own.
+ * 2. **Prometheus Text:** renderPrometheus() emits the `_total` counters, the gauges, per-second rates (from the
+ *    previous sample) and the derived index load factor / pool occupancy. The file is replaced atomically
+ *    (write to PATH.tmp, then rename), so a node-exporter textfile collector never reads half a file.
+ * 3. **Shared Memory:** A fixed SharedMetricsLayout under /dev/shm, seqlock-published (odd sequence while
+ *    writing), for local scrapers that should not parse text. readSharedMetrics() is the reader side.
+ */
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Metrics.h"
+#include "LockFreeQueue.h"
+
+namespace LOB {
+
+    /**
+     * @struct BookMetricsSample
+     * @brief The counters and gauges of one book at one instant.
+     */
+    struct BookMetricsSample {
+        std::string label;
+        std::array<uint64_t, COUNTER_COUNT> counters{};
+        std::array<uint64_t, GAUGE_COUNT> gauges{};
+
+        uint64_t get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+        uint64_t get(Gauge gauge) const { return gauges[static_cast<size_t>(gauge)]; }
+    };
+
+    /**
+     * @struct QueueMetricsSample
+     * @brief Depth and back-pressure of one ring buffer at one instant.
+     */
+    struct QueueMetricsSample {
+        std::string label;
+        uint64_t depth = 0;        /**< Items waiting for the consumer. */
+        uint64_t capacity = 0;     /**< Slots in the ring. */
+        uint64_t fullCount = 0;    /**< Pushes refused (or cut short) by a full ring, ever. */
+    };
+
+    /**
+     * @struct MetricsSnapshot
+     * @brief One sample of everything registered.
+     */
+    struct MetricsSnapshot {
+        uint64_t timestampNanos = 0;    /**< steady_clock time of the sample. */
+        std::vector<BookMetricsSample> books;
+        std::vector<QueueMetricsSample> queues;
+    };
+
+    /**
+     * @class MetricsRegistry
+     * @brief The books and queues an exporter samples.
+     * @warning Register everything before the exporter starts; the registered objects must outlive it.
+     */
+    class MetricsRegistry {
+        private:
+            struct BookSource {
+                std::string label;
+                const BookMetrics* metrics;
+            };
+
+            struct QueueSource {
+                std::string label;
+                std::function<QueueMetricsSample()> sample;
+            };
+
+            std::vector<BookSource> books_;
+            std::vector<QueueSource> queues_;
+
+        public:
+            void addBook(std::string label, const BookMetrics& metrics){
+                books_.push_back({std::move(label), &metrics});
+            }
+
+            /**
+             * @brief Registers a ring buffer: a LockFreeQueue, or anything with size() / getCapacity() / getFullCount().
+             */
+            template <typename Queue>
+            void addQueue(std::string label, const Queue& queue){
+                queues_.push_back({std::move(label), [&queue]{
+                    QueueMetricsSample sample;
+                    sample.depth = queue.size();
+                    sample.capacity = queue.getCapacity();
+                    sample.fullCount = queue.getFullCount();
+                    return sample;
+                }});
+            }
+
+            /**
+             * @brief Reads every registered source (relaxed loads only).
+             */
+            MetricsSnapshot sample() const;
+    };
+
+    /**
+     * @brief Prometheus text exposition of a sample.
+     * @param previous An earlier sample of the same registry: adds `_per_second` rates for every counter.
+     */
+    std::string renderPrometheus(const MetricsSnapshot& now, const MetricsSnapshot* previous = nullptr);
+
+    /**
+     * @struct SharedMetricsLayout
+     * @brief The shared-memory image of a sample: fixed size, 64-bit words only, seqlock-published.
+     * @details Labels are NUL-padded into LABEL_WORDS words (at most 31 characters survive).
+     * Books / queues beyond MAX_BOOKS / MAX_QUEUES are not exported.
+     */
+    struct SharedMetricsLayout {
+        static constexpr uint64_t MAGIC = 0x43495254454D424Eull;    // "NBMETRIC" read as a little-endian word
+        static constexpr size_t MAX_BOOKS = 64;
+        static constexpr size_t MAX_QUEUES = 16;
+        static constexpr size_t LABEL_WORDS = 4;
+
+        struct Book {
+            uint64_t label[LABEL_WORDS];
+            uint64_t counters[COUNTER_COUNT];
+            uint64_t gauges[GAUGE_COUNT];
+        };
+
+        struct Queue {
+            uint64_t label[LABEL_WORDS];
+            uint64_t depth;
+            uint64_t capacity;
+            uint64_t fullCount;
+        };
+
+        uint64_t magic;
+        uint64_t sequence;          /**< Odd while the writer is updating, bumped by 2 per sample. */
+        uint64_t timestampNanos;
+        uint64_t bookCount;
+        uint64_t queueCount;
+        Book books[MAX_BOOKS];
+        Queue queues[MAX_QUEUES];
+    };
+
+    /**
+     * @brief Reads the latest consistent sample from a shared-memory region (any process).
+     * @param name The POSIX shm name the exporter was given (e.g. "/nanobook_metrics").
+     * @return false if the region does not exist, is not a metrics region, or stayed busy.
+     */
+    bool readSharedMetrics(const std::string& name, MetricsSnapshot& out);
+
+    /**
+     * @struct ExporterOptions
+     * @brief Where and how often the exporter publishes. An empty path / name disables that output.
+     */
+    struct ExporterOptions {
+        std::chrono::milliseconds interval{1000};
+        std::string prometheusPath;       /**< Text file, replaced atomically on every sample. */
+        std::string sharedMemoryName;     /**< POSIX shm name, created by the constructor, unlinked by the destructor. */
+    };
+
+    /**
+     * @class MetricsExporter
+     * @brief Background thread that samples a registry every 'interval' and publishes the result.
+     */
+    class MetricsExporter {
+        private:
+            class SharedRegion;
+
+            const MetricsRegistry& registry_;
+            ExporterOptions options_;
+            std::unique_ptr<SharedRegion> shared_;
+
+            MetricsSnapshot previous_;
+            bool hasPrevious_ = false;
+
+            std::thread thread_;
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            bool running_ = false;
+
+            void run();
+
+        public:
+            MetricsExporter(const MetricsRegistry& registry, ExporterOptions options);
+            ~MetricsExporter();
+
+            MetricsExporter(const MetricsExporter&) = delete;
+            MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+            /**
+             * @brief Starts the sampling thread (no-op if already running).
+             */
+            void start();
+
+            /**
+             * @brief Stops the thread after one final sample, so the outputs hold the end-of-run values.
+             */
+            void stop();
+
+            /**
+             * @brief Samples and publishes once, on the calling thread (do not mix with a running exporter).
+             * @return The sample that was published.
+             */
+            MetricsSnapshot exportOnce();
+
+            /**
+             * @brief Did the shared-memory region open? (false if none was requested or shm_open failed).
+             */
+            bool hasSharedMemory() const { return shared_ != nullptr; }
+    };
+}
@@ -3,89 +3,163 @@
  * @brief Defines a pre-allocated memory pool (Slab Allocator) for fast object management.
  * @details Calling 'new' or 'malloc' is avoided because it triggers a system call (context switch)
  * and non-deterministic heap fragmentation.
- * This ObjectPool pre-allocates a contiguos block of memory (std::vector)
- * - Allocation: O(1) - Pops a free index from the stack.
- * - Deallocation: O(1) - Pushes the index back onto the stack.
+ * This ObjectPool pre-allocates contiguous, cache-line aligned slabs of raw slots:
+ * - Allocation: O(1) - Pops the head of an intrusive free list and constructs the object in place.
+ * - Deallocation: O(1) - Destroys the object and pushes its slot back onto the free list.
+ * - Growth (optional): When the free list runs dry, a whole new slab is reserved. Existing slabs never move,
+ *   so every pointer handed out stays valid.
  * - Cache Friendliness: LIFO (Last-In, First-Out) strategy ensures we reuse the most recently released object(hot cache).
  */
 #pragma once
 #include <vector>
-#include <numeric>
+#include <cstddef>
+#include <utility>
+#include <new>
+#include "SlabMemory.h"
 
 namespace LOB{
+
+    /**
+     * @struct PoolOptions
+     * @brief Behaviour switches for ObjectPool.
+     */
+    struct PoolOptions {
+        /** Reserve another slab (same size as the first) instead of failing when the pool is exhausted. */
+        bool growable = false;
+
+        /** Back slabs with 2 MB pages where the platform supports it (see SlabMemory.h). */
+        bool hugePages = false;
+
+        /** mlock each slab after it is pre-touched (best effort: a refused lock leaves the slab usable). */
+        bool lockPages = false;
+    };
+
     /**
      * @class ObjectPool
-     * @brief Template class for managing a fixed-size pool of objects.
+     * @brief Template class for managing a pool of objects in fixed-size slabs.
      * @tparam T The type of object to store (e.g., Order).
+     * @note Objects still allocated when the pool is destroyed are released without running their destructor.
      */
     template <typename T>
     class ObjectPool{
         private:
-            // Contiguos memory block. Friendly to CPU prefetcher.
-            std::vector<T> pool_;
+            // A free slot stores the link to the next free slot in its own bytes (Intrusive Free List),
+            // so no side table of indices is needed.
+            union Slot {
+                Slot* next;
+                alignas(T) unsigned char storage[sizeof(T)];
+            };
 
-            // Stack of available indices.
-            // We use indices instead of pointers to ensure stability if vector resizes.
-            std::vector<size_t> freeIndices_;
+            std::vector<SlabBlock> slabs_;
+            Slot* freeList_ = nullptr;
+
+            size_t slabSize_;
+            size_t capacity_ = 0;
+            size_t inUse_ = 0;
+            PoolOptions options_;
+
+            /**
+             * @brief Reserves one slab and threads all of its slots onto the free list.
+             * @details Writing the link of every slot also pre-touches (page-faults in) the whole slab
+             * here, at reservation time, instead of on the first allocations of the hot path.
+             * @return false if the system could not provide the memory.
+             */
+            bool addSlab(){
+                SlabBlock block = SlabMemory::acquire(slabSize_ * sizeof(Slot), options_.hugePages);
+                if(!block.ptr) return false;
+                slabs_.push_back(block);
+
+                // Build in reverse so the lowest address is handed out first.
+                Slot* slots = static_cast<Slot*>(block.ptr);
+                for(size_t i = slabSize_; i-- > 0;){
+                    slots[i].next = freeList_;
+                    freeList_ = &slots[i];
+                }
+                if(options_.lockPages) SlabMemory::lock(slabs_.back());
+                capacity_ += slabSize_;
+                return true;
+            }
 
         public:
             /**
              * @brief Construct a new object pool.
-             * @param size The total capacity of the pool.
-             * @note This triggers strict pre-allocation. All objects are default-constructed immediately.
+             * @param size Number of slots per slab (the initial capacity).
+             * @param options Growth / huge page behaviour.
+             * @note The first slab is reserved and pre-touched immediately. No object is constructed until allocate().
              */
-            explicit ObjectPool(size_t size){
-                pool_.resize(size);
-                freeIndices_.reserve(size);
-
-                // Initialize the free list with all indices [0, size-1]
-                // It will fill in reverse order or standard order; standard is fine here.
-                for(size_t i=0; i<size; ++i){
-                    freeIndices_.push_back(i);
-                }
+            explicit ObjectPool(size_t size, PoolOptions options = {})
+                : slabSize_(size > 0 ? size : 1), options_(options)
+            {
+                if(!addSlab()) throw std::bad_alloc();
+            }
+
+            ~ObjectPool(){
+                for(const SlabBlock& block : slabs_) SlabMemory::release(block);
             }
 
+            ObjectPool(const ObjectPool&) = delete;
+            ObjectPool& operator=(const ObjectPool&) = delete;
+
             /**
              * @brief Allocates an object from the pool.
              * @tparam Args Variadic template arguments for T's constructor.
              * @param args Arguments to forward to the object constructor.
-             * @return T* Pointer to the initialized object, or nullptr if pool is full.
-             * @note Uses Perfect Forwarding to construct the object in-place (via assignment).
-             * @note Complexity: O(1)
+             * @return T* Pointer to the initialized object, or nullptr if pool is full (and not growable).
+             * @note Uses Perfect Forwarding and placement new: the object is freshly constructed, no stale fields survive.
+             * @note Complexity: O(1) (a growth step is O(slab size), and only happens on exhaustion).
              */
             template <typename... Args>
             T* allocate(Args&&... args){
-                if(freeIndices_.empty()){
-                    return nullptr; // Pool Exhausted
+                if(!freeList_) [[unlikely]] {
+                    if(!options_.growable || !addSlab()){
+                        return nullptr; // Pool Exhausted
+                    }
                 }
 
-                // LIFO Strategy: Take the last freed index (Hot Cache)
-                size_t idx = freeIndices_.back();
-                freeIndices_.pop_back();
-
-                T* obj = &pool_[idx];
+                // LIFO Strategy: Take the last freed slot (Hot Cache)
+                Slot* slot = freeList_;
+                freeList_ = slot->next;
+                ++inUse_;
 
-                // Re-initialize the object using assignment.
-                // Note: For complex objects, placement new might be preferred,
-                // but for POD (Plain Old Data) structs like Order, this is extremely fast.
-                *obj = T(std::forward<Args>(args)...);
-
-                return obj;
+                return ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
             }
 
             /**
              * @brief Returns an object to the pool.
-             * @param obj Pointer to the object to deallocate.
-             * @note Complexity: O(1) - Uses pointer arithmetic to calculate index.
+             * @param obj Pointer to the object to deallocate (must come from this pool).
+             * @note Complexity: O(1) - The slot is recovered from the object address, no search needed.
              */
             void deallocate(T* obj){
-                // Pointer Arithmetic: Calculate index based on memory address offset.
-                // This avoids searching the vector for the object.
-                // Formula: (Address of Obj - Address of Start)
-                size_t idx = obj - &pool_[0];
+                obj->~T();
+
+                Slot* slot = reinterpret_cast<Slot*>(obj);
+                slot->next = freeList_;
+                freeList_ = slot;
+                --inUse_;
+            }
+
+            /**
+             * @brief Total number of slots across all slabs.
+             */
+            size_t getCapacity() const { return capacity_; }
 
-                // Mark index as free
-                freeIndices_.push_back(idx);
+            /**
+             * @brief Number of slots currently available without growing.
+             */
+            size_t getFreeCount() const { return capacity_ - inUse_; }
+
+            /**
+             * @brief Number of slabs reserved so far.
+             */
+            size_t getSlabCount() const { return slabs_.size(); }
+
+            /**
+             * @brief Number of slabs pinned in RAM (PoolOptions::lockPages, when the system allowed it).
+             */
+            size_t getLockedSlabCount() const {
+                size_t locked = 0;
+                for(const SlabBlock& block : slabs_) locked += block.locked;
+                return locked;
             }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,159 @@
+/**
+ * @file OccupancyBitmap.h
+ * @brief Defines a hierarchical bitmap for finding the next non-empty price level in O(depth).
+ * @details One bit per tick says "this level has orders". On top of it, each summary layer keeps one
+ * bit per 64-bit word of the layer below ("this word is not zero"), until a single word remains.
+ * - 64 ticks     -> 1 layer
+ * - 4,096 ticks  -> 2 layers
+ * - 262,144 ticks -> 3 layers
+ *
+ * Searching for the next set bit climbs the layers until a word with a candidate appears, then descends
+ * with one std::countr_zero / std::countl_zero per layer. A sweep through a thin book therefore costs a
+ * handful of word scans no matter how many empty ticks separate two levels.
+ */
+#pragma once
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace LOB {
+
+    /**
+     * @class OccupancyBitmap
+     * @brief Fixed-size set of bit positions with fast next/previous set-bit search.
+     */
+    class OccupancyBitmap {
+        private:
+            // layers_[0] holds one bit per position; layers_[k] one bit per word of layers_[k-1].
+            std::vector<std::vector<uint64_t>> layers_;
+            size_t size_ = 0;
+
+            static size_t wordsFor(size_t bits) { return (bits + 63) / 64; }
+
+        public:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            OccupancyBitmap() = default;
+
+            /**
+             * @brief Construct a cleared bitmap.
+             * @param bits Number of addressable positions.
+             */
+            explicit OccupancyBitmap(size_t bits) { resize(bits); }
+
+            /**
+             * @brief Re-sizes the bitmap. All bits are cleared.
+             */
+            void resize(size_t bits){
+                size_ = bits;
+                layers_.clear();
+                size_t words = wordsFor(bits);
+                do {
+                    layers_.emplace_back(words > 0 ? words : 1, 0);
+                    words = wordsFor(words);
+                } while(layers_.back().size() > 1);
+            }
+
+            size_t size() const { return size_; }
+
+            /**
+             * @brief Is position 'pos' set?
+             */
+            bool test(size_t pos) const {
+                return (layers_[0][pos >> 6] >> (pos & 63)) & 1;
+            }
+
+            /**
+             * @brief Sets a position. Summary bits are only touched when a word goes from zero to non-zero.
+             * @note Complexity: O(1), at most one word per layer.
+             */
+            void set(size_t pos){
+                for(auto& layer : layers_){
+                    uint64_t& word = layer[pos >> 6];
+                    bool wasEmpty = (word == 0);
+                    word |= uint64_t{1} << (pos & 63);
+                    if(!wasEmpty) return;
+                    pos >>= 6;
+                }
+            }
+
+            /**
+             * @brief Clears a position. Summary bits are only touched when a word becomes zero.
+             * @note Complexity: O(1), at most one word per layer.
+             */
+            void reset(size_t pos){
+                for(auto& layer : layers_){
+                    uint64_t& word = layer[pos >> 6];
+                    word &= ~(uint64_t{1} << (pos & 63));
+                    if(word != 0) return;
+                    pos >>= 6;
+                }
+            }
+
+            /**
+             * @brief Smallest set position >= 'from'.
+             * @return The position, or npos if there is none.
+             */
+            size_t findNext(size_t from) const {
+                if(from >= size_) return npos;
+
+                // 1. Climb: look for a candidate in the current word, otherwise search the summary
+                //    layer for the next non-zero word strictly after this one.
+                size_t layer = 0;
+                size_t pos = from;
+                while(true){
+                    size_t w = pos >> 6;
+                    if(w >= layers_[layer].size()) return npos;
+
+                    uint64_t bits = layers_[layer][w] & (~uint64_t{0} << (pos & 63));
+                    if(bits){
+                        pos = (w << 6) + static_cast<size_t>(std::countr_zero(bits));
+                        break;
+                    }
+                    if(layer + 1 == layers_.size()) return npos;
+                    pos = w + 1;
+                    ++layer;
+                }
+
+                // 2. Descend: every summary bit guarantees a non-zero word below it.
+                while(layer > 0){
+                    --layer;
+                    pos = (pos << 6) + static_cast<size_t>(std::countr_zero(layers_[layer][pos]));
+                }
+                return pos;
+            }
+
+            /**
+             * @brief Largest set position <= 'from'.
+             * @return The position, or npos if there is none.
+             */
+            size_t findPrev(size_t from) const {
+                if(size_ == 0) return npos;
+                if(from >= size_) from = size_ - 1;
+
+                size_t layer = 0;
+                size_t pos = from;
+                while(true){
+                    size_t w = pos >> 6;
+                    size_t b = pos & 63;
+                    uint64_t mask = (b == 63) ? ~uint64_t{0} : ((uint64_t{1} << (b + 1)) - 1);
+
+                    uint64_t bits = layers_[layer][w] & mask;
+                    if(bits){
+                        pos = (w << 6) + 63 - static_cast<size_t>(std::countl_zero(bits));
+                        break;
+                    }
+                    if(w == 0 || layer + 1 == layers_.size()) return npos;
+                    pos = w - 1;
+                    ++layer;
+                }
+
+                while(layer > 0){
+                    --layer;
+                    pos = (pos << 6) + 63 - static_cast<size_t>(std::countl_zero(layers_[layer][pos]));
+                }
+                return pos;
+            }
+    };
+}
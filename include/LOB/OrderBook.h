@@ -3,76 +3,474 @@
  * @brief Defines the core matching engine logic.
  * @details The OrderBook maintains the state of all active Buy and Sell orders.
  * It uses a hybrid data structure approach:
- * 1. **Price Tress (std::map):** Keep orders sorted by Price.
- * - Bids: Sorted Descending (Highest price first).
- * - Asks: Sorted Ascending (Lowest price first).
- * 2. **Order Map (std::unordered_map):** Maps OrderId -> Order* for O(1) lookups/cancellations.
+ * 1. **Price Ladders:** Keep orders sorted by Price. The storage backend is a template parameter:
+ * - MapPriceLadder: std::map trees (Bids descending, Asks ascending). The default.
+ * - FlatPriceLadder: Contiguous tick-indexed arrays with cached best indices.
+ * 2. **Order Index:** Maps OrderId -> Order* for O(1) lookups/cancellations. A template parameter:
+ * - OrderIndex: Pre-sized open-addressing table, no allocation on insert or erase. The default.
+ * - UnorderedOrderIndex: std::unordered_map (the baseline).
  * 3. **Memory Pool:** All order objects are allocated from a pre-allocated slab to avoid heap fragmentation.
+ * 4. **Execution Sink:** Fills, cancels, rejects and level changes are reported as POD events to a
+ *    compile-time sink policy (QueueSink by default, NullSink for benchmarks). Nothing is printed on the hot path.
+ * 5. **Batch APIs:** addOrders()/applyBatch() consume spans of OrderRequests, prefetching ahead and only
+ *    entering the matching loop when an order actually crosses the spread.
+ * 6. **Order Types:** Market / IOC / FOK orders (OrderType) are matched straight against the opposite side
+ *    and never rest, so they never touch the order pool, the index or their own side's ladder.
+ * 7. **Depth Feed:** Level changes are marked dirty by the sink and published as coalesced BookUpdate deltas once
+ *    per instruction; publishSnapshot() emits the top of book on request. Consumers keep an L2 replica
+ *    (DepthBook.h) instead of reading the book from another thread.
+ * 8. **Top of Book:** The BBO (price, volume, order count, sequence) is seqlock-published after every instruction
+ *    that changed it (TopOfBook.h), so other threads can read it without locking or touching the book.
+ * 9. **Latency Tracking:** With NANOBOOK_LATENCY builds the book times entry -> first fill (and push -> entry /
+ *    push -> first fill for queued requests) into per-stage histograms (see Latency.h). Otherwise it costs nothing.
+ * 10. **Metrics:** With NANOBOOK_METRICS builds the book counts orders, fills, cancels and rejects and refreshes its
+ *    occupancy gauges once per instruction (see Metrics.h), for an off-thread exporter to sample.
+ * 11. **Locking:** A Lock policy guards every public instruction. NoLock (the default) compiles away for
+ *    single-threaded owners; SpinLock gives the ThreadSafeOrderBook monitor (see ThreadSafeOrderBook.h).
+ * 12. **Stops and Icebergs:** Stops park in a price-indexed StopBook and are only evaluated when a match moved the
+ *    last trade price. An iceberg rests as an ordinary Order showing one slice; its reserve sits in an IcebergTable
+ *    and is consulted only on levels that hold one (see ConditionalOrders.h). The fill loop of plain levels never
+ *    looks at either.
+ *
+ * All four policies are resolved at compile time: there are no virtual calls anywhere on the hot path.
  */
 #pragma once
-#include <map>
-#include <unordered_map>
+#include <span>
+#include <mutex>
+#include <limits>
 #include "LimitLevel.h"
 #include "ObjectPool.h"
+#include "PriceLadder.h"
+#include "BookConfig.h"
+#include "EventSink.h"
+#include "OrderIndex.h"
+#include "SpinLock.h"
+#include "OrderRequest.h"
+#include "Latency.h"
+#include "Metrics.h"
+#include "TopOfBook.h"
+#include "ConditionalOrders.h"
 
 namespace LOB {
 
-    class OrderBook {
+    /**
+     * @class BasicOrderBook
+     * @brief The matching engine, generic over its side storage, order index, event output and locking.
+     * @tparam Ladder Price Ladder backend (MapPriceLadder or FlatPriceLadder), instantiated once per side.
+     * @tparam Index Order Index policy (OrderIndex or UnorderedOrderIndex, see OrderIndex.h).
+     * @tparam Sink Execution Sink policy receiving Trade/Cancel/Reject/BookUpdate events (see EventSink.h).
+     * @tparam Lock Lock policy taken by every public instruction (NoLock or SpinLock, see SpinLock.h).
+     * @note The member functions are defined in OrderBook.cpp and explicitly instantiated there
+     * for every shipped policy combination.
+     */
+    template <template <Side> class Ladder = MapPriceLadder, typename Index = OrderIndex,
+              typename Sink = QueueSink, typename Lock = NoLock>
+    class BasicOrderBook {
         private:
             // Bids: Buyers want to pay LESS, but priority goes to those paying MORE.
-            // Comparator: std::greater (Descending: 101, 100, 99...)
-            std::map<Price, LimitLevel*, std::greater<Price>> bids_;
+            Ladder<Side::Buy> bids_;
 
             // Asks: Sellers want to receive MORE, but priority goes to those asking LESS.
-            // Comparator: std::less (Ascending: 100, 101, 102...)
-            std::map<Price, LimitLevel*, std::less<Price>> asks_;
+            Ladder<Side::Sell> asks_;
 
             // Fast Lookup Table: Enables O(1) cancellation by Order ID.
-            std::unordered_map<OrderId, Order*> orderMap_;
+            Index orderMap_;
 
-            // Memory Manager: Pre-allocated pool for 100,000 orders.
+            // Memory Manager: Pre-allocated pool of orders.
             ObjectPool<Order> orderPool_;
 
+            // Event Output: Receives every fill, cancel, reject and level update.
+            Sink sink_;
+
+            // Instrumentation: Per-stage latency histograms (empty unless NANOBOOK_LATENCY).
+            [[no_unique_address]] LatencyTracker latency_;
+
+            // Instrumentation: Counters and gauges for the metrics exporter (empty unless NANOBOOK_METRICS).
+            [[no_unique_address]] BookMetrics metrics_;
+
+            // Last BBO published (writer-side copy, compared to skip unchanged publications).
+            Quote lastQuote_;
+
+            // Shared with reader threads: the only book memory they ever touch.
+            TopOfBook topOfBook_;
+
+            // Price of the most recent trade (0 until the first one). Stops trigger against it.
+            Price lastTradePrice_ = 0;
+
+            // Parked stop orders, by trigger price.
+            StopBook stops_;
+
+            // Hidden reserves of the resting icebergs.
+            IcebergTable icebergs_;
+
+            // Set while triggered stops are being executed (their own trades must not re-enter the release loop).
+            bool releasingStops_ = false;
+
+            // Guards the public instructions (empty and free with NoLock). Mutable so printBook() can take it.
+            mutable Lock lock_;
+
         public:
             /**
              * @brief Construct a new Order Book.
-             * @note Initializes the ObjectPool with a fixed capacity.
+             * @param config Sizing of the price ladders, the order pool and the event sink (see BookConfig).
+             * @note Reserves and pre-touches the ObjectPool slab up front.
              */
-            OrderBook();
+            explicit BasicOrderBook(const BookConfig& config = {});
 
             /**
-             * @brief Destroy the Order Book and clean up limit levels.
+             * @brief Destroy the Order Book. The ladders clean up their own limit levels.
              */
-            ~OrderBook();
-            
+            ~BasicOrderBook() = default;
+
+            BasicOrderBook(const BasicOrderBook&) = delete;
+            BasicOrderBook& operator=(const BasicOrderBook&) = delete;
+
             /**
              * @brief Submits a new order to the book.
              * @details
              * 1. Attempts to match immediately (crosssing the spread).
              * 2. If remaining quantity > 0, posts to the book at the specific LimitLevel.
+             * Duplicate IDs, off-grid prices and pool exhaustion are reported as Reject events.
+             * Non-Limit order types skip step 2 entirely (see executeImmediate()).
              * @param id Unique Order ID.
-             * @param price Limit Price.
+             * @param price Limit Price (ignored for Market orders).
+             * @param qty Total Quantity.
+             * @param side Buy or Sell.
+             * @param type Limit (rests) or Market / ImmediateOrCancel / FillOrKill (never rests).
+             */
+            void addOrder(OrderId id, Price price, Quantity qty, Side side, OrderType type = OrderType::Limit);
+
+            /**
+             * @brief Submits a stop (or stop-limit) order, held off the book until a trade reaches 'stopPrice'.
+             * @details A buy stop is released once a trade prints at or above 'stopPrice', a sell stop at or below it.
+             * Released stops go through the book as 'type' orders within the instruction that triggered them,
+             * nearest trigger first, and their own trades can release further stops. A stop that is already reached
+             * when it arrives is executed at once. Until the first trade, every stop waits.
+             * Parked stops can be cancelled (cancelOrder()) but not amended.
+             * @param id Unique Order ID (checked against resting orders and parked stops).
+             * @param stopPrice Trigger price.
+             * @param price Limit price of the released order (ignored for Market).
              * @param qty Total Quantity.
              * @param side Buy or Sell.
+             * @param type Market (stop) or Limit (stop-limit); IOC / FOK are honoured as well.
              */
-            void addOrder(OrderId id, Price price, Quantity qty, Side side);
+            void addStopOrder(OrderId id, Price stopPrice, Price price, Quantity qty, Side side, OrderType type = OrderType::Market);
+
+            /**
+             * @brief Submits an iceberg: a limit order that only shows 'displayQty' at a time.
+             * @details
+             * 1. The full quantity first trades against the opposite side up to 'price'.
+             * 2. The remainder rests as an ordinary Order showing one slice; the rest is kept hidden.
+             * 3. Each time the displayed slice fills, the next one is shown in place (LimitLevel::replenish()) at the
+             *    back of the queue, without re-entering addOrder(): no new ID, pool slot or index entry.
+             * Hidden quantity is not part of the level volume, the depth feed or FOK estimates. A cancel reports the
+             * displayed plus hidden quantity; an amendment (modifyOrder()) resets the order to the new total and
+             * requeues it. A 'displayQty' of 0 or at least 'qty' makes it a plain limit order.
+             * @param id Unique Order ID.
+             * @param price Limit Price.
+             * @param qty Total Quantity (displayed + hidden).
+             * @param displayQty Size of each displayed slice.
+             * @param side Buy or Sell.
+             */
+            void addIcebergOrder(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side);
+
+            /**
+             * @brief Recovery only: re-posts an iceberg exactly as a snapshot saw it, without matching.
+             * @details Rests 'shown' (the slice on display, possibly part-filled) at the back of its level and hides
+             * 'reserve' behind it. Snapshot orders never cross, so nothing trades.
+             */
+            void restoreIceberg(OrderId id, Price price, Quantity shown, Quantity reserve, Quantity displayQty, Side side);
+
+            /**
+             * @brief Recovery only: restores the last trade price, which decides whether a new stop triggers on arrival.
+             */
+            void restoreLastTradePrice(Price price){
+                std::lock_guard<Lock> guard(lock_);
+                lastTradePrice_ = price;
+            }
 
             /**
              * @brief Cancels an existing order.
-             * @details 
-             * 1. Looks up Order* in orderMap_ (O(1)).
+             * @details
+             * 1. Extracts the Order* from orderMap_ (O(1), single probe).
              * 2. Unlinks from LimitLevel (O(1)).
              * 3. Returns Order to ObjectPool (O(1)).
+             * Emits a Cancel event, or a Reject (UnknownOrder) if the ID is neither resting nor a parked stop.
              * @param id The ID of the order to cancel.
              */
             void cancelOrder(OrderId id);
-            
+
+            /**
+             * @brief Amends a resting order without going through the allocator.
+             * @details Queue-priority rules (the usual exchange convention):
+             * 1. **Same price, smaller quantity:** Reduced in place. The order keeps its time priority.
+             * 2. **Same price, larger quantity:** Moved to the back of its level (the added size must queue).
+             * 3. **New price:** Unlinked from the old level and appended to the new one, reusing the same
+             *    Order object and index entry. Matches if the new price crosses the spread.
+             * 4. **Quantity 0:** Equivalent to cancelOrder().
+             * Emits a Modify event (then any trades), or a Reject (UnknownOrder / InvalidPrice) leaving the
+             * order untouched.
+             * @param id The ID of the resting order.
+             * @param newPrice Limit price after the amendment (may equal the current one).
+             * @param newQty Open quantity after the amendment.
+             */
+            void modifyOrder(OrderId id, Price newPrice, Quantity newQty);
+
+            /**
+             * @brief Submits a burst of new orders (feed replays, auction opens, gateway bursts).
+             * @details Equivalent to calling addOrder() for each entry in sequence - the events are reported in
+             * exactly the same order - but:
+             * 1. The index entry and (flat ladder) level slot of the order PREFETCH_DISTANCE ahead are prefetched.
+             * 2. The matching loop is only entered when the freshly posted order crosses the spread;
+             *    runs of passive orders never touch it.
+             * @param orders Requests to add. The 'type' field is ignored: every entry is treated as an Add
+             * (of its 'orderType').
+             */
+            void addOrders(std::span<const OrderRequest> orders);
+
+            /**
+             * @brief Applies a mixed sequence of Add / Cancel / Modify requests in order.
+             * @details Same prefetching and crossing rules as addOrders(). A Modify is applied through
+             * modifyOrder() (same priority rules, no pool traffic).
+             * @param requests Instructions to apply.
+             */
+            void applyBatch(std::span<const OrderRequest> requests);
+
+            /**
+             * @brief Publishes a depth snapshot: a BookSnapshot marker, then one BookUpdate per level (best first).
+             * @details For consumers that join late or lost deltas (QueueSink drops). Walks only 'depth' levels
+             * per side, on request - normal operation only ever publishes deltas.
+             * @param depth Levels per side to include (0 = all).
+             */
+            void publishSnapshot(size_t depth = 0);
+
             /**
              * @brief Prints the top levels of the book to the console (Visualization).
+             * @note Walks both ladders on the calling thread. Dashboards should render a DepthBook instead.
              */
             void printBook() const;
-        
+
+            /**
+             * @brief Highest bid level, or nullptr if there are no buyers.
+             */
+            const LimitLevel* getBestBid() const { return bids_.best(); }
+
+            /**
+             * @brief Lowest ask level, or nullptr if there are no sellers.
+             */
+            const LimitLevel* getBestAsk() const { return asks_.best(); }
+
+            /**
+             * @brief Volume resting on 'side' at its touch and up to 'ticks' ticks behind it.
+             * @note SIMD scan over the per-tick volumes with FlatPriceLadder, a level walk with MapPriceLadder.
+             */
+            Quantity getVolumeWithin(Side side, size_t ticks) const {
+                return (side == Side::Buy) ? bids_.volumeWithin(ticks) : asks_.volumeWithin(ticks);
+            }
+
+            /**
+             * @brief What an order of 'qty' on 'aggressor' would fill against the opposite side, up to 'limit'.
+             * @return Fillable quantity, levels needed, worst price and notional (vwap()). No order is touched.
+             */
+            FillEstimate estimateFill(Side aggressor, Quantity qty, Price limit) const {
+                return (aggressor == Side::Buy) ? asks_.estimateFill(qty, limit) : bids_.estimateFill(qty, limit);
+            }
+
+            /**
+             * @brief As above, for a market order (no price limit).
+             */
+            FillEstimate estimateFill(Side aggressor, Quantity qty) const {
+                return estimateFill(aggressor, qty, (aggressor == Side::Buy) ? std::numeric_limits<Price>::max() : 0);
+            }
+
+            /**
+             * @brief A resting order by ID, or nullptr (e.g. to read its remaining quantity).
+             */
+            const Order* findOrder(OrderId id) const { return orderMap_.find(id); }
+
+            /**
+             * @brief The seqlock-published BBO. Safe to read() from any thread while the book is running.
+             */
+            const TopOfBook& getTopOfBook() const { return topOfBook_; }
+
+            /**
+             * @brief Best bid/offer, read WITHOUT the lock (seqlock snapshot, see TopOfBook.h).
+             * @details Pollers never stall the threads submitting orders.
+             */
+            Quote getQuote() const { return topOfBook_.read(); }
+
+            /**
+             * @brief Visits every resting order: bids then asks, best level first, FIFO (time priority) within a level.
+             * @details Re-adding the visited orders in this sequence rebuilds an identical book (see Persistence.h).
+             */
+            template <typename F>
+            void forEachRestingOrder(F&& visit) const {
+                std::lock_guard<Lock> guard(lock_);
+                auto visitLevel = [&](const LimitLevel& level){
+                    for(const Order* order = level.getHead(); order; order = order->next) visit(*order);
+                };
+                bids_.forEachLevel(visitLevel);
+                asks_.forEachLevel(visitLevel);
+            }
+
+            /**
+             * @brief Visits every parked stop order (see StopBook::forEach() for the order).
+             */
+            template <typename F>
+            void forEachStopOrder(F&& visit) const {
+                std::lock_guard<Lock> guard(lock_);
+                stops_.forEach(visit);
+            }
+
+            /**
+             * @brief Number of orders currently resting in the book.
+             */
+            size_t getOrderCount() const { return orderMap_.size(); }
+
+            /**
+             * @brief Number of stop orders parked, waiting for their trigger.
+             */
+            size_t getStopOrderCount() const { return stops_.size(); }
+
+            /**
+             * @brief Hidden quantity of a resting iceberg (0 for any other ID, or once its last slice is shown).
+             */
+            Quantity getHiddenQuantity(OrderId id) const {
+                const Iceberg* iceberg = icebergs_.find(id);
+                return iceberg ? iceberg->reserve : 0;
+            }
+
+            /**
+             * @brief Display size and hidden reserve of a resting iceberg, or nullptr for any other ID.
+             */
+            const Iceberg* findIceberg(OrderId id) const { return icebergs_.find(id); }
+
+            /**
+             * @brief Price of the most recent trade (0 before the first one).
+             */
+            Price getLastTradePrice() const { return lastTradePrice_; }
+
+            /**
+             * @brief Read-only view of the order index (size / load factor).
+             */
+            const Index& getOrderIndex() const { return orderMap_; }
+
+            /**
+             * @brief Read-only view of the order pool (capacity / free slots).
+             */
+            const ObjectPool<Order>& getOrderPool() const { return orderPool_; }
+
+            /**
+             * @brief Access the execution sink (e.g. to drain a QueueSink from a consumer thread).
+             */
+            Sink& getSink() { return sink_; }
+
+            /**
+             * @brief Access the latency histograms (owned by the thread driving this book).
+             */
+            LatencyTracker& getLatency() { return latency_; }
+            const LatencyTracker& getLatency() const { return latency_; }
+
+            /**
+             * @brief Counters and gauges of this book (written by the driving thread, safe to read from any thread).
+             */
+            const BookMetrics& getMetrics() const { return metrics_; }
+
         private:
+            /**
+             * @brief How many requests ahead the batch APIs prefetch.
+             */
+            static constexpr size_t PREFETCH_DISTANCE = 4;
+
+            /**
+             * @brief cancelOrder() without taking the lock or ending the instruction (also used by amendOrder() and applyBatch()).
+             */
+            void removeOrder(OrderId id);
+
+            /**
+             * @brief modifyOrder() without taking the lock or ending the instruction (also used by applyBatch()).
+             */
+            void amendOrder(OrderId id, Price newPrice, Quantity newQty);
+
+            /**
+             * @brief Validates, allocates, indexes and posts an order WITHOUT matching it.
+             * @return true if the order is now resting (false if it was rejected).
+             */
+            bool restOrder(OrderId id, Price price, Quantity qty, Side side);
+
+            /**
+             * @brief Matches a Market / IOC / FOK order against the opposite side, without resting it.
+             * @details
+             * 1. FOK only: estimates the fill over the reachable levels first (ladder estimateFill()) and kills
+             *    the order (Cancel event, no trades) if they cannot fill it completely.
+             * 2. Consumes the opposite side from the best level while the price is within the limit.
+             * 3. Any unfilled remainder is reported as a Cancel.
+             * The incoming order never gets an Order slot or an index entry: its ID is not checked against
+             * resting orders, so gateways must keep IDs unique.
+             */
+            void executeImmediate(OrderId id, Price price, Quantity qty, Side side, OrderType type);
+
+            /**
+             * @brief Sweeps, then rests what is left of an iceberg (already validated), registering its reserve.
+             */
+            void placeIceberg(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side);
+
+            /**
+             * @brief A fully filled slice of a resting order: shows the next one if the order is an iceberg.
+             * @return false if 'order' has no reserve left (it must then be removed like any filled order).
+             */
+            bool replenishIceberg(Order* order, LimitLevel* level);
+
+            /**
+             * @brief Forgets the reserve of 'id' (if it is an iceberg) when it leaves 'level'.
+             * @return The hidden quantity it still had.
+             */
+            Quantity dropIceberg(OrderId id, LimitLevel& level);
+
+            /**
+             * @brief Releases stops if the trades since 'previousTrade' moved the last trade price across a trigger.
+             * @details The only stop-related code on the matching path: one compare when nothing traded,
+             * the two cached StopBook bounds otherwise.
+             */
+            void checkStops(Price previousTrade){
+                if(lastTradePrice_ != previousTrade && stops_.isTriggered(lastTradePrice_)) [[unlikely]] {
+                    releaseStops();
+                }
+            }
+
+            /**
+             * @brief Executes triggered stops until none is left (cascades included).
+             */
+            void releaseStops();
+
+            /**
+             * @brief Trades 'qty' against 'resting' (the opposite ladder) while levels are within 'limit'.
+             * @return The quantity left unfilled.
+             */
+            template <typename RestingLadder>
+            Quantity sweep(RestingLadder& resting, OrderId id, Price limit, Quantity qty, Side side);
+
+            /**
+             * @brief Closes one instruction: flushes the sink's coalesced level deltas, republishes the BBO if it changed
+             * and refreshes the metrics gauges.
+             */
+            void endInstruction();
+
+            /**
+             * @brief Does the top of book cross (Best Bid >= Best Ask)?
+             */
+            bool isCrossed() const;
+
+            /**
+             * @brief Prefetches the memory an upcoming request will touch.
+             */
+            void prefetchRequest(const OrderRequest& request) const;
+
+            /**
+             * @brief Can an order of this side rest at 'price'? (Tick grid and, for the flat ladder, window reach.)
+             */
+            bool isValidPrice(Price price, Side side) const;
+
             /**
              * @brief Helper to find or create a LimitLevel for a specific price.
              * @return Pointer to the LimitLevel.
@@ -82,7 +480,41 @@ namespace LOB {
             /**
              * @brief The Core Matching Algorithm.
              * @details Checks if Best Bid >= Best Ask. If so, executes trades until price no longer cross or liquidity is exhausted.
+             * @param aggressor Side of the order that just crossed (it is the only one that can).
+             */
+            void match(Side aggressor);
+
+            /**
+             * @brief match() for one orientation: the best 'takers' level trades against the best 'makers' levels.
+             * @details A tight fill kernel. Both levels are hoisted for as long as neither runs out. The next
+             * maker and the next maker level are prefetched while the current fill executes. The common case of a
+             * sweep (the maker fills completely, the taker continues) is laid out as the fall-through path.
+             */
+            template <typename TakerLadder, typename MakerLadder>
+            void cross(TakerLadder& takers, MakerLadder& makers, Side takerSide);
+
+            /**
+             * @brief The fill loop of cross() for one level pair, until either level runs out.
+             * @tparam Icebergs Compiled in only for maker levels holding an iceberg: a filled slice is then
+             * replenished instead of removed. Plain levels run the loop without that check.
              */
-            void match();
+            template <bool Icebergs>
+            void fillLevels(LimitLevel* takerLevel, LimitLevel* makerLevel, Price price, Side takerSide);
+
+            /**
+             * @brief Reports the new aggregate volume of a level to the sink (and the ladder's depth array).
+             */
+            void publishLevel(const LimitLevel& level, Side side);
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief The default engine: std::map price trees (unbounded price range), open-addressing index,
+     * events into a LockFreeQueue, no locking.
+     */
+    using OrderBook = BasicOrderBook<>;
+
+    /**
+     * @brief The flat-array engine: O(1) level lookup for instruments in a bounded tick band.
+     */
+    using FlatOrderBook = BasicOrderBook<FlatPriceLadder>;
+}
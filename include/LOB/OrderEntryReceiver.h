@@ -0,0 +1,184 @@
+/**
+ * @file OrderEntryReceiver.h
+ * @brief Socket front ends of the wire-protocol decoder (WireProtocol.h): a byte stream and a datagram batch.
+ * @details Both keep their receive memory for their whole life, so the steady state allocates nothing, and both
+ * hand whole runs of messages to decodeOrderEntry(), which claims and publishes their queue slots in bulk.
+ * 1. **OrderEntryStream (TCP):** recv() appends to a fixed buffer; complete messages are decoded in place and a
+ *    message cut by the segment boundary waits, moved to the front, for the rest of its bytes.
+ * 2. **DatagramReceiver (UDP):** recvmmsg() fills a batch of preallocated datagram buffers with one system call.
+ *    Each datagram carries whole messages. If the queue fills mid-batch the receiver keeps its place and issues
+ *    no new receive until the batch is drained, so nothing that was read is lost.
+ * Any other byte source (an io_uring completion, a kernel-bypass ring) can feed decodeOrderEntry() directly:
+ * the decoder only sees a span of bytes.
+ */
+#pragma once
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "WireProtocol.h"
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
+
+namespace LOB {
+
+    /**
+     * @class OrderEntryStream
+     * @brief Reassembles one byte-stream session into messages.
+     */
+    class OrderEntryStream {
+        private:
+            std::vector<unsigned char> buffer_;
+            size_t begin_ = 0;    // first unconsumed byte
+            size_t end_ = 0;      // one past the last received byte
+
+            uint64_t decoded_ = 0;
+            uint64_t invalid_ = 0;
+            bool broken_ = false;
+
+        public:
+            /**
+             * @param capacity Receive buffer bytes (at least one maximal message).
+             */
+            explicit OrderEntryStream(size_t capacity = 1 << 16)
+                : buffer_(capacity < Wire::MAX_MESSAGE_SIZE ? Wire::MAX_MESSAGE_SIZE : capacity) {}
+
+            /**
+             * @brief Free space to receive into, after moving any leftover partial message to the front.
+             */
+            std::span<unsigned char> writable(){
+                if(begin_ > 0){
+                    std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+                    end_ -= begin_;
+                    begin_ = 0;
+                }
+                return std::span<unsigned char>(buffer_.data() + end_, buffer_.size() - end_);
+            }
+
+            /**
+             * @brief Records that 'bytes' bytes were written into the last writable() span.
+             */
+            void received(size_t bytes){ end_ += bytes; }
+
+            /**
+             * @brief Decodes every complete buffered message into 'queue' (Producer side).
+             */
+            template <typename Queue>
+            DecodeResult decode(Queue& queue){
+                DecodeResult result = decodeOrderEntry(std::span<const unsigned char>(buffer_.data() + begin_, end_ - begin_), queue);
+                begin_ += result.consumed;
+                decoded_ += result.decoded;
+                invalid_ += result.invalid;
+                broken_ = broken_ || result.framingError;
+                return result;
+            }
+
+#if defined(__linux__)
+            /**
+             * @brief One non-blocking recv() from 'fd', then decode().
+             * @return Requests published; 0 if nothing arrived or the buffer is still full (queue back-pressure).
+             * @note After a framing error or a closed peer (isBroken()), the session should be dropped.
+             */
+            template <typename Queue>
+            size_t receive(int fd, Queue& queue){
+                std::span<unsigned char> space = writable();
+                if(!space.empty()){
+                    ssize_t n = recv(fd, space.data(), space.size(), MSG_DONTWAIT);
+                    if(n > 0) received(static_cast<size_t>(n));
+                    else if(n == 0) broken_ = true;
+                }
+                return decode(queue).decoded;
+            }
+#endif
+
+            size_t getBuffered() const { return end_ - begin_; }
+            uint64_t getDecodedCount() const { return decoded_; }
+            uint64_t getInvalidCount() const { return invalid_; }
+            bool isBroken() const { return broken_; }
+    };
+
+#if defined(__linux__)
+    /**
+     * @class DatagramReceiver
+     * @brief Drains a datagram socket in recvmmsg() batches.
+     */
+    class DatagramReceiver {
+        private:
+            size_t datagramSize_;
+            std::vector<unsigned char> storage_;
+            std::vector<iovec> iov_;
+            std::vector<mmsghdr> headers_;
+
+            // Batch in progress: datagrams [next_, count_) are still to decode, 'offset_' bytes into 'next_'.
+            size_t count_ = 0;
+            size_t next_ = 0;
+            size_t offset_ = 0;
+
+            uint64_t datagrams_ = 0;
+            uint64_t decoded_ = 0;
+            uint64_t invalid_ = 0;
+            uint64_t malformed_ = 0;
+
+        public:
+            /**
+             * @param batch Datagrams per recvmmsg() call.
+             * @param datagramSize Bytes per datagram buffer (longer datagrams are truncated and counted as malformed).
+             */
+            explicit DatagramReceiver(size_t batch = 32, size_t datagramSize = 2048)
+                : datagramSize_(datagramSize), storage_(batch * datagramSize), iov_(batch), headers_(batch)
+            {
+                for(size_t i = 0; i < batch; ++i){
+                    iov_[i].iov_base = storage_.data() + i * datagramSize_;
+                    iov_[i].iov_len = datagramSize_;
+                    headers_[i] = mmsghdr{};
+                    headers_[i].msg_hdr.msg_iov = &iov_[i];
+                    headers_[i].msg_hdr.msg_iovlen = 1;
+                }
+            }
+
+            /**
+             * @brief Decodes the rest of the current batch into 'queue', receiving a new one (non-blocking) if it is done.
+             * @return Requests published by this call.
+             */
+            template <typename Queue>
+            size_t poll(int fd, Queue& queue){
+                if(next_ == count_){
+                    int n = recvmmsg(fd, headers_.data(), static_cast<unsigned>(headers_.size()), MSG_DONTWAIT, nullptr);
+                    if(n <= 0) return 0;
+                    count_ = static_cast<size_t>(n);
+                    next_ = 0;
+                    offset_ = 0;
+                    datagrams_ += count_;
+                }
+
+                size_t published = 0;
+                for(; next_ < count_; ++next_, offset_ = 0){
+                    const mmsghdr& header = headers_[next_];
+                    const unsigned char* datagram = storage_.data() + next_ * datagramSize_;
+                    std::span<const unsigned char> bytes(datagram + offset_, header.msg_len - offset_);
+
+                    DecodeResult result = decodeOrderEntry(bytes, queue);
+                    published += result.decoded;
+                    decoded_ += result.decoded;
+                    invalid_ += result.invalid;
+                    if(result.queueFull){
+                        offset_ += result.consumed;    // resume here on the next poll
+                        return published;
+                    }
+                    // A datagram must hold whole messages: any leftover is garbage or a truncated tail.
+                    if(result.consumed < bytes.size() || (header.msg_hdr.msg_flags & MSG_TRUNC)) ++malformed_;
+                }
+                return published;
+            }
+
+            uint64_t getDatagramCount() const { return datagrams_; }
+            uint64_t getDecodedCount() const { return decoded_; }
+            uint64_t getInvalidCount() const { return invalid_; }
+            uint64_t getMalformedCount() const { return malformed_; }
+    };
+#endif
+}
@@ -0,0 +1,295 @@
+/**
+ * @file OrderIndex.h
+ * @brief Defines the allocation-free OrderId -> Order* lookup table used for cancels and fills.
+ * @details std::unordered_map allocates a node on every insert and frees it on every erase, and each lookup
+ * chases a bucket pointer. OrderIndex replaces it with a flat, pre-sized array of {key, value} entries:
+ * 1. **Hashed Mode:** Open addressing with linear probing. Keys are spread with Fibonacci hashing and
+ *    deletions use backward shifting, so the table never accumulates tombstones.
+ * 2. **Dense Mode:** For venues that assign monotonically increasing IDs. The entry is found directly at
+ *    (id & mask), no hashing or probing. If a very old order still occupies the slot a new ID maps to,
+ *    the new ID spills into the hashed table, so correctness never depends on the ID pattern.
+ *
+ * The table only grows (rehash) if it passes 7/8 load, which a correctly sized book never reaches.
+ *
+ * UnorderedOrderIndex wraps std::unordered_map behind the same interface. It is the Index policy to compare
+ * against (or to use when the live order count cannot be bounded up front).
+ */
+#pragma once
+#include <bit>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "Order.h"
+#include "Prefetch.h"
+
+namespace LOB {
+
+    /**
+     * @enum OrderIndexMode
+     * @brief Selects how OrderIndex maps an ID to its entry.
+     */
+    enum class OrderIndexMode : uint8_t { Hashed, Dense };
+
+    /**
+     * @class OrderIndex
+     * @brief Open-addressing hash table from OrderId to the Order's pool slot.
+     */
+    class OrderIndex {
+        private:
+            struct Entry {
+                OrderId key;
+                Order* value; // nullptr marks an empty entry
+            };
+
+            // --- Hashed Table (Linear Probing) ---
+            std::vector<Entry> table_;
+            size_t mask_ = 0;
+            unsigned shift_ = 0;
+            size_t hashedCount_ = 0;
+
+            // --- Dense Table (Direct-Mapped) ---
+            std::vector<Entry> direct_;
+            size_t directMask_ = 0;
+            size_t directCount_ = 0;
+
+            OrderIndexMode mode_;
+
+            static size_t roundUpPow2(size_t n){
+                size_t p = 8;
+                while(p < n) p <<= 1;
+                return p;
+            }
+
+            /**
+             * @brief Fibonacci hashing: multiply by 2^64 / phi, keep the top bits.
+             * @details Sequential IDs land far apart, so linear probe runs stay short.
+             */
+            size_t home(OrderId key) const {
+                return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+            }
+
+            void initTable(size_t slots){
+                table_.assign(slots, Entry{0, nullptr});
+                mask_ = slots - 1;
+                shift_ = 64 - static_cast<unsigned>(std::countr_zero(slots));
+                hashedCount_ = 0;
+            }
+
+            /**
+             * @brief Doubles the hashed table (allocates; only reached if the book was under-sized).
+             */
+            void grow(){
+                std::vector<Entry> old = std::move(table_);
+                initTable(old.size() * 2);
+                for(const Entry& e : old){
+                    if(e.value) hashedInsert(e.key, e.value);
+                }
+            }
+
+            bool hashedInsert(OrderId key, Order* value){
+                if((hashedCount_ + 1) * 8 > table_.size() * 7) [[unlikely]] {
+                    grow();
+                }
+
+                for(size_t i = home(key);; i = (i + 1) & mask_){
+                    Entry& e = table_[i];
+                    if(!e.value){
+                        e = Entry{key, value};
+                        ++hashedCount_;
+                        return true;
+                    }
+                    if(e.key == key) return false;
+                }
+            }
+
+            size_t hashedFind(OrderId key) const {
+                for(size_t i = home(key);; i = (i + 1) & mask_){
+                    const Entry& e = table_[i];
+                    if(!e.value) return static_cast<size_t>(-1);
+                    if(e.key == key) return i;
+                }
+            }
+
+            /**
+             * @brief Removes table_[i] and closes the gap (Backward Shift Deletion).
+             * @details Every following entry of the probe run moves back one step unless its home slot lies
+             * cyclically in (i, j], in which case moving it would make it unreachable.
+             */
+            void hashedEraseAt(size_t i){
+                size_t j = i;
+                while(true){
+                    j = (j + 1) & mask_;
+                    if(!table_[j].value) break;
+
+                    size_t k = home(table_[j].key);
+                    bool reachable = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+                    if(reachable) continue;
+
+                    table_[i] = table_[j];
+                    i = j;
+                }
+                table_[i].value = nullptr;
+                --hashedCount_;
+            }
+
+        public:
+            /**
+             * @brief Construct a pre-sized index.
+             * @param capacity Expected number of live orders. The tables are rounded up to a power of two of
+             * at least 2x this size (hashed) or exactly the live-ID window (dense).
+             * @param mode Hashed or Dense.
+             */
+            explicit OrderIndex(size_t capacity, OrderIndexMode mode = OrderIndexMode::Hashed) : mode_(mode) {
+                if(mode_ == OrderIndexMode::Dense){
+                    direct_.assign(roundUpPow2(capacity), Entry{0, nullptr});
+                    directMask_ = direct_.size() - 1;
+                    // Overflow table for IDs that collide with a long-lived order.
+                    initTable(roundUpPow2(capacity / 8));
+                }
+                else{
+                    initTable(roundUpPow2(capacity * 2));
+                }
+            }
+
+            /**
+             * @brief Adds a mapping.
+             * @return false if the ID is already present (nothing is modified).
+             * @note Complexity: O(1) expected, no allocation.
+             */
+            bool insert(OrderId key, Order* value){
+                if(mode_ == OrderIndexMode::Dense){
+                    Entry& e = direct_[key & directMask_];
+                    if(!e.value){
+                        if(hashedCount_ > 0 && hashedFind(key) != static_cast<size_t>(-1)) return false;
+                        e = Entry{key, value};
+                        ++directCount_;
+                        return true;
+                    }
+                    if(e.key == key) return false;
+                    // Slot held by an older, still-resting order: spill over.
+                }
+                return hashedInsert(key, value);
+            }
+
+            /**
+             * @brief Looks up an ID.
+             * @return The Order*, or nullptr if the ID is not resting.
+             */
+            Order* find(OrderId key) const {
+                if(mode_ == OrderIndexMode::Dense){
+                    const Entry& e = direct_[key & directMask_];
+                    if(e.value && e.key == key) return e.value;
+                    if(hashedCount_ == 0) return nullptr;
+                }
+                size_t i = hashedFind(key);
+                return i == static_cast<size_t>(-1) ? nullptr : table_[i].value;
+            }
+
+            /**
+             * @brief Removes an ID and returns what it mapped to (single probe for cancels).
+             * @return The Order*, or nullptr if the ID was not present.
+             */
+            Order* extract(OrderId key){
+                if(mode_ == OrderIndexMode::Dense){
+                    Entry& e = direct_[key & directMask_];
+                    if(e.value && e.key == key){
+                        Order* value = e.value;
+                        e.value = nullptr;
+                        --directCount_;
+                        return value;
+                    }
+                    if(hashedCount_ == 0) return nullptr;
+                }
+                size_t i = hashedFind(key);
+                if(i == static_cast<size_t>(-1)) return nullptr;
+                Order* value = table_[i].value;
+                hashedEraseAt(i);
+                return value;
+            }
+
+            /**
+             * @brief Starts loading the entry an upcoming insert/find/extract of 'key' will probe first.
+             * @details Used by the batch APIs to overlap the index cache miss of request i+k with the work of request i.
+             */
+            void prefetch(OrderId key) const {
+                if(mode_ == OrderIndexMode::Dense) prefetchForWrite(&direct_[key & directMask_]);
+                else prefetchForWrite(&table_[home(key)]);
+            }
+
+            /**
+             * @brief Removes an ID.
+             * @return true if it was present.
+             */
+            bool erase(OrderId key) { return extract(key) != nullptr; }
+
+            /**
+             * @brief Number of live mappings.
+             */
+            size_t size() const { return hashedCount_ + directCount_; }
+
+            /**
+             * @brief Total number of entries across both tables.
+             */
+            size_t capacity() const { return table_.size() + direct_.size(); }
+
+            /**
+             * @brief Fill ratio of the table that is actually probed (the hashed one, or the direct one in Dense mode).
+             */
+            double loadFactor() const {
+                if(mode_ == OrderIndexMode::Dense) return static_cast<double>(directCount_) / direct_.size();
+                return static_cast<double>(hashedCount_) / table_.size();
+            }
+
+            OrderIndexMode getMode() const { return mode_; }
+    };
+
+    /**
+     * @class UnorderedOrderIndex
+     * @brief Node-based std::unordered_map Index policy with the OrderIndex interface.
+     * @details Allocates on every insert and frees on every erase. Kept as the baseline for benchmarks.
+     */
+    class UnorderedOrderIndex {
+        private:
+            std::unordered_map<OrderId, Order*> map_;
+
+        public:
+            /**
+             * @param capacity Buckets reserved up front.
+             * @param mode Ignored (there is no dense layout).
+             */
+            explicit UnorderedOrderIndex(size_t capacity, OrderIndexMode = OrderIndexMode::Hashed) {
+                map_.reserve(capacity);
+            }
+
+            bool insert(OrderId key, Order* value) { return map_.emplace(key, value).second; }
+
+            Order* find(OrderId key) const {
+                auto it = map_.find(key);
+                return it == map_.end() ? nullptr : it->second;
+            }
+
+            Order* extract(OrderId key){
+                auto it = map_.find(key);
+                if(it == map_.end()) return nullptr;
+                Order* value = it->second;
+                map_.erase(it);
+                return value;
+            }
+
+            /**
+             * @brief No-op: the bucket a key lands in is not known without hashing it and chasing a pointer.
+             */
+            void prefetch(OrderId) const {}
+
+            bool erase(OrderId key) { return map_.erase(key) != 0; }
+
+            size_t size() const { return map_.size(); }
+
+            size_t capacity() const { return map_.bucket_count(); }
+
+            double loadFactor() const { return map_.load_factor(); }
+
+            OrderIndexMode getMode() const { return OrderIndexMode::Hashed; }
+    };
+}
@@ -0,0 +1,87 @@
+/**
+ * @file OrderRequest.h
+ * @brief Defines the fixed-size instruction message consumed by the matching engine.
+ * @details An OrderRequest is what travels through the LockFreeQueue from the gateway (or network) thread
+ * to the engine thread, and what the batch APIs of the OrderBook consume. It is a POD so it can be copied
+ * into ring buffer slots or decoded straight from a receive buffer.
+ * 'orderType' selects resting (Limit) or immediate (Market / IOC / FOK) execution for Add requests.
+ * The symbol field routes the request to its book in a multi-instrument Engine (Engine.h); a single
+ * OrderBook ignores it. It lives in what used to be tail padding, so the struct is still 32 bytes.
+ * With NANOBOOK_LATENCY builds a push timestamp is appended (40 bytes); see Latency.h.
+ */
+#pragma once
+#include <cstdint>
+#include "Order.h"
+#include "Latency.h"
+
+namespace LOB {
+
+    /** Instrument identifier assigned by the venue (dense or sparse). */
+    using SymbolId = uint32_t;
+
+    /**
+     * @enum RequestType
+     * @brief What the engine should do with the request.
+     */
+    enum class RequestType : uint8_t {
+        Add,    /**< New order (id, price, qty, side, orderType). */
+        Cancel, /**< Remove resting order 'id'. Other fields are ignored. */
+        Modify  /**< Amend resting order 'id' to (price, qty). */
+    };
+
+    /**
+     * @enum OrderType
+     * @brief Execution instruction of a new order.
+     * @details Only Limit orders ever rest. The others match directly against the opposite side and
+     * never take an Order slot or an index entry; whatever does not trade is reported as a Cancel.
+     */
+    enum class OrderType : uint8_t {
+        Limit,              /**< Trade up to 'price', rest the remainder (good till cancelled). */
+        Market,             /**< Trade at any price, discard the remainder. 'price' is ignored. */
+        ImmediateOrCancel,  /**< Trade up to 'price', discard the remainder. */
+        FillOrKill          /**< Trade the full quantity up to 'price' at once, or nothing at all. */
+    };
+
+    /**
+     * @struct OrderRequest
+     * @brief A single instruction for the book.
+     * @note In a real system, this would be decoded from a specialized network packet (e.g., UDP/TCP payload).
+     */
+    struct OrderRequest {
+        OrderId id;
+        Price price;
+        Quantity qty;
+        Side side;
+        RequestType type;
+        OrderType orderType = OrderType::Limit;
+        SymbolId symbol = 0;
+#if NANOBOOK_LATENCY
+        Timestamp sentAt = 0; /**< LatencyClock reading taken just before the request was pushed. */
+#endif
+    };
+
+    static_assert(sizeof(OrderRequest) == (LATENCY_ENABLED ? 40 : 32), "OrderRequest must stay compact (32 bytes, 40 with latency timestamps)");
+
+    /**
+     * @brief Stamps the push time (call right before publishing the request). No-op without NANOBOOK_LATENCY.
+     */
+    inline void stampSent(OrderRequest& request){
+#if NANOBOOK_LATENCY
+        request.sentAt = LatencyClock::now();
+#else
+        (void)request;
+#endif
+    }
+
+    /**
+     * @brief The push timestamp, or 0 if none was recorded.
+     */
+    inline Timestamp getSentAt(const OrderRequest& request){
+#if NANOBOOK_LATENCY
+        return request.sentAt;
+#else
+        (void)request;
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,353 @@
+/**
+ * @file Persistence.h
+ * @brief Command journal + book snapshots for warm restarts.
+ * @details A restarted process rebuilds its book from two files instead of replaying the whole day:
+ * 1. **Journal:** Every command handed to the book is appended (fixed 56-byte JournalRecords, numbered by a
+ *    sequence) by a JournalWriter thread. The matcher only pushes into a LockFreeQueue: it never waits on I/O.
+ *    Stop and iceberg submissions have their own append calls, which also store the trigger / display size.
+ * 2. **Snapshot:** captureSnapshot() copies every resting order, level by level in FIFO order (an iceberg with its
+ *    hidden reserve), every parked stop and the last trade price, together with the sequence of the last command
+ *    applied. writeSnapshot() then stores it (off the matching thread if desired), atomically replacing the
+ *    previous one.
+ * 3. **Recovery:** recover() maps the snapshot, re-posts its orders (same prices, same queue order), re-parks its
+ *    stops and replays only the journal records after the snapshot's sequence.
+ *
+ * Writes reach the OS page cache after every drained burst (durable across process crashes); close() also
+ * syncs the file to disk. A record torn by a crash mid-write is dropped when the journal is reopened.
+ * A failed journal write (e.g. a full disk) is never silent: the writer stops, flags itself failed and counts
+ * every record it could not store (hasFailed() / getLostCount()). Snapshots are synced before they replace
+ * the previous one.
+ */
+#pragma once
+#include <span>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include "Order.h"
+#include "OrderRequest.h"
+#include "LockFreeQueue.h"
+#include "ReplayFormat.h"
+#include "ConditionalOrders.h"
+
+namespace LOB {
+
+    /**
+     * @enum PersistedKind
+     * @brief What a journal record or a snapshot entry holds.
+     */
+    enum class PersistedKind : uint8_t {
+        Plain,      /**< Journal: an OrderRequest. Snapshot: a resting order. */
+        Stop,       /**< A stop order: 'stopPrice' triggers it, 'price' / 'orderType' describe the released order. */
+        Iceberg     /**< An iceberg: 'displayQty' per slice (snapshot: plus the hidden 'reserve'). */
+    };
+
+    /**
+     * @struct JournalRecord
+     * @brief One journaled command (56 bytes, host byte order).
+     */
+    struct JournalRecord {
+        uint64_t sequence;
+        OrderId id;
+        Price price;
+        Quantity qty;
+        SymbolId symbol;
+        Side side;
+        RequestType type;
+        OrderType orderType;
+        PersistedKind kind = PersistedKind::Plain;
+        Price stopPrice = 0;        /**< Stop: trigger price. */
+        Quantity displayQty = 0;    /**< Iceberg: slice size. */
+    };
+
+    static_assert(sizeof(JournalRecord) == 56, "JournalRecord is an on-disk format");
+
+    /**
+     * @struct JournalFileHeader
+     * @brief Leading 16 bytes of a journal file. Records follow until the end of the file.
+     */
+    struct JournalFileHeader {
+        char magic[8] = {'N', 'A', 'N', 'O', 'J', 'R', 'N', '\0'};
+        uint32_t version = 2;
+        uint32_t recordSize = sizeof(JournalRecord);
+    };
+
+    static_assert(sizeof(JournalFileHeader) == 16, "JournalFileHeader is an on-disk format");
+
+    /**
+     * @struct SnapshotOrder
+     * @brief One resting order or parked stop in a snapshot (56 bytes).
+     */
+    struct SnapshotOrder {
+        OrderId id;
+        Price price;
+        Quantity quantity;          /**< Resting: open (displayed) quantity. Stop: quantity released. */
+        Side side;
+        PersistedKind kind = PersistedKind::Plain;
+        OrderType orderType = OrderType::Limit;
+        uint8_t reserved[5] = {};
+        Quantity reserve = 0;       /**< Iceberg: hidden quantity. */
+        Quantity displayQty = 0;    /**< Iceberg: slice size. */
+        Price stopPrice = 0;        /**< Stop: trigger price. */
+    };
+
+    static_assert(sizeof(SnapshotOrder) == 56, "SnapshotOrder is an on-disk format");
+
+    /**
+     * @struct SnapshotFileHeader
+     * @brief Leading 40 bytes of a snapshot file, followed by orderCount SnapshotOrders.
+     */
+    struct SnapshotFileHeader {
+        char magic[8] = {'N', 'A', 'N', 'O', 'S', 'N', 'P', '\0'};
+        uint32_t version = 2;
+        uint32_t recordSize = sizeof(SnapshotOrder);
+        uint64_t lastSequence = 0;   /**< Journal sequence of the last command reflected in the snapshot. */
+        uint64_t orderCount = 0;
+        Price lastTradePrice = 0;    /**< Decides whether a stop submitted after the restart triggers at once. */
+    };
+
+    static_assert(sizeof(SnapshotFileHeader) == 40, "SnapshotFileHeader is an on-disk format");
+
+    /**
+     * @struct Snapshot
+     * @brief In-memory copy of a book: resting orders, bids then asks, best level first, FIFO within a level,
+     * then the parked stops in trigger order.
+     */
+    struct Snapshot {
+        uint64_t lastSequence = 0;
+        Price lastTradePrice = 0;
+        std::vector<SnapshotOrder> orders;
+    };
+
+    /**
+     * @class JournalWriter
+     * @brief Appends commands to a journal file from a dedicated thread.
+     * @details append() is called by the matching thread only (single producer); the writer thread is the
+     * consumer. If the writer falls behind and the queue fills up, append() yields until there is room and
+     * counts a stall - a journal must not lose commands. If the file cannot take them (short write, failed
+     * flush or sync), the failure is sticky: later records are counted as lost rather than written after a gap.
+     */
+    class JournalWriter {
+        private:
+            LockFreeQueue<JournalRecord> queue_;
+            std::FILE* file_ = nullptr;
+            std::thread thread_;
+            std::atomic<bool> running_{false};
+            std::atomic<uint64_t> written_{0};
+            std::atomic<uint64_t> lost_{0};
+            std::atomic<bool> failed_{false};
+            uint64_t sequence_ = 0;
+            uint64_t stalls_ = 0;
+
+            void run();
+            uint64_t push(JournalRecord& record);
+
+        public:
+            /**
+             * @param queueCapacity Commands the matcher may run ahead of the disk.
+             */
+            explicit JournalWriter(size_t queueCapacity = 1 << 16);
+            ~JournalWriter();
+
+            JournalWriter(const JournalWriter&) = delete;
+            JournalWriter& operator=(const JournalWriter&) = delete;
+
+            /**
+             * @brief Opens (or creates) the journal for appending and starts the writer thread.
+             * @details An existing journal continues at its last sequence; a torn trailing record is cut off.
+             * @return false if the file cannot be opened or is not a journal.
+             */
+            bool open(const std::string& path);
+
+            /**
+             * @brief Drains the queue, syncs the file and stops the writer thread.
+             */
+            void close();
+
+            /**
+             * @brief Journals one command. Matching thread only.
+             * @return The sequence number assigned to it.
+             */
+            uint64_t append(const OrderRequest& request);
+
+            /**
+             * @brief Journals an addStopOrder() call (same arguments). Matching thread only.
+             * @return The sequence number assigned to it.
+             */
+            uint64_t appendStop(OrderId id, Price stopPrice, Price price, Quantity qty, Side side,
+                                OrderType type = OrderType::Market, SymbolId symbol = 0);
+
+            /**
+             * @brief Journals an addIcebergOrder() call (same arguments). Matching thread only.
+             * @return The sequence number assigned to it.
+             */
+            uint64_t appendIceberg(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side, SymbolId symbol = 0);
+
+            /**
+             * @brief Sequence of the last command appended (what a snapshot taken now reflects).
+             */
+            uint64_t getSequence() const { return sequence_; }
+
+            /**
+             * @brief Records handed to the OS so far (any thread).
+             */
+            uint64_t getWrittenCount() const { return written_.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Times append() had to wait for the writer thread (matching thread).
+             */
+            uint64_t getStallCount() const { return stalls_; }
+
+            /**
+             * @brief Did a write, flush or sync of the journal fail since open()? Sticky (any thread).
+             * @details Once set, the journal no longer holds every command: take a snapshot and reopen a new journal.
+             */
+            bool hasFailed() const { return failed_.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Appended records that never reached the file (any thread).
+             */
+            uint64_t getLostCount() const { return lost_.load(std::memory_order_acquire); }
+    };
+
+    /**
+     * @brief The records of a mapped journal file (empty if the header is invalid; a torn tail is ignored).
+     */
+    std::span<const JournalRecord> journalRecords(const MappedFile& file);
+
+    /**
+     * @brief Parses a mapped snapshot file.
+     * @param header Receives the file header.
+     * @param orders Receives the orders (in the file, no copy).
+     * @return false if the file is not a complete, valid snapshot.
+     */
+    bool readSnapshot(const MappedFile& file, SnapshotFileHeader& header, std::span<const SnapshotOrder>& orders);
+
+    /**
+     * @brief Writes 'snapshot' to 'path' (via a temporary file + rename, so a crash never leaves half a snapshot).
+     * @details The temporary file is written, flushed and fsync'ed before the rename, and the directory is
+     * synced after it, so the name never points at data that is not on disk.
+     * @return false on any I/O error (the previous snapshot is then left in place).
+     */
+    bool writeSnapshot(const std::string& path, const Snapshot& snapshot);
+
+    /**
+     * @brief Copies the resting orders and parked stops of 'book' (matching thread: no I/O, one pass over the levels).
+     * @param lastSequence Journal sequence of the last command applied to the book.
+     */
+    template <typename Book>
+    Snapshot captureSnapshot(const Book& book, uint64_t lastSequence){
+        Snapshot snapshot;
+        snapshot.lastSequence = lastSequence;
+        snapshot.lastTradePrice = book.getLastTradePrice();
+        snapshot.orders.reserve(book.getOrderCount() + book.getStopOrderCount());
+        book.forEachRestingOrder([&](const Order& order){
+            SnapshotOrder entry{order.id, order.price, order.quantity, order.side};
+            if(const Iceberg* iceberg = book.findIceberg(order.id)){
+                entry.kind = PersistedKind::Iceberg;
+                entry.reserve = iceberg->reserve;
+                entry.displayQty = iceberg->displayQty;
+            }
+            snapshot.orders.push_back(entry);
+        });
+        book.forEachStopOrder([&](const StopOrder& stop){
+            SnapshotOrder entry{stop.id, stop.price, stop.qty, stop.side, PersistedKind::Stop, stop.type};
+            entry.stopPrice = stop.stopPrice;
+            snapshot.orders.push_back(entry);
+        });
+        return snapshot;
+    }
+
+    /**
+     * @struct RecoveryStats
+     * @brief What recover() found and applied.
+     */
+    struct RecoveryStats {
+        bool snapshotLoaded = false;
+        uint64_t snapshotSequence = 0;   /**< Sequence the snapshot reflected (0 without snapshot). */
+        uint64_t restoredOrders = 0;     /**< Orders re-posted from the snapshot. */
+        uint64_t replayedCommands = 0;   /**< Journal records applied after the snapshot. */
+        uint64_t lastSequence = 0;       /**< Sequence of the last command now reflected in the book. */
+        OrderId maxOrderId = 0;          /**< Highest order ID seen (new IDs should start above it). */
+        uint64_t elapsedNanos = 0;
+    };
+
+    /**
+     * @brief Rebuilds an EMPTY book from a snapshot and the journal tail.
+     * @details Either file may be missing: no snapshot replays the whole journal, no journal restores the
+     * snapshot only. Snapshot orders never cross, so they are re-posted through addOrders() without matching,
+     * in their original queue order (icebergs through restoreIceberg(), in place). Stops are re-parked after
+     * the last trade price is restored, so none of them triggers on the way in. Journaled stops and icebergs
+     * go through addStopOrder() / addIcebergOrder() between the batches of plain commands.
+     */
+    template <typename Book>
+    RecoveryStats recover(Book& book, const std::string& snapshotPath, const std::string& journalPath){
+        using Clock = std::chrono::steady_clock;
+        constexpr size_t STAGE = 64;
+        const Clock::time_point start = Clock::now();
+
+        RecoveryStats stats;
+        std::array<OrderRequest, STAGE> stage;
+        size_t staged = 0;
+
+        auto flush = [&](bool addsOnly){
+            if(staged == 0) return;
+            std::span<const OrderRequest> batch(stage.data(), staged);
+            if(addsOnly) book.addOrders(batch);
+            else book.applyBatch(batch);
+            staged = 0;
+        };
+
+        // 1. Snapshot: resting orders in queue order
+        MappedFile snapshotFile;
+        SnapshotFileHeader header;
+        std::span<const SnapshotOrder> orders;
+        if(snapshotFile.open(snapshotPath) && readSnapshot(snapshotFile, header, orders)){
+            stats.snapshotLoaded = true;
+            stats.snapshotSequence = header.lastSequence;
+            stats.lastSequence = header.lastSequence;
+            book.restoreLastTradePrice(header.lastTradePrice);
+            for(const SnapshotOrder& o : orders){
+                if(o.id > stats.maxOrderId) stats.maxOrderId = o.id;
+                if(o.kind == PersistedKind::Plain){
+                    stage[staged++] = OrderRequest{o.id, o.price, o.quantity, o.side, RequestType::Add};
+                    if(staged == STAGE) flush(true);
+                    continue;
+                }
+                flush(true);
+                if(o.kind == PersistedKind::Iceberg) book.restoreIceberg(o.id, o.price, o.quantity, o.reserve, o.displayQty, o.side);
+                else book.addStopOrder(o.id, o.stopPrice, o.price, o.quantity, o.side, o.orderType);
+            }
+            flush(true);
+            stats.restoredOrders = orders.size();
+        }
+
+        // 2. Journal tail: only what happened after the snapshot
+        MappedFile journalFile;
+        if(journalFile.open(journalPath)){
+            for(const JournalRecord& r : journalRecords(journalFile)){
+                if(r.sequence <= stats.snapshotSequence) continue;
+                if(r.type == RequestType::Add && r.id > stats.maxOrderId) stats.maxOrderId = r.id;
+                stats.lastSequence = r.sequence;
+                ++stats.replayedCommands;
+                if(r.kind == PersistedKind::Plain){
+                    stage[staged++] = OrderRequest{r.id, r.price, r.qty, r.side, r.type, r.orderType, r.symbol};
+                    if(staged == STAGE) flush(false);
+                    continue;
+                }
+                flush(false);
+                if(r.kind == PersistedKind::Iceberg) book.addIcebergOrder(r.id, r.price, r.qty, r.displayQty, r.side);
+                else book.addStopOrder(r.id, r.stopPrice, r.price, r.qty, r.side, r.orderType);
+            }
+            flush(false);
+        }
+
+        stats.elapsedNanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        return stats;
+    }
+}
@@ -0,0 +1,32 @@
+/**
+ * @file Prefetch.h
+ * @brief Portable software prefetch hints.
+ * @details Asking the CPU to start loading a cache line a few operations before it is needed hides
+ * the memory latency behind useful work. On compilers without the builtin the hints compile to nothing.
+ */
+#pragma once
+
+namespace LOB {
+
+    /**
+     * @brief Hint that the cache line holding 'addr' will soon be READ.
+     */
+    inline void prefetch(const void* addr){
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(addr, 0, 3);
+#else
+        (void)addr;
+#endif
+    }
+
+    /**
+     * @brief Hint that the cache line holding 'addr' will soon be WRITTEN.
+     */
+    inline void prefetchForWrite(const void* addr){
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(addr, 1, 3);
+#else
+        (void)addr;
+#endif
+    }
+}
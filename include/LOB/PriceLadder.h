@@ -0,0 +1,614 @@
+/**
+ * @file PriceLadder.h
+ * @brief Side storage backends ("Price Ladders") for the Order Book.
+ * @details A Price Ladder owns every LimitLevel of ONE side of the book and answers three questions:
+ * "where is the level for price P?", "which level is the best price?" and "walk the levels best to worst".
+ * It also aggregates depth: the volume within N ticks of the touch (volumeWithin()), and the size, levels and
+ * notional of a sweep for a quantity (estimateFill(), used by FOK orders and order routers).
+ * Two interchangeable backends are provided:
+ * 1. **MapPriceLadder:** The original red-black tree (std::map). Unbounded price range, O(log N) lookups.
+ *    LimitLevels come from an ObjectPool, so a level flickering in and out at the touch never calls new/delete.
+ * 2. **FlatPriceLadder:** A contiguous array of inline LimitLevels indexed by (price - basePrice) / tickSize.
+ *    O(1) lookups, no pointer chasing, the best price is a cached index. Depth queries are SIMD scans over
+ *    a dense per-tick volume array (DepthKernels.h).
+ *
+ * Both expose the same interface so that BasicOrderBook can be instantiated with either one.
+ */
+#pragma once
+#include <map>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "LimitLevel.h"
+#include "BookConfig.h"
+#include "OccupancyBitmap.h"
+#include "ObjectPool.h"
+#include "Prefetch.h"
+#include "DepthKernels.h"
+
+namespace LOB {
+
+    /**
+     * @class MapPriceLadder
+     * @brief Tree-based ladder. Levels are pool-allocated and kept sorted in a std::map.
+     * @tparam S The side of the book this ladder stores (decides the sort order).
+     */
+    template <Side S>
+    class MapPriceLadder {
+        private:
+            // Bids: priority goes to the HIGHEST price. Comparator: std::greater (101, 100, 99...)
+            // Asks: priority goes to the LOWEST price.  Comparator: std::less    (100, 101, 102...)
+            using Compare = std::conditional_t<S == Side::Buy, std::greater<Price>, std::less<Price>>;
+
+            std::map<Price, LimitLevel*, Compare> levels_;
+
+            // Recycles empty levels. Always growable: a new price must never be refused.
+            ObjectPool<LimitLevel> levelPool_;
+
+            // Only used to measure distances in ticks (volumeWithin()).
+            Price tickSize_;
+
+            static bool withinLimit(Price price, Price limit){
+                if constexpr (S == Side::Buy) return price >= limit;
+                else return price <= limit;
+            }
+
+        public:
+            /**
+             * @brief Construct an empty ladder.
+             * @param config Supplies levelPoolCapacity and tickSize (the price window settings are unused by the tree).
+             */
+            explicit MapPriceLadder(const BookConfig& config)
+                : levelPool_(config.levelPoolCapacity, PoolOptions{true, config.useHugePages, config.lockPages}),
+                  tickSize_(config.tickSize > 0 ? config.tickSize : 1) {}
+
+            ~MapPriceLadder(){
+                for(auto& pair : levels_) levelPool_.deallocate(pair.second);
+            }
+
+            MapPriceLadder(const MapPriceLadder&) = delete;
+            MapPriceLadder& operator=(const MapPriceLadder&) = delete;
+
+            /**
+             * @brief Every price is representable in a tree.
+             */
+            bool isValidPrice(Price) const { return true; }
+
+            /**
+             * @brief Finds the level for a price.
+             * @return Pointer to the level, or nullptr if no order rests at that price.
+             * @note Complexity: O(log N)
+             */
+            LimitLevel* find(Price price) const {
+                auto it = levels_.find(price);
+                return it == levels_.end() ? nullptr : it->second;
+            }
+
+            /**
+             * @brief Finds the level for a price, creating it if needed.
+             * @note Complexity: O(log N). A single tree descent thanks to try_emplace.
+             */
+            LimitLevel* getOrCreate(Price price){
+                auto [it, inserted] = levels_.try_emplace(price, nullptr);
+                if(inserted){
+                    it->second = levelPool_.allocate(price);
+                }
+                return it->second;
+            }
+
+            /**
+             * @brief Removes a level that has become empty.
+             * @details The best level is by far the most common case (sweeps), so it is erased
+             * through begin() without a second tree descent.
+             */
+            void erase(LimitLevel* level){
+                if(levels_.begin()->second == level){
+                    levels_.erase(levels_.begin());
+                }
+                else{
+                    levels_.erase(level->getPrice());
+                }
+                levelPool_.deallocate(level);
+            }
+
+            /**
+             * @brief Access the Top of Book for this side.
+             * @return Pointer to the best level, or nullptr if the side is empty.
+             */
+            LimitLevel* best() const {
+                return levels_.empty() ? nullptr : levels_.begin()->second;
+            }
+
+            /**
+             * @brief No-op: tree nodes cannot be located without walking the tree.
+             */
+            void prefetch(Price) const {}
+
+            /**
+             * @brief Starts loading the level that becomes best once the current best one is consumed (sweeps).
+             */
+            void prefetchNext() const {
+                if(levels_.size() > 1) LOB::prefetch(std::next(levels_.begin())->second);
+            }
+
+            bool empty() const { return levels_.empty(); }
+
+            /**
+             * @brief Number of non-empty price levels.
+             */
+            size_t size() const { return levels_.size(); }
+
+            /**
+             * @brief No-op: the tree reads LimitLevel::getVolume() directly.
+             */
+            void syncVolume(const LimitLevel&) {}
+
+            /**
+             * @brief Volume resting at the touch and up to 'ticks' ticks behind it.
+             * @note Complexity: O(levels in range) node walk.
+             */
+            Quantity volumeWithin(size_t ticks) const {
+                Quantity total = 0;
+                if(levels_.empty()) return total;
+                const Price touch = levels_.begin()->first;
+                for(auto const& [price, level] : levels_){
+                    Price distance = (S == Side::Buy) ? touch - price : price - touch;
+                    if(distance / tickSize_ > ticks) break;
+                    total += level->getVolume();
+                }
+                return total;
+            }
+
+            /**
+             * @brief What taking 'qty' from this side, up to 'limit', would fill.
+             * @note Complexity: O(levels touched) node walk.
+             */
+            FillEstimate estimateFill(Quantity qty, Price limit) const {
+                FillEstimate estimate;
+                for(auto const& [price, level] : levels_){
+                    if(estimate.filled >= qty || !withinLimit(price, limit)) break;
+                    Quantity take = std::min(level->getVolume(), qty - estimate.filled);
+                    estimate.filled += take;
+                    estimate.notional += take * price;
+                    estimate.worstPrice = price;
+                    ++estimate.levels;
+                }
+                return estimate;
+            }
+
+            /**
+             * @brief Visits every level from the best price to the worst.
+             */
+            template <typename F>
+            void forEachLevel(F&& visit) const {
+                for(auto const& [price, level] : levels_) visit(*level);
+            }
+
+            /**
+             * @brief Visits levels from the best price outward while 'visit' returns true.
+             */
+            template <typename F>
+            void forEachLevelWhile(F&& visit) const {
+                for(auto const& [price, level] : levels_){
+                    if(!visit(*level)) return;
+                }
+            }
+
+            /**
+             * @brief Visits every level from the worst price to the best.
+             */
+            template <typename F>
+            void forEachLevelReverse(F&& visit) const {
+                for(auto it = levels_.rbegin(); it != levels_.rend(); ++it) visit(*it->second);
+            }
+    };
+
+    /**
+     * @class FlatPriceLadder
+     * @brief Array-based ladder for instruments that trade in a bounded tick band.
+     * @details
+     * - **Inline Levels:** LimitLevels live directly inside a std::vector, one slot per tick.
+     *   Price -> Level is a subtraction and a division, no tree nodes are touched.
+     * - **Cached Best Index:** The index of the best non-empty slot is kept up to date on insert/erase,
+     *   so best() is a single load.
+     * - **Occupancy Bitmap:** A hierarchical bitmap marks the non-empty slots. When the best level empties,
+     *   the next one is found with a few word scans instead of walking every empty tick in between.
+     * - **Recentering:** If a price falls outside the window, the occupied levels are re-laid into a new
+     *   window centred on the active range (doubling the slot count if it no longer fits, up to maxLadderTicks).
+     *   Prices that would need a wider window are not valid for this ladder. The new window is fully built
+     *   before the old one is released, so a failed allocation leaves the ladder as it was.
+     *   Orders only link to each other, never to their level, so relocating levels is safe.
+     * - **SoA Depth:** The volume of every slot is mirrored into a dense Quantity array laid out from the touch
+     *   outward (bids reversed), so depth queries are forward SIMD scans instead of level walks.
+     *   The book calls syncVolume() wherever it publishes a level change.
+     * @tparam S The side of the book this ladder stores.
+     */
+    template <Side S>
+    class FlatPriceLadder {
+        private:
+            static constexpr size_t npos = OccupancyBitmap::npos;
+
+            std::vector<LimitLevel> levels_;
+            OccupancyBitmap occupied_;
+
+            // Volume per slot in priority order: depth_[slotOf(i)] == levels_[i].getVolume().
+            std::vector<Quantity> depth_;
+            Price basePrice_;
+            Price tickSize_;
+
+            // Cap on levels_.size(): recenter() never grows the window beyond it.
+            size_t maxTicks_;
+
+            // Index of the best non-empty slot (highest for bids, lowest for asks), npos if empty.
+            size_t bestIdx_ = npos;
+
+            // Occupied slots (the bitmap has no population count).
+            size_t levelCount_ = 0;
+
+            // False until the first order arrives when no basePrice was configured.
+            bool anchored_;
+
+            /**
+             * @brief Is slot 'a' a better price than slot 'b' for this side?
+             */
+            static bool isBetter(size_t a, size_t b){
+                if constexpr (S == Side::Buy) return a > b;
+                else return a < b;
+            }
+
+            /**
+             * @brief First occupied slot at or behind 'idx' in priority order (npos if none).
+             */
+            size_t nextBest(size_t idx) const {
+                if constexpr (S == Side::Buy) return occupied_.findPrev(idx);
+                else return occupied_.findNext(idx);
+            }
+
+            Price priceAt(size_t idx) const { return basePrice_ + static_cast<Price>(idx) * tickSize_; }
+
+            bool inWindow(Price price) const {
+                return anchored_ && price >= basePrice_ && (price - basePrice_) / tickSize_ < levels_.size();
+            }
+
+            size_t indexOf(Price price) const { return static_cast<size_t>((price - basePrice_) / tickSize_); }
+            size_t indexIn(Price base, Price price) const { return static_cast<size_t>((price - base) / tickSize_); }
+
+            /**
+             * @brief Position of slot 'idx' in depth_ (the best prices of the window come first).
+             */
+            size_t slotOf(size_t idx) const {
+                if constexpr (S == Side::Buy) return levels_.size() - 1 - idx;
+                else return idx;
+            }
+
+            /**
+             * @brief Price 'distance' ticks behind the best one.
+             */
+            Price priceBehindBest(size_t distance) const {
+                if constexpr (S == Side::Buy) return priceAt(bestIdx_ - distance);
+                else return priceAt(bestIdx_ + distance);
+            }
+
+            /**
+             * @brief Number of depth_ slots, starting at the best one, whose price is within 'limit' (side not empty).
+             */
+            size_t slotsWithin(Price limit) const {
+                const Price touch = priceAt(bestIdx_);
+                const size_t available = levels_.size() - slotOf(bestIdx_);
+                if((S == Side::Buy) ? limit > touch : limit < touch) return 0;
+                Price reach = ((S == Side::Buy) ? touch - limit : limit - touch) / tickSize_;
+                return reach >= available ? available : static_cast<size_t>(reach) + 1;
+            }
+
+            /**
+             * @brief Replaces the window with [base, base + ticks * tickSize), carrying the occupied levels over.
+             * @details The new arrays are allocated and filled aside; the ladder only changes once nothing can throw.
+             */
+            void layout(Price base, size_t ticks){
+                std::vector<LimitLevel> levels;
+                levels.reserve(ticks);
+                for(size_t i = 0; i < ticks; ++i){
+                    levels.emplace_back(base + static_cast<Price>(i) * tickSize_);
+                }
+                OccupancyBitmap occupied(ticks);
+                std::vector<Quantity> depth(ticks, 0);
+
+                for(size_t i = occupied_.findNext(0); i != npos; i = occupied_.findNext(i + 1)){
+                    levels[indexIn(base, priceAt(i))] = levels_[i];
+                    occupied.set(indexIn(base, priceAt(i)));
+                }
+
+                // Commit: nothing below allocates.
+                levels_ = std::move(levels);
+                occupied_ = std::move(occupied);
+                depth_ = std::move(depth);
+                basePrice_ = base;
+
+                bestIdx_ = npos;
+                for(size_t i = occupied_.findNext(0); i != npos; i = occupied_.findNext(i + 1)){
+                    depth_[slotOf(i)] = levels_[i].getVolume();
+                    if(bestIdx_ == npos || isBetter(i, bestIdx_)) bestIdx_ = i;
+                }
+            }
+
+            /**
+             * @brief Lowest resting price, or 'price' if it is lower (or the side is empty).
+             */
+            Price lowestWith(Price price) const {
+                size_t first = occupied_.findNext(0);
+                return first == npos ? price : std::min(price, priceAt(first));
+            }
+
+            /**
+             * @brief Ticks from the lowest to the highest price that must fit in the window once 'price' is added.
+             */
+            size_t spanWith(Price price) const {
+                Price hi = price;
+                size_t last = occupied_.findPrev(levels_.size() - 1);
+                if(last != npos) hi = std::max(hi, priceAt(last));
+                return static_cast<size_t>((hi - lowestWith(price)) / tickSize_) + 1;
+            }
+
+            /**
+             * @brief Moves the window so that 'price' and every resting level fit inside it.
+             * @note Complexity: O(window). Only triggered when the market drifts out of range.
+             * @pre isValidPrice(price), so the span fits in maxTicks_.
+             */
+            void recenter(Price price){
+                size_t ticks = levels_.size();
+
+                if(!anchored_){
+                    // First order ever: centre an empty window on it.
+                    Price half = static_cast<Price>(ticks / 2) * tickSize_;
+                    layout(price > half ? price - half : 0, ticks);
+                    anchored_ = true;
+                    return;
+                }
+
+                // 1. Find the price range that must survive the move.
+                const size_t span = spanWith(price);
+                const Price lo = lowestWith(price);
+                const Price hi = lo + static_cast<Price>(span - 1) * tickSize_;
+
+                // 2. Keep at least 2x headroom so a trending market does not recenter on every tick (up to the cap).
+                while(span * 2 > ticks && ticks < maxTicks_) ticks = std::min(ticks * 2, maxTicks_);
+
+                // 3. Centre the range; a window without full headroom may have to slide up to reach 'hi'.
+                Price mid = lo + static_cast<Price>(span / 2) * tickSize_;
+                Price half = static_cast<Price>(ticks / 2) * tickSize_;
+                Price base = mid > half ? mid - half : 0;
+                Price last = base + static_cast<Price>(ticks - 1) * tickSize_;
+                if(hi > last) base += hi - last;
+
+                // 4. Re-lay the occupied levels into the new window.
+                layout(base, ticks);
+            }
+
+        public:
+            /**
+             * @brief Construct the ladder and pre-allocate the whole tick window.
+             * @param config Supplies basePrice, tickSize, ladderTicks and maxLadderTicks (a zero tickSize counts as 1).
+             */
+            explicit FlatPriceLadder(const BookConfig& config)
+                : basePrice_(0),
+                  tickSize_(config.tickSize > 0 ? config.tickSize : 1),
+                  maxTicks_(std::max<size_t>(config.maxLadderTicks, config.ladderTicks > 0 ? config.ladderTicks : 1)),
+                  anchored_(config.basePrice != 0)
+            {
+                layout(config.basePrice - config.basePrice % tickSize_, config.ladderTicks > 0 ? config.ladderTicks : 1);
+            }
+
+            /**
+             * @brief Only prices on the tick grid, close enough to the resting levels that the window can hold them all.
+             */
+            bool isValidPrice(Price price) const {
+                if(price % tickSize_ != 0) return false;
+                return !anchored_ || inWindow(price) || spanWith(price) <= maxTicks_;
+            }
+
+            /**
+             * @brief Finds the level for a price.
+             * @return Pointer to the level, or nullptr if no order rests at that price.
+             * @note Complexity: O(1)
+             */
+            LimitLevel* find(Price price) const {
+                if(!inWindow(price)) return nullptr;
+                size_t idx = indexOf(price);
+                return occupied_.test(idx) ? const_cast<LimitLevel*>(&levels_[idx]) : nullptr;
+            }
+
+            /**
+             * @brief Returns the slot for a price (recentering first if it lies outside the window).
+             * @note Complexity: O(1) amortized.
+             * @warning The returned pointer is only stable until the next getOrCreate() call.
+             */
+            LimitLevel* getOrCreate(Price price){
+                if(!inWindow(price)) [[unlikely]] {
+                    recenter(price);
+                }
+
+                size_t idx = indexOf(price);
+                if(!occupied_.test(idx)){
+                    occupied_.set(idx);
+                    ++levelCount_;
+                }
+                if(bestIdx_ == npos || isBetter(idx, bestIdx_)){
+                    bestIdx_ = idx;
+                }
+                return &levels_[idx];
+            }
+
+            /**
+             * @brief Starts loading the slot of 'price' ahead of an upcoming getOrCreate()/find().
+             */
+            void prefetch(Price price) const {
+                if(inWindow(price)) prefetchForWrite(&levels_[indexOf(price)]);
+            }
+
+            /**
+             * @brief Starts loading the slot one tick behind the best one (sweeps through a dense band).
+             * @note The next occupied slot is only resolved by erase(); the adjacent tick is the cheap, common guess.
+             */
+            void prefetchNext() const {
+                if(bestIdx_ == npos) return;
+                if constexpr (S == Side::Buy){
+                    if(bestIdx_ > 0) prefetchForWrite(&levels_[bestIdx_ - 1]);
+                }
+                else{
+                    if(bestIdx_ + 1 < levels_.size()) prefetchForWrite(&levels_[bestIdx_ + 1]);
+                }
+            }
+
+            /**
+             * @brief Marks a level as empty.
+             * @details The slot itself stays in the array. If it was the best price, the occupancy
+             * bitmap yields the next non-empty slot in O(depth) word scans.
+             */
+            void erase(LimitLevel* level){
+                size_t idx = static_cast<size_t>(level - levels_.data());
+                occupied_.reset(idx);
+                --levelCount_;
+                depth_[slotOf(idx)] = 0;
+                if(idx == bestIdx_){
+                    bestIdx_ = nextBest(idx);
+                }
+            }
+
+            /**
+             * @brief Access the Top of Book for this side.
+             * @return Pointer to the best level, or nullptr if the side is empty.
+             * @note Complexity: O(1)
+             */
+            LimitLevel* best() const {
+                return bestIdx_ == npos ? nullptr : const_cast<LimitLevel*>(&levels_[bestIdx_]);
+            }
+
+            bool empty() const { return bestIdx_ == npos; }
+
+            /**
+             * @brief Number of non-empty price levels.
+             */
+            size_t size() const { return levelCount_; }
+
+            /**
+             * @brief Mirrors the current volume of 'level' into the depth array.
+             */
+            void syncVolume(const LimitLevel& level){
+                depth_[slotOf(static_cast<size_t>(&level - levels_.data()))] = level.getVolume();
+            }
+
+            /**
+             * @brief Volume resting at the touch and up to 'ticks' ticks behind it.
+             * @note Complexity: O(ticks / SIMD width), empty ticks included.
+             */
+            Quantity volumeWithin(size_t ticks) const {
+                if(bestIdx_ == npos) return 0;
+                const size_t first = slotOf(bestIdx_);
+                const size_t available = depth_.size() - first;
+                return DepthKernels::sumVolume(depth_.data() + first, ticks >= available ? available : ticks + 1);
+            }
+
+            /**
+             * @brief What taking 'qty' from this side, up to 'limit', would fill.
+             * @details One scanToFill() over the slots in reach. Full slots cost
+             * sum(volume[d] * price(d)) = before * touch +/- tick * sum(volume[d] * d), and the scan's running
+             * volumes give sum(volume[d] * d) = index * before - prefixSum.
+             * @note Complexity: O(ticks reached / SIMD width).
+             */
+            FillEstimate estimateFill(Quantity qty, Price limit) const {
+                FillEstimate estimate;
+                if(bestIdx_ == npos || qty == 0) return estimate;
+
+                const size_t count = slotsWithin(limit);
+                const DepthScan scan = DepthKernels::scanToFill(depth_.data() + slotOf(bestIdx_), count, qty);
+
+                // 1. Every slot before scan.index fills completely.
+                const uint64_t weighted = static_cast<uint64_t>(scan.index) * scan.before - scan.prefixSum;
+                estimate.filled = scan.before;
+                estimate.levels = scan.nonEmpty;
+                estimate.notional = scan.before * priceAt(bestIdx_);
+                if constexpr (S == Side::Buy) estimate.notional -= tickSize_ * weighted;
+                else estimate.notional += tickSize_ * weighted;
+
+                // 2. The slot that completes the quantity fills partially; otherwise report the worst level in reach.
+                if(scan.index < count){
+                    Price price = priceBehindBest(scan.index);
+                    estimate.notional += (qty - scan.before) * price;
+                    estimate.filled = qty;
+                    estimate.worstPrice = price;
+                    ++estimate.levels;
+                }
+                else if(estimate.filled > 0){
+                    size_t worst = (S == Side::Buy) ? occupied_.findNext(bestIdx_ - (count - 1))
+                                                    : occupied_.findPrev(bestIdx_ + (count - 1));
+                    estimate.worstPrice = priceAt(worst);
+                }
+                return estimate;
+            }
+
+            /**
+             * @brief Visits every non-empty level from the best price to the worst.
+             * @note Empty ticks are skipped through the bitmap, not inspected one by one.
+             */
+            template <typename F>
+            void forEachLevel(F&& visit) const {
+                if constexpr (S == Side::Buy){
+                    for(size_t i = bestIdx_; i != npos; i = (i == 0) ? npos : occupied_.findPrev(i - 1)){
+                        visit(levels_[i]);
+                    }
+                }
+                else{
+                    for(size_t i = bestIdx_; i != npos; i = occupied_.findNext(i + 1)){
+                        visit(levels_[i]);
+                    }
+                }
+            }
+
+            /**
+             * @brief Visits non-empty levels from the best price outward while 'visit' returns true.
+             */
+            template <typename F>
+            void forEachLevelWhile(F&& visit) const {
+                if constexpr (S == Side::Buy){
+                    for(size_t i = bestIdx_; i != npos; i = (i == 0) ? npos : occupied_.findPrev(i - 1)){
+                        if(!visit(levels_[i])) return;
+                    }
+                }
+                else{
+                    for(size_t i = bestIdx_; i != npos; i = occupied_.findNext(i + 1)){
+                        if(!visit(levels_[i])) return;
+                    }
+                }
+            }
+
+            /**
+             * @brief Visits every non-empty level from the worst price to the best.
+             */
+            template <typename F>
+            void forEachLevelReverse(F&& visit) const {
+                if constexpr (S == Side::Buy){
+                    for(size_t i = occupied_.findNext(0); i != npos; i = occupied_.findNext(i + 1)){
+                        visit(levels_[i]);
+                    }
+                }
+                else{
+                    size_t last = levels_.size() - 1;
+                    for(size_t i = occupied_.findPrev(last); i != npos; i = (i == 0) ? npos : occupied_.findPrev(i - 1)){
+                        visit(levels_[i]);
+                    }
+                }
+            }
+
+            /**
+             * @brief Lowest price currently covered by the window (exposed for diagnostics/tests).
+             */
+            Price getBasePrice() const { return basePrice_; }
+
+            /**
+             * @brief Number of tick slots in the window.
+             */
+            size_t getTickCount() const { return levels_.size(); }
+    };
+}
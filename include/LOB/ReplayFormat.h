@@ -0,0 +1,138 @@
+/**
+ * @file ReplayFormat.h
+ * @brief Compact fixed-width binary format for captured order flow, plus file I/O and an ITCH converter.
+ * @details A replay file is a ReplayFileHeader followed by ReplayFileHeader::recordCount ReplayRecords:
+ *
+ * | Field       | Bytes | Meaning                                                        |
+ * | :---        | :---  | :---                                                           |
+ * | timestamp   | 8     | Nanoseconds (capture clock, e.g. since midnight)               |
+ * | orderId     | 8     | Venue order reference                                          |
+ * | price       | 8     | Limit price in ticks (Add / Modify)                            |
+ * | quantity    | 8     | Add/Modify: new size. Execute: executed size                   |
+ * | symbol      | 4     | Instrument (e.g. ITCH stock locate)                            |
+ * | type, side  | 1 + 1 | ReplayEventType, Side                                          |
+ * | reserved    | 2     | Zero                                                           |
+ *
+ * Records are 40 bytes, little-endian (host order), and naturally aligned, so a memory-mapped file is
+ * read in place: MappedFile maps it read-only and hands out a std::span<const ReplayRecord>.
+ */
+#pragma once
+#include <span>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "Order.h"
+#include "OrderRequest.h"
+
+namespace LOB {
+
+    /**
+     * @enum ReplayEventType
+     * @brief What a captured record did to the book.
+     */
+    enum class ReplayEventType : uint8_t {
+        Add,     /**< New resting order. */
+        Cancel,  /**< Order removed (whatever was left). */
+        Modify,  /**< Order amended to (price, quantity). */
+        Execute  /**< 'quantity' of a resting order traded (the order shrinks, or leaves if fully filled). */
+    };
+
+    /**
+     * @struct ReplayRecord
+     * @brief One captured event (40 bytes, see the table above).
+     */
+    struct ReplayRecord {
+        uint64_t timestamp;
+        OrderId orderId;
+        Price price;
+        Quantity quantity;
+        SymbolId symbol;
+        ReplayEventType type;
+        Side side;
+        uint16_t reserved = 0;
+    };
+
+    static_assert(sizeof(ReplayRecord) == 40, "ReplayRecord is an on-disk format");
+
+    /**
+     * @struct ReplayFileHeader
+     * @brief Leading 24 bytes of every replay file.
+     */
+    struct ReplayFileHeader {
+        char magic[8] = {'N', 'A', 'N', 'O', 'R', 'E', 'P', '\0'};
+        uint32_t version = 1;
+        uint32_t recordSize = sizeof(ReplayRecord);
+        uint64_t recordCount = 0;
+    };
+
+    static_assert(sizeof(ReplayFileHeader) == 24, "ReplayFileHeader is an on-disk format");
+
+    /**
+     * @class MappedFile
+     * @brief Read-only memory map of a replay file (falls back to reading it into memory off Linux).
+     */
+    class MappedFile {
+        private:
+            const void* data_ = nullptr;
+            size_t size_ = 0;
+            bool mapped_ = false;
+            std::vector<unsigned char> fallback_;
+
+        public:
+            MappedFile() = default;
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Maps 'path'.
+             * @return false if the file cannot be opened or mapped.
+             */
+            bool open(const std::string& path);
+
+            void close();
+
+            const unsigned char* data() const { return static_cast<const unsigned char*>(data_); }
+            size_t size() const { return size_; }
+            bool isOpen() const { return data_ != nullptr; }
+
+            /**
+             * @brief The records of a replay file, or an empty span if the header is missing or invalid.
+             */
+            std::span<const ReplayRecord> records() const;
+    };
+
+    /**
+     * @brief Writes a replay file (header + records).
+     * @return false on I/O error.
+     */
+    bool writeReplayFile(const std::string& path, std::span<const ReplayRecord> records);
+
+    /**
+     * @struct ItchStats
+     * @brief What convertItch() found in a capture.
+     */
+    struct ItchStats {
+        uint64_t messages = 0;   /**< Length-prefixed messages read. */
+        uint64_t converted = 0;  /**< Records produced. */
+        uint64_t skipped = 0;    /**< Message types without a book effect (system, trades, ...). */
+        uint64_t orphans = 0;    /**< Order messages whose reference was never added. */
+        bool truncated = false;  /**< The capture ended in the middle of a message. */
+    };
+
+    /**
+     * @brief Converts an ITCH 5.0-style capture into replay records.
+     * @details The input is a sequence of messages, each prefixed by a 2-byte big-endian length (the framing
+     * of the venue's binary files). Order messages are translated, everything else is skipped:
+     * - 'A' / 'F' Add Order           -> Add (symbol = stock locate, price = raw 1/10000 units)
+     * - 'E' / 'C' Order Executed      -> Execute
+     * - 'X' Order Cancel (partial)    -> Modify to the remaining size (Cancel if nothing is left)
+     * - 'D' Order Delete              -> Cancel
+     * - 'U' Order Replace             -> Cancel of the old reference + Add of the new one (same side)
+     * @param capture Raw bytes of the capture.
+     * @param out Records are appended here.
+     */
+    ItchStats convertItch(std::span<const unsigned char> capture, std::vector<ReplayRecord>& out);
+}
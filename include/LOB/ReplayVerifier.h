@@ -0,0 +1,121 @@
+/**
+ * @file ReplayVerifier.h
+ * @brief Proves that an optimized book configuration produces bit-identical output to the reference one.
+ * @details verifyReplay() runs one request stream through two books at once, each on its own thread:
+ * 1. **Reference:** One public call per request (addOrder / cancelOrder / modifyOrder), no batching.
+ * 2. **Candidate:** The optimized configuration, fed through applyBatch() in runs of 'batch' requests.
+ * Both use a DigestSink, so every sequence number gets a rolling XXH64 of its events. The digest arrays
+ * are compared afterwards; on a mismatch both books are replayed again up to the first divergent sequence
+ * number, this time capturing its events, so the report shows exactly what each side emitted.
+ */
+#pragma once
+#include <span>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "OrderBook.h"
+#include "OrderRequest.h"
+#include "EventDigest.h"
+
+namespace LOB {
+
+    /**
+     * @struct VerifyReport
+     * @brief Outcome of one verifyReplay() run.
+     */
+    struct VerifyReport {
+        static constexpr uint64_t NO_DIVERGENCE = ~uint64_t{0};
+
+        uint64_t instructions = 0;                   /**< Requests replayed through each book. */
+        uint64_t firstDivergence = NO_DIVERGENCE;    /**< Sequence number of the first instruction that differs. */
+        uint64_t referenceDigest = 0;                /**< Rolling digest after the last instruction. */
+        uint64_t candidateDigest = 0;
+        uint64_t referenceNanos = 0;                 /**< Wall time of each book's pass. */
+        uint64_t candidateNanos = 0;
+        std::vector<ExecutionEvent> referenceEvents; /**< Events of the first divergent instruction (if any). */
+        std::vector<ExecutionEvent> candidateEvents;
+
+        bool identical() const { return firstDivergence == NO_DIVERGENCE; }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief One pass of 'flow' through a freshly built book. batch == 0 uses the unbatched public API.
+         * @param captureSeq Process requests [0, captureSeq] only and keep the events of the last one,
+         *        or NO_CAPTURE to process all of them.
+         * @return The book's sink (digests, captured events), and the pass time in 'nanos'.
+         */
+        template <typename Book>
+        DigestSink runDigestPass(std::span<const OrderRequest> flow, const BookConfig& config, size_t batch,
+                                 uint64_t captureSeq, uint64_t& nanos)
+        {
+            const size_t count = (captureSeq == DigestSink::NO_CAPTURE) ? flow.size()
+                                                                        : std::min<size_t>(flow.size(), captureSeq + 1);
+            Book book(config);
+            book.getSink().captureAt(captureSeq);
+
+            auto start = std::chrono::steady_clock::now();
+            if(batch == 0){
+                for(size_t i = 0; i < count; ++i){
+                    const OrderRequest& r = flow[i];
+                    switch(r.type){
+                        case RequestType::Add:    book.addOrder(r.id, r.price, r.qty, r.side, r.orderType); break;
+                        case RequestType::Cancel: book.cancelOrder(r.id); break;
+                        case RequestType::Modify: book.modifyOrder(r.id, r.price, r.qty); break;
+                    }
+                }
+            }
+            else{
+                for(size_t i = 0; i < count; i += batch){
+                    book.applyBatch(flow.subspan(i, std::min(batch, count - i)));
+                }
+            }
+            nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            return std::move(book.getSink());
+        }
+    }
+
+    /**
+     * @brief Replays 'flow' through a reference and a candidate book in parallel and compares their output.
+     * @tparam Reference A BasicOrderBook with a DigestSink (fed one call per request).
+     * @tparam Candidate A BasicOrderBook with a DigestSink (fed through applyBatch()).
+     * @param batch Candidate batch size (> 0).
+     */
+    template <typename Reference, typename Candidate>
+    VerifyReport verifyReplay(std::span<const OrderRequest> flow, const BookConfig& referenceConfig,
+                              const BookConfig& candidateConfig, size_t batch = 64)
+    {
+        VerifyReport report;
+        report.instructions = flow.size();
+        if(batch == 0) batch = 1;
+
+        // 1. Both passes at once, each book built on (and first-touched by) its own thread.
+        std::vector<uint64_t> reference, candidate;
+        std::thread referenceThread([&]{
+            reference = detail::runDigestPass<Reference>(flow, referenceConfig, 0, DigestSink::NO_CAPTURE, report.referenceNanos).getDigests();
+        });
+        std::thread candidateThread([&]{
+            candidate = detail::runDigestPass<Candidate>(flow, candidateConfig, batch, DigestSink::NO_CAPTURE, report.candidateNanos).getDigests();
+        });
+        referenceThread.join();
+        candidateThread.join();
+
+        report.referenceDigest = reference.empty() ? 0 : reference.back();
+        report.candidateDigest = candidate.empty() ? 0 : candidate.back();
+
+        // 2. First sequence number whose rolling digest differs (chaining makes every later one differ too).
+        auto mismatch = std::mismatch(reference.begin(), reference.end(), candidate.begin(), candidate.end());
+        if(mismatch.first == reference.end() && mismatch.second == candidate.end()) return report;
+        report.firstDivergence = static_cast<uint64_t>(mismatch.first - reference.begin());
+
+        // 3. Replay up to it again, keeping what each side emitted there.
+        uint64_t ignored = 0;
+        report.referenceEvents = detail::runDigestPass<Reference>(flow, referenceConfig, 0, report.firstDivergence, ignored).getCaptured();
+        report.candidateEvents = detail::runDigestPass<Candidate>(flow, candidateConfig, batch, report.firstDivergence, ignored).getCaptured();
+        return report;
+    }
+}
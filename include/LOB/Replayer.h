@@ -0,0 +1,135 @@
+/**
+ * @file Replayer.h
+ * @brief Feeds captured order flow (ReplayFormat.h) into an OrderBook, at full speed or paced by timestamps.
+ * @details The records are read in place from the memory-mapped file. They are translated into
+ * OrderRequests in a small, L1-resident staging batch and handed to OrderBook::applyBatch(), so a replay
+ * exercises exactly the same batched hot path as live traffic.
+ * 1. **MaxSpeed:** Records are applied back to back (throughput testing, incident reproduction).
+ * 2. **Timestamp:** The gaps between record timestamps are reproduced on the wall clock (divided by 'speed'),
+ *    so bursts and lulls look the way they did in production.
+ */
+#pragma once
+#include <span>
+#include <array>
+#include <chrono>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include "ReplayFormat.h"
+#include "OrderRequest.h"
+
+namespace LOB {
+
+    /**
+     * @enum ReplayPacing
+     * @brief How fast records are applied.
+     */
+    enum class ReplayPacing : uint8_t { MaxSpeed, Timestamp };
+
+    /**
+     * @struct ReplayOptions
+     * @brief Knobs of one replay run.
+     */
+    struct ReplayOptions {
+        ReplayPacing pacing = ReplayPacing::MaxSpeed;
+
+        /** Timestamp pacing only: 2.0 replays twice as fast as captured. Must be > 0. */
+        double speed = 1.0;
+
+        /** Only apply records of 'symbol' (captures usually hold many instruments). */
+        bool filterSymbol = false;
+        SymbolId symbol = 0;
+    };
+
+    /**
+     * @struct ReplayStats
+     * @brief Outcome of one replay run.
+     */
+    struct ReplayStats {
+        uint64_t records = 0;        /**< Records read. */
+        uint64_t applied = 0;        /**< Requests handed to the book. */
+        uint64_t filtered = 0;       /**< Records of other symbols. */
+        uint64_t unknownOrders = 0;  /**< Executions of an order that is not resting. */
+        uint64_t elapsedNanos = 0;   /**< Wall time of the run. */
+    };
+
+    /**
+     * @brief Applies 'records' to 'book' in order.
+     * @tparam Book Any BasicOrderBook instantiation.
+     * @details An Execute record shrinks the resting order by the executed size (or removes it when fully
+     * filled). Since that depends on the order's current size, the staged batch is flushed first.
+     */
+    template <typename Book>
+    ReplayStats replay(std::span<const ReplayRecord> records, Book& book, const ReplayOptions& options = {}){
+        using Clock = std::chrono::steady_clock;
+        constexpr size_t STAGE = 64;
+        assert(options.pacing != ReplayPacing::Timestamp || options.speed > 0);
+
+        ReplayStats stats;
+        std::array<OrderRequest, STAGE> stage;
+        size_t staged = 0;
+
+        auto flush = [&]{
+            if(staged == 0) return;
+            book.applyBatch(std::span<const OrderRequest>(stage.data(), staged));
+            stats.applied += staged;
+            staged = 0;
+        };
+        auto push = [&](const OrderRequest& request){
+            stage[staged++] = request;
+            if(staged == STAGE) flush();
+        };
+
+        const Clock::time_point start = Clock::now();
+        const uint64_t firstTimestamp = records.empty() ? 0 : records.front().timestamp;
+
+        for(const ReplayRecord& r : records){
+            ++stats.records;
+            if(options.filterSymbol && r.symbol != options.symbol){
+                ++stats.filtered;
+                continue;
+            }
+
+            // Timestamp pacing: never sit on staged requests while waiting for the next record's time.
+            if(options.pacing == ReplayPacing::Timestamp && r.timestamp > firstTimestamp){
+                auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(
+                    static_cast<double>(r.timestamp - firstTimestamp) / options.speed));
+                if(Clock::now() < due){
+                    flush();
+                    while(Clock::now() < due) {}
+                }
+            }
+
+            switch(r.type){
+                case ReplayEventType::Add:
+                    push(OrderRequest{r.orderId, r.price, r.quantity, r.side, RequestType::Add, OrderType::Limit, r.symbol});
+                    break;
+                case ReplayEventType::Cancel:
+                    push(OrderRequest{r.orderId, 0, 0, r.side, RequestType::Cancel, OrderType::Limit, r.symbol});
+                    break;
+                case ReplayEventType::Modify:
+                    push(OrderRequest{r.orderId, r.price, r.quantity, r.side, RequestType::Modify, OrderType::Limit, r.symbol});
+                    break;
+                case ReplayEventType::Execute: {
+                    flush();
+                    const Order* resting = book.findOrder(r.orderId);
+                    if(!resting){
+                        ++stats.unknownOrders;
+                        break;
+                    }
+                    if(r.quantity >= resting->quantity){
+                        push(OrderRequest{r.orderId, 0, 0, resting->side, RequestType::Cancel, OrderType::Limit, r.symbol});
+                    }
+                    else{
+                        push(OrderRequest{r.orderId, resting->price, resting->quantity - r.quantity, resting->side, RequestType::Modify, OrderType::Limit, r.symbol});
+                    }
+                    break;
+                }
+            }
+        }
+        flush();
+
+        stats.elapsedNanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        return stats;
+    }
+}
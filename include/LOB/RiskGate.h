@@ -0,0 +1,374 @@
+/**
+ * @file RiskGate.h
+ * @brief Inline pre-trade risk checks in front of the book (no network hop, no allocation, no lock).
+ * @details Three pieces, all running on the matching thread:
+ * 1. **RiskLedger:** Per-account limits and exposure in a flat array indexed by AccountId, plus a fixed-size
+ *    table attributing each working order to its account (bounded probe window, no tombstones; hashed or
+ *    direct-mapped like the book's own OrderIndex).
+ * 2. **RiskSink:** An Execution Sink decorator. It forwards every event to the wrapped sink and keeps the ledger
+ *    in step with what the book actually did: fills move positions, cancels / rejects / amendments release or
+ *    resize the working exposure. Book type: BasicOrderBook<Ladder, Index, RiskSink<QueueSink>>.
+ * 3. **RiskGate:** The entry point. addOrder()/modifyOrder() evaluate every limit at once into a violation
+ *    bitmask (one predictable branch), then either forward to the book or emit a Reject through the sink.
+ *
+ * Exposure is counted worst case: an account's buy-side exposure is its position plus every working buy,
+ * its sell-side exposure the working sells minus its position, and its notional is the sum of price x open
+ * quantity over working orders. Orders that reach the book without going through the gate are not tracked.
+ * @note price x quantity must fit in 64 bits (set maxOrderQty accordingly).
+ */
+#pragma once
+#include <bit>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Order.h"
+#include "Events.h"
+#include "EventSink.h"
+#include "BookConfig.h"
+#include "OrderRequest.h"
+#include "OrderBook.h"
+
+namespace LOB {
+
+    /** Trading account identifier (dense: 0 .. BookConfig::riskAccounts - 1). */
+    using AccountId = uint32_t;
+
+    /**
+     * @struct RiskLimits
+     * @brief Per-account limits. The defaults disable every check.
+     */
+    struct RiskLimits {
+        Quantity maxOrderQty = std::numeric_limits<Quantity>::max();
+        Price priceCollar = std::numeric_limits<Price>::max();     /**< Max distance from the BBO reference price. */
+        Quantity maxPosition = std::numeric_limits<Quantity>::max(); /**< Max worst-case exposure on either side. */
+        uint64_t maxNotional = std::numeric_limits<uint64_t>::max(); /**< Max price x quantity over working orders. */
+    };
+
+    /**
+     * @struct AccountRisk
+     * @brief Limits and live exposure of one account.
+     */
+    struct AccountRisk {
+        RiskLimits limits;
+        int64_t position = 0;       /**< Filled: bought - sold. */
+        Quantity openBuy = 0;       /**< Working buy quantity (resting or in flight). */
+        Quantity openSell = 0;      /**< Working sell quantity. */
+        uint64_t openNotional = 0;  /**< Sum of price x open quantity over working orders. */
+    };
+
+    /**
+     * @class RiskLedger
+     * @brief Flat per-account state and order attribution for the pre-trade checks.
+     */
+    class RiskLedger {
+        private:
+            /**
+             * @brief One working order (32 bytes, two per cache line).
+             */
+            struct Working {
+                OrderId id = 0;
+                Price price = 0;        // limit price (reference price for Market orders)
+                Quantity open = 0;
+                AccountId account = 0;
+                Side side = Side::Buy;
+                bool live = false;
+                bool pending = false;   // inside the addOrder() call that submitted it
+            };
+
+            // An ID lives in one of the PROBE_WINDOW slots after its home slot: lookups are bounded and
+            // erasing is just clearing 'live' (lookups always scan the whole window, so no tombstones).
+            static constexpr size_t PROBE_WINDOW = 8;
+
+            std::vector<AccountRisk> accounts_;
+            std::vector<Working> working_;
+            size_t mask_;
+            int shift_;
+            bool dense_;
+            uint64_t rejects_ = 0;
+
+            // Dense IDs (monotonically increasing) map to consecutive slots, as in OrderIndexMode::Dense.
+            size_t home(OrderId id) const {
+                if(dense_) return static_cast<size_t>(id) & mask_;
+                return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_);
+            }
+
+            void release(Working& w, Quantity qty){
+                AccountRisk& a = accounts_[w.account];
+                if(w.side == Side::Buy) a.openBuy -= qty;
+                else a.openSell -= qty;
+                a.openNotional -= qty * w.price;
+                w.open -= qty;
+                if(w.open == 0) w.live = false;
+            }
+
+            void fill(OrderId id, Quantity qty, bool bought){
+                Working* w = find(id);
+                if(!w) return;
+                AccountRisk& a = accounts_[w->account];
+                a.position += bought ? static_cast<int64_t>(qty) : -static_cast<int64_t>(qty);
+                release(*w, qty);
+            }
+
+        public:
+            /**
+             * @param accounts Number of accounts (AccountIds 0 .. accounts - 1).
+             * @param orderCapacity Working orders tracked at once; the table has at least 2x as many slots.
+             * @param mode Hashed (any ID pattern) or Dense (monotonically increasing IDs: consecutive slots).
+             */
+            RiskLedger(size_t accounts, size_t orderCapacity, OrderIndexMode mode = OrderIndexMode::Hashed)
+                : accounts_(accounts), dense_(mode == OrderIndexMode::Dense) {
+                size_t slots = std::bit_ceil(std::max<size_t>(orderCapacity * 2, PROBE_WINDOW));
+                working_.resize(slots);
+                mask_ = slots - 1;
+                shift_ = 64 - std::countr_zero(slots);
+            }
+
+            /**
+             * @brief The working order 'id', or nullptr if it is not tracked.
+             * @note Complexity: at most PROBE_WINDOW entries (4 cache lines); a miss always scans all of them.
+             */
+            Working* find(OrderId id){
+                size_t h = home(id);
+                for(size_t k = 0; k < PROBE_WINDOW; ++k){
+                    Working& w = working_[(h + k) & mask_];
+                    if(w.live && w.id == id) return &w;
+                }
+                return nullptr;
+            }
+
+            /**
+             * @brief Evaluates every limit for a new (or resized) order at once.
+             * @param releasedQty / releasedNotional Exposure the order replaces (amendments), 0 for new orders.
+             * @param reference BBO reference price (0 = no quote, collar not applied).
+             * @return 0 if accepted, otherwise the violation bitmask (bit i = the i-th check below).
+             */
+            uint32_t violations(const AccountRisk& a, Side side, Price price, Quantity qty, Quantity releasedQty,
+                                uint64_t releasedNotional, Price reference) const {
+                const RiskLimits& l = a.limits;
+                const Price distance = price > reference ? price - reference : reference - price;
+                const int64_t exposure = (side == Side::Buy)
+                    ? a.position + static_cast<int64_t>(a.openBuy - releasedQty + qty)
+                    : static_cast<int64_t>(a.openSell - releasedQty + qty) - a.position;
+                const uint64_t notional = a.openNotional - releasedNotional + qty * price;
+
+                // Plain bitwise ORs: the compiler evaluates every check without branching
+                return static_cast<uint32_t>(qty == 0 || qty > l.maxOrderQty)
+                     | static_cast<uint32_t>(reference != 0 && distance > l.priceCollar) << 1
+                     | static_cast<uint32_t>(exposure > 0 && static_cast<uint64_t>(exposure) > l.maxPosition) << 2
+                     | static_cast<uint32_t>(notional > l.maxNotional) << 3;
+            }
+
+            /**
+             * @brief The RejectReason of the lowest set bit of violations().
+             */
+            static RejectReason reasonOf(uint32_t violations){
+                static constexpr RejectReason reasons[] = {
+                    RejectReason::RiskOrderSize, RejectReason::RiskPriceCollar,
+                    RejectReason::RiskPosition, RejectReason::RiskNotional
+                };
+                return reasons[std::countr_zero(violations)];
+            }
+
+            /**
+             * @brief Starts tracking an accepted order (marked pending until endSubmit()).
+             * @return Its entry, or nullptr if every slot of its probe window is taken.
+             */
+            Working* beginSubmit(AccountId account, OrderId id, Price price, Quantity qty, Side side){
+                size_t h = home(id);
+                for(size_t k = 0; k < PROBE_WINDOW; ++k){
+                    Working& w = working_[(h + k) & mask_];
+                    if(!w.live){
+                        w = Working{id, price, qty, account, side, true, true};
+                        AccountRisk& a = accounts_[account];
+                        if(side == Side::Buy) a.openBuy += qty;
+                        else a.openSell += qty;
+                        a.openNotional += qty * price;
+                        return &w;
+                    }
+                }
+                return nullptr;
+            }
+
+            /**
+             * @brief The book has finished with the submission: later rejects no longer refer to it.
+             * @details Nothing is inserted while the book runs, so the entry is still the same slot
+             * (cleared already if the order was filled or discarded, which is harmless).
+             */
+            static void endSubmit(Working* w) { w->pending = false; }
+
+            // --- Feedback from the book (called by RiskSink) ---
+
+            void onTrade(const Trade& t){
+                fill(t.buyOrderId, t.quantity, true);
+                fill(t.sellOrderId, t.quantity, false);
+            }
+
+            void onCancel(const Cancel& c){
+                if(Working* w = find(c.orderId)) release(*w, w->open);
+            }
+
+            void onModify(const Modify& m){
+                Working* w = find(m.orderId);
+                if(!w) return;
+                AccountRisk& a = accounts_[w->account];
+                if(w->side == Side::Buy) a.openBuy = a.openBuy - w->open + m.quantity;
+                else a.openSell = a.openSell - w->open + m.quantity;
+                a.openNotional = a.openNotional - w->open * w->price + m.quantity * m.price;
+                w->price = m.price;
+                w->open = m.quantity;
+            }
+
+            /**
+             * @brief A book-level reject (duplicate ID, off-grid price, pool exhausted) of the order being submitted.
+             * @details Rejects of amendments leave the working order untouched, so only pending entries are released.
+             */
+            void onReject(const Reject& r){
+                Working* w = find(r.orderId);
+                if(w && w->pending) release(*w, w->open);
+            }
+
+            void countReject() { ++rejects_; }
+
+            bool isKnown(AccountId account) const { return account < accounts_.size(); }
+            AccountRisk& getAccount(AccountId account) { return accounts_[account]; }
+            const AccountRisk& getAccount(AccountId account) const { return accounts_[account]; }
+            size_t getAccountCount() const { return accounts_.size(); }
+
+            /**
+             * @brief Orders refused by the gate (book-level rejects are not counted).
+             */
+            uint64_t getRejectCount() const { return rejects_; }
+    };
+
+    /**
+     * @class RiskSink
+     * @brief Execution Sink decorator: updates the RiskLedger, then forwards to 'Inner' (QueueSink by default).
+     * @details Derives from Inner, so Inner's own API (e.g. QueueSink::events()) stays available on the book's sink.
+     */
+    template <typename Inner = QueueSink>
+    class RiskSink : public Inner {
+        private:
+            RiskLedger ledger_;
+
+        public:
+            /**
+             * @brief Sizes the ledger from BookConfig::riskAccounts / riskOrderCapacity (and follows orderIndexMode).
+             */
+            explicit RiskSink(const BookConfig& config)
+                : Inner(config),
+                  ledger_(config.riskAccounts, config.riskOrderCapacity > 0 ? config.riskOrderCapacity : config.orderPoolCapacity,
+                          config.orderIndexMode) {}
+
+            void onTrade(const Trade& trade) { ledger_.onTrade(trade); Inner::onTrade(trade); }
+            void onCancel(const Cancel& cancel) { ledger_.onCancel(cancel); Inner::onCancel(cancel); }
+            void onModify(const Modify& modify) { ledger_.onModify(modify); Inner::onModify(modify); }
+            void onReject(const Reject& reject) { ledger_.onReject(reject); Inner::onReject(reject); }
+
+            RiskLedger& getLedger() { return ledger_; }
+            const RiskLedger& getLedger() const { return ledger_; }
+    };
+
+    /**
+     * @class RiskGate
+     * @brief Pre-trade risk stage in front of a book whose sink is a RiskSink.
+     * @details Cancels are passed straight through. The book must only be driven from one thread (the gate,
+     * the book and the ledger share it), and orders skipping the gate are invisible to the limits.
+     * @tparam Book A BasicOrderBook<Ladder, Index, RiskSink<...>, Lock> instantiation.
+     */
+    template <typename Book>
+    class RiskGate {
+        private:
+            Book& book_;
+
+            RiskLedger& ledger() { return book_.getSink().getLedger(); }
+
+            /**
+             * @brief Collar reference: the BBO mid, or the only side quoted, or 0 for an empty book.
+             */
+            Price referencePrice() const {
+                const LimitLevel* bid = book_.getBestBid();
+                const LimitLevel* ask = book_.getBestAsk();
+                Price b = bid ? bid->getPrice() : 0;
+                Price a = ask ? ask->getPrice() : 0;
+                return (b && a) ? b + (a - b) / 2 : b + a;
+            }
+
+            bool reject(OrderId id, RejectReason reason){
+                ledger().countReject();
+                book_.getSink().onReject(Reject{id, reason});
+                return false;
+            }
+
+        public:
+            explicit RiskGate(Book& book) : book_(book) {}
+
+            /**
+             * @brief Sets the limits of one account.
+             * @return false if the account is outside BookConfig::riskAccounts.
+             */
+            bool setLimits(AccountId account, const RiskLimits& limits){
+                if(!ledger().isKnown(account)) return false;
+                ledger().getAccount(account).limits = limits;
+                return true;
+            }
+
+            /**
+             * @brief Checks, then submits a new order on behalf of 'account'.
+             * @details Market orders skip the collar; their notional is taken at the opposite best price.
+             * @return true if the order reached the book (it may still be rejected there, e.g. off-grid price).
+             */
+            bool addOrder(AccountId account, OrderId id, Price price, Quantity qty, Side side,
+                          OrderType type = OrderType::Limit){
+                RiskLedger& l = ledger();
+                if(!l.isKnown(account)) [[unlikely]] return reject(id, RejectReason::RiskUnknownAccount);
+                if(l.find(id)) [[unlikely]] return reject(id, RejectReason::DuplicateOrderId);
+
+                Price reference = referencePrice();
+                Price checked = price;
+                if(type == OrderType::Market){
+                    const LimitLevel* far = (side == Side::Buy) ? book_.getBestAsk() : book_.getBestBid();
+                    checked = far ? far->getPrice() : reference;
+                }
+
+                uint32_t violations = l.violations(l.getAccount(account), side, checked, qty, 0, 0,
+                                                   type == OrderType::Market ? 0 : reference);
+                if(violations) [[unlikely]] return reject(id, RiskLedger::reasonOf(violations));
+                auto* entry = l.beginSubmit(account, id, checked, qty, side);
+                if(!entry) [[unlikely]] return reject(id, RejectReason::RiskCapacity);
+
+                book_.addOrder(id, price, qty, side, type);
+                RiskLedger::endSubmit(entry);
+                return true;
+            }
+
+            /**
+             * @brief Checks an amendment against the same limits (the order's current exposure is released first).
+             * @details Untracked IDs and quantity 0 (a cancel) are passed straight to the book.
+             * @return true if the amendment reached the book.
+             */
+            bool modifyOrder(OrderId id, Price newPrice, Quantity newQty){
+                RiskLedger& l = ledger();
+                auto* w = l.find(id);
+                if(w && newQty > 0){
+                    uint32_t violations = l.violations(l.getAccount(w->account), w->side, newPrice, newQty,
+                                                       w->open, w->open * w->price, referencePrice());
+                    if(violations) [[unlikely]] return reject(id, RiskLedger::reasonOf(violations));
+                }
+                book_.modifyOrder(id, newPrice, newQty);
+                return true;
+            }
+
+            void cancelOrder(OrderId id) { book_.cancelOrder(id); }
+
+            const AccountRisk& getAccount(AccountId account) { return ledger().getAccount(account); }
+            uint64_t getRejectCount() { return ledger().getRejectCount(); }
+            Book& getBook() { return book_; }
+    };
+
+    /**
+     * @brief The default book with a risk ledger in its sink (events still go to a LockFreeQueue).
+     */
+    using RiskCheckedOrderBook = BasicOrderBook<MapPriceLadder, OrderIndex, RiskSink<QueueSink>>;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file SharedMemoryGateway.h
+ * @brief Order entry and drop copy between the engine and an external process over one shared-memory region.
+ * @details Replaces the loopback socket hop between a gateway / strategy process and the matching thread:
+ * @code
+ * [ GatewayHeader | ingress SharedRing<OrderRequest> | egress SharedRing<ExecutionEvent> ]
+ * @endcode
+ * 1. **Engine Side:** create() builds the region. The matching thread drains ingress() with
+ *    peek_bulk -> applyBatch -> release, exactly like a LockFreeQueue lane, and a book using SharedMemorySink
+ *    publishes its trades, cancels, rejects and coalesced level updates straight into egress().
+ * 2. **Client Side:** attach() maps the same region (at any address) and checks the layout: the client is the
+ *    single producer of ingress() and the single consumer of egress().
+ * One region serves one client process; run one per gateway, as GatewayIngress runs one lane per gateway.
+ * Best bid / offer is derived on the client from the level updates (DepthBook), as for the in-process feed.
+ */
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "Events.h"
+#include "BookConfig.h"
+#include "EventSink.h"
+#include "OrderRequest.h"
+#include "SharedMemoryQueue.h"
+
+namespace LOB {
+
+    /**
+     * @struct GatewayHeader
+     * @brief First cache line of a gateway region: where each ring lives, as offsets from the region start.
+     */
+    struct alignas(64) GatewayHeader {
+        static constexpr uint64_t MAGIC = 0x594157455441474Eull;   // "NGATEWAY" read as a little-endian word
+        static constexpr uint64_t VERSION = 1;
+
+        uint64_t magic;
+        uint64_t version;
+        uint64_t ingressOffset;
+        uint64_t egressOffset;
+        uint64_t bytes;             /**< Total region size. */
+    };
+
+    /**
+     * @class SharedMemoryGateway
+     * @brief One process's handle on a gateway region (either end).
+     */
+    class SharedMemoryGateway {
+        private:
+            SharedMemoryRegion region_;
+            SharedRing<OrderRequest> ingress_;
+            SharedRing<ExecutionEvent> egress_;
+
+            unsigned char* base() const { return static_cast<unsigned char*>(region_.data()); }
+
+        public:
+            /**
+             * @brief Engine side: creates the region 'name' (replacing a stale one) and formats both rings.
+             * @param ingressCapacity Request slots (rounded up to a power of two).
+             * @param egressCapacity Event slots (rounded up to a power of two).
+             * @return false if the shm object cannot be created or mapped.
+             */
+            bool create(const std::string& name, size_t ingressCapacity, size_t egressCapacity){
+                const uint64_t ingressOffset = sizeof(GatewayHeader);
+                const uint64_t egressOffset = ingressOffset + SharedRing<OrderRequest>::bytesFor(ingressCapacity);
+                const uint64_t bytes = egressOffset + SharedRing<ExecutionEvent>::bytesFor(egressCapacity);
+                if(!region_.create(name, bytes)) return false;
+
+                ingress_.format(base() + ingressOffset, ingressCapacity);
+                egress_.format(base() + egressOffset, egressCapacity);
+
+                auto* header = new (region_.data()) GatewayHeader{};
+                header->version = GatewayHeader::VERSION;
+                header->ingressOffset = ingressOffset;
+                header->egressOffset = egressOffset;
+                header->bytes = bytes;
+                std::atomic_ref<uint64_t>(header->magic).store(GatewayHeader::MAGIC, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Client side (or a second engine-side handle): maps an existing region and binds both rings.
+             * @return false if it does not exist or was built with a different layout (e.g. another OrderRequest size).
+             */
+            bool attach(const std::string& name){
+                if(!region_.open(name)) return false;
+                const auto* header = static_cast<GatewayHeader*>(region_.data());
+                bool ok = region_.size() >= sizeof(GatewayHeader)
+                       && std::atomic_ref<uint64_t>(const_cast<uint64_t&>(header->magic)).load(std::memory_order_acquire) == GatewayHeader::MAGIC
+                       && header->version == GatewayHeader::VERSION
+                       && header->bytes <= region_.size()
+                       && header->ingressOffset < header->egressOffset && header->egressOffset < header->bytes
+                       && ingress_.bind(base() + header->ingressOffset, header->egressOffset - header->ingressOffset)
+                       && egress_.bind(base() + header->egressOffset, header->bytes - header->egressOffset);
+                if(!ok) region_.close();
+                return ok;
+            }
+
+            bool isOpen() const { return region_.isOpen(); }
+
+            /**
+             * @brief Orders flowing into the engine (client produces, matching thread consumes).
+             */
+            SharedRing<OrderRequest>& ingress() { return ingress_; }
+
+            /**
+             * @brief Events flowing out of the engine (matching thread produces, client consumes).
+             */
+            SharedRing<ExecutionEvent>& egress() { return egress_; }
+    };
+
+    /**
+     * @class SharedMemorySink
+     * @brief Execution Sink that publishes into the egress ring of a gateway region (see BookConfig::gatewayName).
+     * @details Behaves like QueueSink: level updates are coalesced per instruction (LevelCoalescer), and when the client falls
+     * behind the event is dropped and counted rather than blocking the matcher. The sink attaches its own mapping
+     * of the region, so it is the egress producer no matter which handle created it.
+     */
+    class SharedMemorySink {
+        private:
+            SharedMemoryGateway gateway_;
+            uint64_t dropped_ = 0;
+            LevelCoalescer levels_;
+
+            void publish(const ExecutionEvent& event){
+                if(!gateway_.isOpen() || !gateway_.egress().push(event)) [[unlikely]] {
+                    ++dropped_;
+                }
+            }
+
+        public:
+            /**
+             * @brief Attaches to the region named by BookConfig::gatewayName (events are dropped if it is missing).
+             */
+            explicit SharedMemorySink(const BookConfig& config){
+                if(config.gatewayName) gateway_.attach(config.gatewayName);
+            }
+
+            void onTrade(const Trade& trade) { publish(trade); }
+            void onCancel(const Cancel& cancel) { publish(cancel); }
+            void onModify(const Modify& modify) { publish(modify); }
+            void onReject(const Reject& reject) { publish(reject); }
+            void onBookUpdate(const BookUpdate& update){
+                levels_.add(update, [this](const BookUpdate& level){ publish(level); });
+            }
+
+            void onSnapshot(const BookSnapshot& snapshot){
+                flush();
+                publish(snapshot);
+            }
+
+            void flush(){
+                levels_.drain([this](const BookUpdate& level){ publish(level); });
+            }
+
+            /**
+             * @brief Did the sink find its gateway region?
+             */
+            bool isAttached() const { return gateway_.isOpen(); }
+
+            /**
+             * @brief Number of events lost because the client was too slow or no region was attached.
+             */
+            uint64_t getDroppedCount() const { return dropped_; }
+    };
+}
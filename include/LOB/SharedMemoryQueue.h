@@ -0,0 +1,402 @@
+/**
+ * @file SharedMemoryQueue.h
+ * @brief An SPSC ring that lives in a named POSIX shared-memory region, so producer and consumer can be
+ * separate processes.
+ * @details Same protocol as LockFreeQueue (free-running indices, power-of-two mask, acquire/release
+ * publication, cached peer index), with a layout that survives being mapped at different addresses:
+ * 1. **No Pointers:** The region holds a SharedRingHeader followed by the slots. Each process binds its own
+ *    SharedRing view to wherever the region is mapped; only offsets and counters are shared.
+ * 2. **Fixed Layout:** Header fields are 64-bit words, the head and tail counters sit on their own cache lines,
+ *    slots start on a cache line. sizeof(T) is recorded so a mismatched build refuses to attach.
+ * 3. **Process-Local Caches:** The cached peer indices stay in the SharedRing object, never in the region,
+ *    so each side only re-reads the other's counter when its copy says full / empty.
+ * 4. **Pre-Faulted:** SharedMemoryRegion maps with MAP_POPULATE, so the first push does not page-fault.
+ *
+ * T must be trivially copyable (it is memcpy'd between address spaces) and both processes must be built
+ * with the same layout of T (e.g. the same NANOBOOK_LATENCY setting for OrderRequest).
+ */
+#pragma once
+#include <new>
+#include <span>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace LOB {
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory counters must be address-free");
+
+    /**
+     * @class SharedMemoryRegion
+     * @brief RAII owner of one mapping of a named shm object.
+     * @details create() makes a fresh, zeroed object (replacing a stale one left by a crashed owner) and unlinks
+     * it again on close(); open() maps an existing one at whatever size it has.
+     */
+    class SharedMemoryRegion {
+        private:
+            std::string name_;
+            void* base_ = nullptr;
+            size_t bytes_ = 0;
+            bool owner_ = false;
+
+            // Maps and closes 'fd'.
+            bool map(int fd, size_t bytes){
+#if defined(__linux__)
+                void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+                ::close(fd);
+                if(p == MAP_FAILED) return false;
+                base_ = p;
+                bytes_ = bytes;
+                return true;
+#else
+                (void)fd; (void)bytes;
+                return false;
+#endif
+            }
+
+        public:
+            SharedMemoryRegion() = default;
+            ~SharedMemoryRegion(){ close(); }
+
+            SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+            SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+            /**
+             * @brief Creates (or replaces) the object 'name' with 'bytes' zeroed bytes and maps it.
+             * @param name POSIX shm name ("/something").
+             * @return false if the object cannot be created, sized or mapped.
+             */
+            bool create(const std::string& name, size_t bytes){
+                close();
+#if defined(__linux__)
+                shm_unlink(name.c_str());
+                int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                if(fd < 0) return false;
+                if(ftruncate(fd, static_cast<off_t>(bytes)) != 0){
+                    ::close(fd);
+                    shm_unlink(name.c_str());
+                    return false;
+                }
+                if(!map(fd, bytes)){
+                    shm_unlink(name.c_str());
+                    return false;
+                }
+                name_ = name;
+                owner_ = true;
+                return true;
+#else
+                (void)name; (void)bytes;
+                return false;
+#endif
+            }
+
+            /**
+             * @brief Maps an existing object created by another process (or another region object).
+             */
+            bool open(const std::string& name){
+                close();
+#if defined(__linux__)
+                int fd = shm_open(name.c_str(), O_RDWR, 0);
+                if(fd < 0) return false;
+                struct stat info{};
+                if(fstat(fd, &info) != 0 || info.st_size <= 0){
+                    ::close(fd);
+                    return false;
+                }
+                if(!map(fd, static_cast<size_t>(info.st_size))) return false;
+                name_ = name;
+                return true;
+#else
+                (void)name;
+                return false;
+#endif
+            }
+
+            /**
+             * @brief Unmaps the region; the creator also removes the name (mappings in other processes stay valid).
+             */
+            void close(){
+#if defined(__linux__)
+                if(base_) munmap(base_, bytes_);
+                if(owner_) shm_unlink(name_.c_str());
+#endif
+                base_ = nullptr;
+                bytes_ = 0;
+                owner_ = false;
+                name_.clear();
+            }
+
+            void* data() const { return base_; }
+            size_t size() const { return bytes_; }
+            bool isOpen() const { return base_ != nullptr; }
+            bool isOwner() const { return owner_; }
+    };
+
+    /**
+     * @struct SharedRingHeader
+     * @brief The shared control block at the start of every ring.
+     */
+    struct SharedRingHeader {
+        static constexpr uint64_t MAGIC = 0x474E49524D48534Eull;   // "NSHMRING" read as a little-endian word
+        static constexpr uint64_t VERSION = 1;
+
+        uint64_t magic;                                  /**< Written last by format(): the ring is ready. */
+        uint64_t version;
+        uint64_t elementSize;                            /**< sizeof(T) of the creating build. */
+        uint64_t capacity;                               /**< Slots (a power of two). */
+
+        alignas(64) std::atomic<uint64_t> head;          /**< Read index (owned by the consumer). */
+        alignas(64) std::atomic<uint64_t> tail;          /**< Write index (owned by the producer). */
+        std::atomic<uint64_t> fullCount;                 /**< Pushes refused by a full ring (producer-written). */
+    };
+
+    /**
+     * @class SharedRing
+     * @brief One process's view of a ring that lives in shared memory.
+     * @details The API and every memory ordering mirror LockFreeQueue, so a consumer loop written for one
+     * (peek_bulk -> applyBatch -> release) works unchanged on the other.
+     * @note Exactly one process (and thread) pushes and exactly one pops.
+     * @tparam T A trivially copyable message type (OrderRequest, ExecutionEvent).
+     */
+    template <typename T>
+    class SharedRing {
+        static_assert(std::is_trivially_copyable_v<T>, "SharedRing payloads are copied across address spaces");
+
+        private:
+            static constexpr size_t CACHE_LINE = 64;
+
+            SharedRingHeader* header_ = nullptr;
+            T* slots_ = nullptr;
+            size_t capacity_ = 0;
+            size_t mask_ = 0;
+
+            size_t cachedHead_ = 0;    // producer's last view of head
+            size_t cachedTail_ = 0;    // consumer's last view of tail
+
+            static size_t roundUpPow2(size_t n){
+                size_t p = 1;
+                while(p < n) p <<= 1;
+                return p;
+            }
+
+            static size_t slotsOffset(){
+                return (sizeof(SharedRingHeader) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+            }
+
+            void countFull(){
+                header_->fullCount.store(header_->fullCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            void adopt(void* base){
+                header_ = static_cast<SharedRingHeader*>(base);
+                slots_ = reinterpret_cast<T*>(static_cast<unsigned char*>(base) + slotsOffset());
+                capacity_ = static_cast<size_t>(header_->capacity);
+                mask_ = capacity_ - 1;
+                cachedHead_ = header_->head.load(std::memory_order_acquire);
+                cachedTail_ = header_->tail.load(std::memory_order_acquire);
+            }
+
+        public:
+            /**
+             * @brief Bytes a ring of at least 'capacity' slots occupies (header + slots, cache-line multiple).
+             */
+            static size_t bytesFor(size_t capacity){
+                size_t slots = roundUpPow2(capacity) * sizeof(T);
+                return slotsOffset() + (slots + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+            }
+
+            /**
+             * @brief Initializes a ring at 'base' (zeroed, bytesFor(capacity) bytes, 64-byte aligned) and binds to it.
+             */
+            void format(void* base, size_t capacity){
+                auto* header = new (base) SharedRingHeader{};
+                header->version = SharedRingHeader::VERSION;
+                header->elementSize = sizeof(T);
+                header->capacity = roundUpPow2(capacity);
+                std::atomic_ref<uint64_t>(header->magic).store(SharedRingHeader::MAGIC, std::memory_order_release);
+                adopt(base);
+            }
+
+            /**
+             * @brief Binds to a ring another process formatted.
+             * @param bytes Bytes available at 'base' (the ring must fit).
+             * @return false if 'base' holds no ring, a different version, or slots of a different size.
+             */
+            bool bind(void* base, size_t bytes){
+                if(bytes < slotsOffset()) return false;
+                auto* header = static_cast<SharedRingHeader*>(base);
+                if(std::atomic_ref<uint64_t>(header->magic).load(std::memory_order_acquire) != SharedRingHeader::MAGIC) return false;
+                if(header->version != SharedRingHeader::VERSION || header->elementSize != sizeof(T)) return false;
+                if(header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0) return false;
+                if(bytesFor(static_cast<size_t>(header->capacity)) > bytes) return false;
+                adopt(base);
+                return true;
+            }
+
+            bool isBound() const { return header_ != nullptr; }
+
+            // --- Producer ---
+
+            /**
+             * @brief Copies 'item' into the next slot (Producer only).
+             * @return false if the ring is full.
+             */
+            bool push(const T& item){
+                size_t currentTail = header_->tail.load(std::memory_order_relaxed);
+                if(currentTail - cachedHead_ == capacity_){
+                    cachedHead_ = header_->head.load(std::memory_order_acquire);
+                    if(currentTail - cachedHead_ == capacity_){
+                        countFull();
+                        return false;
+                    }
+                }
+                slots_[currentTail & mask_] = item;
+                header_->tail.store(currentTail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pushes up to 'count' items with one tail publication (Producer only).
+             * @return The number of items pushed.
+             */
+            size_t push_bulk(const T* items, size_t count){
+                size_t currentTail = header_->tail.load(std::memory_order_relaxed);
+                size_t space = capacity_ - (currentTail - cachedHead_);
+                if(space < count){
+                    cachedHead_ = header_->head.load(std::memory_order_acquire);
+                    space = capacity_ - (currentTail - cachedHead_);
+                }
+                size_t n = std::min(count, space);
+                if(n < count) countFull();
+                if(n == 0) return 0;
+
+                size_t first = std::min(n, capacity_ - (currentTail & mask_));
+                std::copy_n(items, first, slots_ + (currentTail & mask_));
+                std::copy_n(items + first, n - first, slots_);
+                header_->tail.store(currentTail + n, std::memory_order_release);
+                return n;
+            }
+
+            /**
+             * @brief Reserves the next slot for in-place construction (Producer only), nullptr if full.
+             */
+            T* try_claim(){
+                size_t currentTail = header_->tail.load(std::memory_order_relaxed);
+                if(currentTail - cachedHead_ == capacity_){
+                    cachedHead_ = header_->head.load(std::memory_order_acquire);
+                    if(currentTail - cachedHead_ == capacity_){
+                        countFull();
+                        return nullptr;
+                    }
+                }
+                return &slots_[currentTail & mask_];
+            }
+
+            /**
+             * @brief Reserves up to 'max' consecutive slots (Producer only); see LockFreeQueue::try_claim_bulk().
+             */
+            std::span<T> try_claim_bulk(size_t max){
+                size_t currentTail = header_->tail.load(std::memory_order_relaxed);
+                size_t space = capacity_ - (currentTail - cachedHead_);
+                if(space < max){
+                    cachedHead_ = header_->head.load(std::memory_order_acquire);
+                    space = capacity_ - (currentTail - cachedHead_);
+                    if(space == 0){
+                        countFull();
+                        return {};
+                    }
+                }
+                size_t offset = currentTail & mask_;
+                return std::span<T>(slots_ + offset, std::min({max, space, capacity_ - offset}));
+            }
+
+            /**
+             * @brief Publishes the first 'count' claimed slots (Producer only).
+             */
+            void commit(size_t count = 1){
+                header_->tail.store(header_->tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+
+            // --- Consumer ---
+
+            /**
+             * @brief Copies out the oldest item (Consumer only).
+             * @return false if the ring is empty.
+             */
+            bool pop(T& item){
+                size_t currentHead = header_->head.load(std::memory_order_relaxed);
+                if(currentHead == cachedTail_){
+                    cachedTail_ = header_->tail.load(std::memory_order_acquire);
+                    if(currentHead == cachedTail_) return false;
+                }
+                item = slots_[currentHead & mask_];
+                header_->head.store(currentHead + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pops up to 'max' items with one head publication (Consumer only).
+             */
+            size_t pop_bulk(T* out, size_t max){
+                size_t currentHead = header_->head.load(std::memory_order_relaxed);
+                size_t available = cachedTail_ - currentHead;
+                if(available < max){
+                    cachedTail_ = header_->tail.load(std::memory_order_acquire);
+                    available = cachedTail_ - currentHead;
+                }
+                size_t n = std::min(max, available);
+                if(n == 0) return 0;
+
+                size_t first = std::min(n, capacity_ - (currentHead & mask_));
+                std::copy_n(slots_ + (currentHead & mask_), first, out);
+                std::copy_n(slots_, n - first, out + first);
+                header_->head.store(currentHead + n, std::memory_order_release);
+                return n;
+            }
+
+            /**
+             * @brief Up to 'max' of the oldest items as one contiguous in-place view (Consumer only).
+             * @details Stops at the physical end of the slots, like LockFreeQueue::peek_bulk(). Free with release().
+             */
+            std::span<const T> peek_bulk(size_t max){
+                size_t currentHead = header_->head.load(std::memory_order_relaxed);
+                size_t available = cachedTail_ - currentHead;
+                if(available < max){
+                    cachedTail_ = header_->tail.load(std::memory_order_acquire);
+                    available = cachedTail_ - currentHead;
+                }
+                size_t offset = currentHead & mask_;
+                size_t n = std::min({max, available, capacity_ - offset});
+                return std::span<const T>(slots_ + offset, n);
+            }
+
+            /**
+             * @brief Frees the 'count' oldest slots obtained through peek_bulk() (Consumer only).
+             */
+            void release(size_t count = 1){
+                header_->head.store(header_->head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            }
+
+            // --- Monitoring (any process) ---
+
+            size_t getCapacity() const { return capacity_; }
+
+            size_t size() const {
+                size_t head = header_->head.load(std::memory_order_acquire);
+                return header_->tail.load(std::memory_order_acquire) - head;
+            }
+
+            size_t getFullCount() const { return header_->fullCount.load(std::memory_order_relaxed); }
+    };
+}
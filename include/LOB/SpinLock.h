@@ -42,4 +42,13 @@ namespace LOB{
                 flag.clear(std::memory_order_release);
             }
     };
-}
\ No newline at end of file
+
+    /**
+     * @struct NoLock
+     * @brief Lock policy for books driven by a single thread: lock()/unlock() compile to nothing.
+     */
+    struct NoLock {
+        void lock() {}
+        void unlock() {}
+    };
+}
@@ -0,0 +1,66 @@
+/**
+ * @file ThreadAffinity.h
+ * @brief Thread and memory placement: core pinning, NUMA node lookup and page locking.
+ * @details A matching thread that migrates between cores loses its L1/L2 working set (book levels, pool
+ * slots, queue indices) on every move. Pinning keeps each shard's data hot in one core's caches.
+ * Memory placement then follows from Linux's default first-touch policy: a page is allocated on the NUMA
+ * node of the core that first writes it, so a pinned thread that builds (and pre-touches) its own pools and
+ * queues gets node-local memory without libnuma. lockProcessMemory() finally pins every page in RAM, so no
+ * page fault (or swap-in) ever lands on the hot path.
+ * On platforms without the corresponding API each call is a no-op that reports failure.
+ */
+#pragma once
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace LOB {
+
+    /**
+     * @brief Restricts the calling thread to 'core'.
+     * @param core Zero-based logical CPU number.
+     * @return true if the affinity was applied.
+     */
+    inline bool pinThisThread(unsigned core){
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)core;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief NUMA node of the core the calling thread is running on (stable once pinned).
+     * @return The node, or -1 if unknown.
+     */
+    inline int currentNumaNode(){
+#if defined(__linux__) && defined(SYS_getcpu)
+        unsigned cpu = 0, node = 0;
+        if(syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+        return -1;
+    }
+
+    /**
+     * @brief Locks every current and future page of the process in RAM (mlockall).
+     * @details Call once the books and queues are built: their pages are resident from then on, and later
+     * mappings are faulted in and locked as they are created, never on first access.
+     * @return false without the privilege (CAP_IPC_LOCK) or a large enough RLIMIT_MEMLOCK.
+     */
+    inline bool lockProcessMemory(){
+#if defined(__linux__)
+        return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#else
+        return false;
+#endif
+    }
+}
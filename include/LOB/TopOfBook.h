@@ -0,0 +1,121 @@
+/**
+ * @file TopOfBook.h
+ * @brief Seqlock-published best bid/offer for lock-free readers on other threads.
+ * @details The matching thread is the only writer. After every instruction that changed the BBO it
+ * publishes a Quote into a TopOfBook: one cache line, away from all book state. Any number of readers
+ * (risk checks, dashboards, ThreadSafeOrderBook callers) poll it without a lock and without ever
+ * touching the book's own cache lines:
+ * 1. **Writer:** Bumps the sequence to odd, stores the fields, bumps it to even again. Never waits.
+ * 2. **Reader:** Reads the sequence, the fields, then the sequence again. Equal and even means the copy is
+ *    consistent; otherwise the writer was mid-update and the read is retried (read()) or reported (tryRead()).
+ * The fields are relaxed atomics ordered by fences, so the protocol is data-race free under the C++ memory model.
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "Order.h"
+
+namespace LOB {
+
+    /**
+     * @struct Quote
+     * @brief Best bid and offer. A side with volume 0 is empty (its price and order count are 0 too).
+     */
+    struct Quote {
+        Price bidPrice = 0;
+        Quantity bidVolume = 0;
+        uint32_t bidOrders = 0;
+        Price askPrice = 0;
+        Quantity askVolume = 0;
+        uint32_t askOrders = 0;
+
+        /** Number of BBO changes published so far (the first quote is 1, 0 = nothing published yet). */
+        uint64_t sequence = 0;
+
+        /**
+         * @brief Same BBO (the sequence is not compared).
+         */
+        bool sameLevels(const Quote& other) const {
+            return bidPrice == other.bidPrice && bidVolume == other.bidVolume && bidOrders == other.bidOrders &&
+                   askPrice == other.askPrice && askVolume == other.askVolume && askOrders == other.askOrders;
+        }
+    };
+
+    /**
+     * @class TopOfBook
+     * @brief Single-writer / multi-reader seqlock holding the latest Quote, on its own 64-byte cache line.
+     */
+    class alignas(64) TopOfBook {
+        private:
+            std::atomic<uint64_t> version_{0}; // odd while the writer is mid-update; quote sequence = version / 2
+            std::atomic<uint64_t> bidPrice_{0};
+            std::atomic<uint64_t> bidVolume_{0};
+            std::atomic<uint64_t> askPrice_{0};
+            std::atomic<uint64_t> askVolume_{0};
+            std::atomic<uint64_t> orders_{0};  // bid count << 32 | ask count
+
+            static void cpuRelax(){
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+
+        public:
+            /**
+             * @brief Publishes a new quote. Writer (matching) thread only.
+             * @note quote.sequence is ignored: the sequence is derived from the seqlock version.
+             */
+            void publish(const Quote& quote){
+                uint64_t v = version_.load(std::memory_order_relaxed);
+                version_.store(v + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                bidPrice_.store(quote.bidPrice, std::memory_order_relaxed);
+                bidVolume_.store(quote.bidVolume, std::memory_order_relaxed);
+                askPrice_.store(quote.askPrice, std::memory_order_relaxed);
+                askVolume_.store(quote.askVolume, std::memory_order_relaxed);
+                orders_.store((static_cast<uint64_t>(quote.bidOrders) << 32) | quote.askOrders, std::memory_order_relaxed);
+
+                version_.store(v + 2, std::memory_order_release);
+            }
+
+            /**
+             * @brief One read attempt. Never spins.
+             * @return false if the writer was mid-update ('out' is then unspecified).
+             */
+            bool tryRead(Quote& out) const {
+                uint64_t before = version_.load(std::memory_order_acquire);
+                if(before & 1) return false;
+
+                out.bidPrice = bidPrice_.load(std::memory_order_relaxed);
+                out.bidVolume = bidVolume_.load(std::memory_order_relaxed);
+                out.askPrice = askPrice_.load(std::memory_order_relaxed);
+                out.askVolume = askVolume_.load(std::memory_order_relaxed);
+                uint64_t orders = orders_.load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(version_.load(std::memory_order_relaxed) != before) return false;
+
+                out.bidOrders = static_cast<uint32_t>(orders >> 32);
+                out.askOrders = static_cast<uint32_t>(orders);
+                out.sequence = before / 2;
+                return true;
+            }
+
+            /**
+             * @brief A consistent quote, retrying while the writer is mid-update (a handful of stores).
+             */
+            Quote read() const {
+                Quote quote;
+                while(!tryRead(quote)) cpuRelax();
+                return quote;
+            }
+
+            /**
+             * @brief The sequence of the latest complete quote (cheap change detection for pollers).
+             */
+            uint64_t getSequence() const { return version_.load(std::memory_order_acquire) / 2; }
+    };
+
+    static_assert(sizeof(TopOfBook) == 64, "TopOfBook must occupy exactly one cache line");
+}
@@ -0,0 +1,226 @@
+/**
+ * @file WireProtocol.h
+ * @brief Fixed-layout binary order-entry protocol and its zero-copy decoder.
+ * @details Every message starts with a 4-byte header and has one fixed length per type:
+ *
+ * | Message       | type | Bytes | Layout after the header                                               |
+ * | :---          | :--- | :---  | :---                                                                  |
+ * | NewOrder      | 'N'  | 40    | symbol u32, id u64, price u64, quantity u64, side u8, orderType u8, 6 reserved |
+ * | ModifyOrder   | 'M'  | 32    | symbol u32, id u64, price u64, quantity u64                           |
+ * | CancelOrder   | 'X'  | 16    | symbol u32, id u64                                                    |
+ *
+ * The header is length u16 (whole message, header included), type u8, reserved u8. All fields are
+ * little-endian and naturally aligned, so a sender may write the structs below as they are.
+ *
+ * decodeOrderEntry() walks a receive buffer holding any number of messages and decodes each one straight into
+ * an OrderRequest slot claimed from the ingress queue (try_claim_bulk), publishing the whole run with one
+ * commit(). Nothing is allocated and no intermediate message is built:
+ * 1. **Framing:** A length below the header size or above MAX_MESSAGE_SIZE cannot be resynchronized: decoding
+ *    stops with framingError (the session should be dropped). A message cut off at the end of the buffer is
+ *    left unconsumed for the next receive.
+ * 2. **Validation:** A known length with an unknown type, the wrong length for its type, a bad side or order
+ *    type, or an order of zero quantity is skipped and counted in 'invalid'; the rest of the batch still flows.
+ * 3. **Back-Pressure:** When the queue is full, decoding stops before the first message that found no slot;
+ *    'consumed' tells the caller where to resume.
+ */
+#pragma once
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "Order.h"
+#include "OrderRequest.h"
+
+namespace LOB {
+
+    namespace Wire {
+
+        constexpr size_t HEADER_SIZE = 4;
+        constexpr size_t MAX_MESSAGE_SIZE = 64;
+        constexpr size_t MIN_MESSAGE_SIZE = 16;   // CancelOrder: bounds the messages a buffer can hold
+
+        enum MessageType : uint8_t {
+            NewOrderType = 'N',
+            ModifyOrderType = 'M',
+            CancelOrderType = 'X'
+        };
+
+        struct Header {
+            uint16_t length;
+            uint8_t type;
+            uint8_t reserved = 0;
+        };
+
+        struct NewOrder {
+            Header header{sizeof(NewOrder), NewOrderType};
+            SymbolId symbol = 0;
+            OrderId id = 0;
+            Price price = 0;
+            Quantity quantity = 0;
+            uint8_t side = 0;          /**< Side: 0 Buy, 1 Sell. */
+            uint8_t orderType = 0;     /**< OrderType: 0 Limit, 1 Market, 2 IOC, 3 FOK. */
+            uint8_t reserved[6] = {};
+        };
+
+        struct ModifyOrder {
+            Header header{sizeof(ModifyOrder), ModifyOrderType};
+            SymbolId symbol = 0;
+            OrderId id = 0;
+            Price price = 0;
+            Quantity quantity = 0;     /**< 0 cancels the order (as OrderBook::modifyOrder does). */
+        };
+
+        struct CancelOrder {
+            Header header{sizeof(CancelOrder), CancelOrderType};
+            SymbolId symbol = 0;
+            OrderId id = 0;
+        };
+
+        static_assert(sizeof(Header) == HEADER_SIZE, "Wire::Header is a wire format");
+        static_assert(sizeof(NewOrder) == 40, "Wire::NewOrder is a wire format");
+        static_assert(sizeof(ModifyOrder) == 32, "Wire::ModifyOrder is a wire format");
+        static_assert(sizeof(CancelOrder) == 16, "Wire::CancelOrder is a wire format");
+
+        // Field offsets (the decoder reads the buffer in place, without assuming its alignment).
+        constexpr size_t SYMBOL_AT = 4, ID_AT = 8, PRICE_AT = 16, QUANTITY_AT = 24, SIDE_AT = 32, ORDER_TYPE_AT = 33;
+
+        template <typename Field>
+        inline Field read(const unsigned char* p){
+            Field value;
+            std::memcpy(&value, p, sizeof(Field));
+            return value;
+        }
+
+        /**
+         * @brief The only valid length of each message type (0 for an unknown type).
+         */
+        constexpr size_t expectedLength(uint8_t type){
+            switch(type){
+                case NewOrderType:    return sizeof(NewOrder);
+                case ModifyOrderType: return sizeof(ModifyOrder);
+                case CancelOrderType: return sizeof(CancelOrder);
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Validates one complete message and writes the request it encodes.
+         * @return false if the message is invalid ('out' is then unspecified).
+         */
+        inline bool decodeMessage(const unsigned char* p, size_t length, OrderRequest& out){
+            const uint8_t type = p[2];
+            if(length != expectedLength(type)) return false;
+
+            out.symbol = read<SymbolId>(p + SYMBOL_AT);
+            out.id = read<OrderId>(p + ID_AT);
+            switch(type){
+                case NewOrderType: {
+                    const uint8_t side = p[SIDE_AT];
+                    const uint8_t orderType = p[ORDER_TYPE_AT];
+                    if(side > 1 || orderType > static_cast<uint8_t>(OrderType::FillOrKill)) return false;
+                    out.price = read<Price>(p + PRICE_AT);
+                    out.qty = read<Quantity>(p + QUANTITY_AT);
+                    if(out.qty == 0) return false;
+                    out.side = side == 0 ? Side::Buy : Side::Sell;
+                    out.type = RequestType::Add;
+                    out.orderType = static_cast<OrderType>(orderType);
+                    return true;
+                }
+                case ModifyOrderType:
+                    out.price = read<Price>(p + PRICE_AT);
+                    out.qty = read<Quantity>(p + QUANTITY_AT);
+                    out.side = Side::Buy;
+                    out.type = RequestType::Modify;
+                    out.orderType = OrderType::Limit;
+                    return true;
+                default:
+                    out.price = 0;
+                    out.qty = 0;
+                    out.side = Side::Buy;
+                    out.type = RequestType::Cancel;
+                    out.orderType = OrderType::Limit;
+                    return true;
+            }
+        }
+    }
+
+    /**
+     * @struct DecodeResult
+     * @brief What one decodeOrderEntry() call did with its buffer.
+     */
+    struct DecodeResult {
+        size_t consumed = 0;        /**< Bytes fully handled (decoded or skipped); resume from here. */
+        size_t decoded = 0;         /**< Requests published to the queue. */
+        size_t invalid = 0;         /**< Well-framed messages skipped by validation. */
+        bool framingError = false;  /**< An impossible length was found at 'consumed'. */
+        bool queueFull = false;     /**< Stopped at 'consumed' for lack of a free slot. */
+    };
+
+    /**
+     * @brief Decodes every complete message in 'bytes' into slots claimed from 'queue'.
+     * @tparam Queue LockFreeQueue<OrderRequest> or SharedRing<OrderRequest> (anything with try_claim_bulk / commit).
+     * @note Producer side of 'queue' only. Each published request is push-stamped (NANOBOOK_LATENCY builds).
+     */
+    template <typename Queue>
+    DecodeResult decodeOrderEntry(std::span<const unsigned char> bytes, Queue& queue){
+        DecodeResult result;
+        const unsigned char* p = bytes.data();
+        size_t left = bytes.size();
+
+        // Slots of the current claim: filled from the front, published together.
+        std::span<OrderRequest> slots;
+        size_t used = 0;
+
+        while(left >= Wire::HEADER_SIZE){
+            const size_t length = Wire::read<uint16_t>(p);
+            if(length < Wire::HEADER_SIZE || length > Wire::MAX_MESSAGE_SIZE){
+                result.framingError = true;
+                break;
+            }
+            if(length > left) break;   // cut off: wait for the rest
+
+            // 1. Out of claimed slots: publish what we have and claim the next run.
+            if(used == slots.size()){
+                if(used > 0){
+                    queue.commit(used);
+                    result.decoded += used;
+                }
+                slots = queue.try_claim_bulk((left + Wire::MIN_MESSAGE_SIZE - 1) / Wire::MIN_MESSAGE_SIZE);
+                used = 0;
+                if(slots.empty()){
+                    result.queueFull = true;
+                    break;
+                }
+            }
+
+            // 2. Decode in place; an invalid message simply leaves its slot for the next one.
+            OrderRequest& slot = slots[used];
+            if(Wire::decodeMessage(p, length, slot)){
+                stampSent(slot);
+                ++used;
+            }
+            else{
+                ++result.invalid;
+            }
+            p += length;
+            left -= length;
+            result.consumed += length;
+        }
+
+        if(used > 0){
+            queue.commit(used);
+            result.decoded += used;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Appends the wire image of a message to 'out' (clients, tests and tools).
+     * @return Bytes written (sizeof(Message)); 'out' must have room for it.
+     */
+    template <typename Message>
+    size_t encodeMessage(const Message& message, unsigned char* out){
+        std::memcpy(out, &message, sizeof(Message));
+        return sizeof(Message);
+    }
+}
@@ -5,11 +5,33 @@
  * This file uses Google Benchmark to compare:
  * 1. Standard Heap Allocation (new/delete) -> Involves syscalls and mutexes in malloc.
  * 2. Custom Object Pool (Slab Allocator) -> Involves only pointer arithmetic (LIFO).
+ * 3. LimitLevel churn at the touch -> heap vs pool, and through a full OrderBook.
+ * 4. Queue walks through a deep level -> 48-byte pointer-linked Order vs 32-byte index-linked CompactOrder.
+ * 5. Batch submission -> addOrder() one by one vs addOrders() over the same burst.
+ * 6. SPSC ring throughput -> one producer thread, one consumer thread, OrderRequest payload (single vs bulk).
+ * 7. Multi-producer ingress -> 4 threads on a SpinLock-wrapped ThreadSafeOrderBook vs 4 gateway lanes feeding one engine thread.
+ * 8. Symbol sharding -> the same multi-symbol stream through an Engine with 1, 2 and 4 matching threads.
+ * 9. Top-of-book reads -> seqlock TopOfBook::read() vs taking the SpinLock, while another thread keeps trading.
  * * Expected Result: The ObjectPool should be 10x-50x faster than the heap.
  */
 #include <benchmark/benchmark.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
 #include "LOB/Order.h"
 #include "LOB/ObjectPool.h"
+#include "LOB/LimitLevel.h"
+#include "LOB/OrderBook.h"
+#include "LOB/CompactOrder.h"
+#include "LOB/LockFreeQueue.h"
+#include "LOB/OrderRequest.h"
+#include "LOB/ThreadSafeOrderBook.h"
+#include "LOB/TopOfBook.h"
+#include "LOB/GatewayIngress.h"
+#include "LOB/Engine.h"
 
 /**
  * @brief Benchmark 1: Standard C++ Heap Allocation
@@ -53,5 +75,405 @@ static void BM_ObjectPool(benchmark::State& state){
 }
 BENCHMARK(BM_ObjectPool);
 
+/**
+ * @brief Benchmark 3: LimitLevel created/destroyed with new/delete
+ * @details What MapPriceLadder used to do every time a price level appeared or emptied.
+ */
+static void BM_LimitLevelHeap(benchmark::State& state){
+    for(auto _ : state){
+        LOB::LimitLevel* level = new LOB::LimitLevel(100);
+        benchmark::DoNotOptimize(level);
+        delete level;
+    }
+}
+BENCHMARK(BM_LimitLevelHeap);
+
+/**
+ * @brief Benchmark 4: LimitLevel recycled through an ObjectPool
+ */
+static void BM_LimitLevelPool(benchmark::State& state){
+    LOB::ObjectPool<LOB::LimitLevel> pool(1024);
+
+    for(auto _ : state){
+        LOB::LimitLevel* level = pool.allocate(100);
+        benchmark::DoNotOptimize(level);
+        pool.deallocate(level);
+    }
+}
+BENCHMARK(BM_LimitLevelPool);
+
+/**
+ * @brief Benchmark 5: Level flicker through the full engine
+ * @details Every iteration posts an order at a fresh price inside the spread and cancels it:
+ * the level is created and destroyed each time, exactly like quotes flickering at the touch.
+ * Run for both Price Ladder backends (events go to a NullSink).
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_LevelFlicker(benchmark::State& state){
+    LOB::BasicOrderBook<Ladder, LOB::OrderIndex, LOB::NullSink> book;
+
+    // Resting liquidity on both sides keeps the maps non-trivial.
+    for(LOB::OrderId i = 0; i < 64; ++i){
+        book.addOrder(1000000 + i, 900 - i, 10, LOB::Side::Buy);
+        book.addOrder(2000000 + i, 1100 + i, 10, LOB::Side::Sell);
+    }
+
+    LOB::OrderId id = 0;
+    for(auto _ : state){
+        book.addOrder(id, 1000, 10, LOB::Side::Buy);
+        book.cancelOrder(id);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LevelFlicker, LOB::MapPriceLadder);
+BENCHMARK_TEMPLATE(BM_LevelFlicker, LOB::FlatPriceLadder);
+
+/**
+ * @brief Random arrival order, so that walking the FIFO jumps around the pool like a real deep book.
+ */
+static std::vector<size_t> shuffledSlots(size_t n){
+    std::vector<size_t> slots(n);
+    for(size_t i = 0; i < n; ++i) slots[i] = i;
+    std::shuffle(slots.begin(), slots.end(), std::mt19937(1));
+    return slots;
+}
+
+/**
+ * @brief Benchmark 6: Walk a deep level of default (48-byte, pointer-linked) Orders
+ * @details Mirrors the queue walk at the heart of match(): follow 'next' and read the quantity.
+ */
+static void BM_QueueWalkOrder(benchmark::State& state){
+    size_t depth = static_cast<size_t>(state.range(0));
+    LOB::ObjectPool<LOB::Order> pool(depth);
+    std::vector<LOB::Order*> orders(depth);
+    for(size_t i = 0; i < depth; ++i) orders[i] = pool.allocate(i, 100, 1 + i % 7, LOB::Side::Sell);
+
+    LOB::LimitLevel level(100);
+    for(size_t slot : shuffledSlots(depth)) level.append(orders[slot]);
+
+    for(auto _ : state){
+        LOB::Quantity total = 0;
+        for(LOB::Order* o = level.getHead(); o; o = o->next) total += o->quantity;
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+BENCHMARK(BM_QueueWalkOrder)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+/**
+ * @brief Benchmark 7: Same walk over 32-byte CompactOrders linked by 32-bit IndexPool handles
+ */
+static void BM_QueueWalkCompact(benchmark::State& state){
+    using Compact = LOB::CompactOrder<uint64_t, uint64_t>;
+    size_t depth = static_cast<size_t>(state.range(0));
+    LOB::IndexPool<Compact> pool(depth);
+    std::vector<uint32_t> orders(depth);
+    for(size_t i = 0; i < depth; ++i) orders[i] = pool.allocate(i, 100, 1 + i % 7, LOB::Side::Sell);
+
+    LOB::CompactLevel<Compact> level(100);
+    for(size_t slot : shuffledSlots(depth)) level.append(orders[slot], pool);
+
+    for(auto _ : state){
+        LOB::Quantity total = 0;
+        for(uint32_t i = level.getHead(); i != Compact::NIL; i = pool[i].next) total += pool[i].quantity;
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+BENCHMARK(BM_QueueWalkCompact)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+/**
+ * @brief A passive burst (no crossing), spread over 64 price levels per side.
+ */
+static std::vector<LOB::OrderRequest> passiveBurst(size_t n){
+    std::vector<LOB::OrderRequest> burst;
+    std::mt19937 gen(3);
+    for(size_t i = 0; i < n; ++i){
+        bool buy = gen() % 2;
+        LOB::Price offset = gen() % 64;
+        burst.push_back({i, buy ? 999 - offset : 1001 + offset, 10, buy ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add});
+    }
+    return burst;
+}
+
+/**
+ * @brief Benchmark 8: One addOrder() call (and one match() attempt) per order
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_SubmitSequential(benchmark::State& state){
+    auto burst = passiveBurst(static_cast<size_t>(state.range(0)));
+    LOB::BookConfig config;
+    config.orderPoolCapacity = burst.size();
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::BasicOrderBook<Ladder, LOB::OrderIndex, LOB::NullSink>>(config);
+        state.ResumeTiming();
+
+        for(const auto& r : burst) book->addOrder(r.id, r.price, r.qty, r.side);
+        benchmark::ClobberMemory();
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * burst.size());
+}
+BENCHMARK_TEMPLATE(BM_SubmitSequential, LOB::MapPriceLadder)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SubmitSequential, LOB::FlatPriceLadder)->Arg(4096);
+
+/**
+ * @brief Benchmark 9: The same burst through addOrders() (prefetching, match only on a cross)
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_SubmitBatch(benchmark::State& state){
+    auto burst = passiveBurst(static_cast<size_t>(state.range(0)));
+    LOB::BookConfig config;
+    config.orderPoolCapacity = burst.size();
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::BasicOrderBook<Ladder, LOB::OrderIndex, LOB::NullSink>>(config);
+        state.ResumeTiming();
+
+        book->addOrders(burst);
+        benchmark::ClobberMemory();
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * burst.size());
+}
+BENCHMARK_TEMPLATE(BM_SubmitBatch, LOB::MapPriceLadder)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SubmitBatch, LOB::FlatPriceLadder)->Arg(4096);
+
+/**
+ * @brief Benchmark 10: Messages per second through the SPSC ring (producer runs on a second thread)
+ */
+static void BM_QueueThroughput(benchmark::State& state){
+    const size_t messages = 1 << 20;
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(static_cast<size_t>(state.range(0)));
+
+    for(auto _ : state){
+        std::thread producer([&]{
+            LOB::OrderRequest req{0, 100, 10, LOB::Side::Buy, LOB::RequestType::Add};
+            for(size_t i = 0; i < messages; ++i){
+                req.id = i;
+                while(!queue.push(req)) std::this_thread::yield();
+            }
+        });
+
+        LOB::OrderRequest req;
+        for(size_t received = 0; received < messages;){
+            if(queue.pop(req)) ++received;
+            else std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(req);
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * messages);
+}
+BENCHMARK(BM_QueueThroughput)->Arg(1024)->Arg(65536)->UseRealTime();
+
+/**
+ * @brief Benchmark 11: Same traffic as Benchmark 10, moved in batches of state.range(1) with one index update each
+ */
+static void BM_QueueThroughputBulk(benchmark::State& state){
+    const size_t messages = 1 << 20;
+    const size_t batch = static_cast<size_t>(state.range(1));
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(static_cast<size_t>(state.range(0)));
+
+    for(auto _ : state){
+        std::thread producer([&]{
+            std::vector<LOB::OrderRequest> chunk(batch, {0, 100, 10, LOB::Side::Buy, LOB::RequestType::Add});
+            for(size_t sent = 0; sent < messages;){
+                for(size_t k = 0; k < batch; ++k) chunk[k].id = sent + k;
+                size_t n = queue.push_bulk(chunk.data(), std::min(batch, messages - sent));
+                if(n == 0) std::this_thread::yield();
+                sent += n;
+            }
+        });
+
+        std::vector<LOB::OrderRequest> out(batch);
+        for(size_t received = 0; received < messages;){
+            size_t n = queue.pop_bulk(out.data(), batch);
+            if(n == 0) std::this_thread::yield();
+            received += n;
+        }
+        benchmark::DoNotOptimize(out.data());
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * messages);
+}
+BENCHMARK(BM_QueueThroughputBulk)->Args({1024, 64})->Args({65536, 256})->UseRealTime();
+
+static constexpr int INGRESS_THREADS = 4;
+static constexpr int INGRESS_ORDERS = 20000;
+
+static LOB::OrderRequest ingressOrder(int thread, int i){
+    return {static_cast<LOB::OrderId>(thread * 1000000 + i), 100 + static_cast<LOB::Price>(i % 5), 10,
+            (i % 2 == 0) ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add};
+}
+
+/**
+ * @brief Benchmark 12: Every trader thread takes the SpinLock and runs the matcher itself
+ */
+static void BM_IngressSpinLock(benchmark::State& state){
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::ThreadSafeOrderBook>();
+        state.ResumeTiming();
+
+        std::vector<std::thread> traders;
+        for(int t = 0; t < INGRESS_THREADS; ++t){
+            traders.emplace_back([&, t]{
+                for(int i = 0; i < INGRESS_ORDERS; ++i){
+                    LOB::OrderRequest r = ingressOrder(t, i);
+                    book->addOrder(r.id, r.price, r.qty, r.side);
+                }
+            });
+        }
+        for(auto& th : traders) th.join();
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * INGRESS_THREADS * INGRESS_ORDERS);
+}
+BENCHMARK(BM_IngressSpinLock)->UseRealTime();
+
+/**
+ * @brief Benchmark 13: Trader threads only push into their own lane; one engine thread owns the book
+ */
+static void BM_IngressGatewayLanes(benchmark::State& state){
+    LOB::BookConfig config;
+    config.orderPoolCapacity = INGRESS_THREADS * INGRESS_ORDERS;
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::OrderIndex, LOB::NullSink>>(config);
+        LOB::GatewayIngress<LOB::OrderRequest> ingress(INGRESS_THREADS, 1024);
+        std::atomic<int> done{0};
+        state.ResumeTiming();
+
+        std::vector<std::thread> gateways;
+        for(int t = 0; t < INGRESS_THREADS; ++t){
+            gateways.emplace_back([&, t]{
+                auto& lane = ingress.lane(t);
+                for(int i = 0; i < INGRESS_ORDERS; ++i){
+                    while(!lane.push(ingressOrder(t, i))) std::this_thread::yield();
+                }
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        while(true){
+            bool finished = done.load(std::memory_order_acquire) == INGRESS_THREADS;
+            size_t n = ingress.poll([&](std::span<const LOB::OrderRequest> batch, size_t){ book->applyBatch(batch); });
+            if(n == 0){
+                if(finished) break;
+                std::this_thread::yield();
+            }
+        }
+        for(auto& th : gateways) th.join();
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * INGRESS_THREADS * INGRESS_ORDERS);
+}
+BENCHMARK(BM_IngressGatewayLanes)->UseRealTime();
+
+/**
+ * @brief Benchmark 14: 64 symbols, round-robin traffic, state.range(0) shards (scales with free cores)
+ */
+static void BM_EngineShards(benchmark::State& state){
+    constexpr LOB::SymbolId SYMBOLS = 64;
+    constexpr size_t MESSAGES = 1 << 18;
+
+    LOB::EngineConfig config;
+    config.shardCount = static_cast<size_t>(state.range(0));
+    config.book.orderPoolCapacity = MESSAGES / SYMBOLS;
+    config.book.orderPoolGrowable = true;
+
+    std::vector<LOB::OrderRequest> stream;
+    std::mt19937 gen(5);
+    for(size_t i = 0; i < MESSAGES; ++i){
+        bool buy = gen() % 2;
+        stream.push_back({i, 100 + gen() % 8, 10, buy ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add,
+                          LOB::OrderType::Limit, static_cast<LOB::SymbolId>(i % SYMBOLS)});
+    }
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto engine = std::make_unique<LOB::SilentEngine>(config);
+        for(LOB::SymbolId s = 0; s < SYMBOLS; ++s) engine->addSymbol(s);
+        engine->start();
+        state.ResumeTiming();
+
+        for(const auto& r : stream){
+            while(!engine->submit(r)) std::this_thread::yield();
+        }
+        engine->stop();
+
+        state.PauseTiming();
+        engine.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_EngineShards)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
 // Main function required by Google Benchmark
+/**
+ * @brief Benchmark 9: Reader polling the BBO of a book that a second thread keeps updating
+ * @details state.range(0): 0 = lock-free ThreadSafeOrderBook::getQuote(), 1 = SpinLock-guarded read of the book.
+ */
+static void BM_TopOfBookRead(benchmark::State& state){
+    const bool locked = state.range(0) != 0;
+    LOB::ThreadSafeOrderBook book;
+    LOB::SpinLock lock;
+    LOB::BookConfig config;
+    LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::OrderIndex, LOB::NullSink> guarded(config);
+    std::atomic<bool> stop{false};
+
+    // Writer: flickers the best bid so quotes keep changing
+    std::thread writer([&]{
+        for(LOB::OrderId id = 0; !stop.load(std::memory_order_relaxed); ++id){
+            if(locked){
+                lock.lock();
+                guarded.addOrder(id, 100, 10, LOB::Side::Buy);
+                guarded.cancelOrder(id);
+                lock.unlock();
+            }
+            else{
+                book.addOrder(id, 100, 10, LOB::Side::Buy);
+                book.cancelOrder(id);
+            }
+            if((id & 63) == 0) std::this_thread::yield();
+        }
+    });
+
+    LOB::Quantity seen = 0;
+    for(auto _ : state){
+        if(locked){
+            lock.lock();
+            const LOB::LimitLevel* bid = guarded.getBestBid();
+            seen += bid ? bid->getVolume() : 0;
+            lock.unlock();
+        }
+        else{
+            seen += book.getQuote().bidVolume;
+        }
+    }
+    benchmark::DoNotOptimize(seen);
+    stop.store(true);
+    writer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TopOfBookRead)->Arg(0)->Arg(1)->UseRealTime();
+
 BENCHMARK_MAIN();
\ No newline at end of file
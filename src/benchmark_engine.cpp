@@ -0,0 +1,504 @@
+/**
+ * @file benchmark_engine.cpp
+ * @brief End-to-end benchmarks driving the matching engine with realistic order flow.
+ * @details
+ * Complements the component micro-benchmarks in benchmark.cpp. Every book benchmark is run for both
+ * Price Ladder backends (events go to a NullSink) and reports items/sec:
+ * 1. Passive inserts into a book that is already state.range(0) levels deep.
+ * 2. Aggressive orders sweeping state.range(0) price levels each, as resting Limit or as IOC orders.
+ * 3. Add/cancel flow with a state.range(0)% cancel rate (real HFT traffic is ~90% cancels).
+ * 4. Cancel + replace on a 64k-order book, hot IDs (state.range(0) == 0) vs random IDs (== 1).
+ * 5. LockFreeQueue ping-pong: one round trip between two threads (latency, not throughput).
+ * 6. Amendments on a 64k-order book: native modifyOrder() vs cancel + add (size-down and reprice).
+ * 7. Replay: the cancel-heavy flow as fixed-width ReplayRecords through the Replayer (max speed).
+ * 8. Warm restart: rebuilding a book from its full journal vs from a snapshot + the last 1% of the journal.
+ * 9. Policy sweep: the 90% cancel flow through every ladder x index x sink x lock BasicOrderBook instantiation.
+ * 10. Deep sweep: one order consuming 8 levels of state.range(0) small resting orders each, scattered in the pool.
+ * 11. Pre-trade risk: the 90% cancel flow straight into the book vs through a RiskGate with every limit armed.
+ * 12. Depth queries: estimateFill() / FOK pre-checks reaching state.range(0) levels, and getVolumeWithin() over as many ticks.
+ */
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <random>
+#include <memory>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#include "LOB/OrderBook.h"
+#include "LOB/LockFreeQueue.h"
+#include "LOB/Replayer.h"
+#include "LOB/Persistence.h"
+#include "LOB/SpinLock.h"
+#include "LOB/RiskGate.h"
+
+namespace {
+
+    template <template <LOB::Side> class Ladder>
+    using BenchBook = LOB::BasicOrderBook<Ladder, LOB::OrderIndex, LOB::NullSink>;
+
+    constexpr LOB::Price MID = 100000;
+
+    LOB::BookConfig benchConfig(size_t orders){
+        LOB::BookConfig config;
+        config.orderPoolCapacity = orders;
+        config.ladderTicks = 1 << 16;
+        return config;
+    }
+}
+
+/**
+ * @brief Benchmark 1: 1024 passive bids per iteration, at random prices among 'depth' existing levels
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_PassiveInsert(benchmark::State& state){
+    const LOB::Price depth = static_cast<LOB::Price>(state.range(0));
+    constexpr size_t BURST = 1024;
+
+    BenchBook<Ladder> book(benchConfig(depth * 2 + BURST));
+    LOB::OrderId id = 0;
+    for(LOB::Price level = 0; level < depth; ++level){
+        book.addOrder(id++, MID - 1 - level, 10, LOB::Side::Buy);
+        book.addOrder(id++, MID + 1 + level, 10, LOB::Side::Sell);
+    }
+
+    std::mt19937 gen(1);
+    std::vector<LOB::Price> prices(BURST);
+    for(auto& p : prices) p = MID - 1 - gen() % depth;
+
+    for(auto _ : state){
+        LOB::OrderId first = id;
+        for(LOB::Price p : prices) book.addOrder(id++, p, 10, LOB::Side::Buy);
+
+        state.PauseTiming();
+        for(LOB::OrderId done = first; done < id; ++done) book.cancelOrder(done);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK_TEMPLATE(BM_PassiveInsert, LOB::MapPriceLadder)->Arg(1)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_PassiveInsert, LOB::FlatPriceLadder)->Arg(1)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief Benchmark 2: 64 buy orders per iteration, each consuming the next 'K' one-order ask levels
+ * @details state.range(1): 0 = Limit (posted, then matched), 1 = ImmediateOrCancel (matched directly).
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_AggressiveSweep(benchmark::State& state){
+    const LOB::Price K = static_cast<LOB::Price>(state.range(0));
+    constexpr LOB::Price SWEEPS = 64;
+    const LOB::OrderType type = state.range(1) ? LOB::OrderType::ImmediateOrCancel : LOB::OrderType::Limit;
+
+    BenchBook<Ladder> book(benchConfig(SWEEPS * K + 2)); // + the far bid + the incoming sweeper
+    book.addOrder(0, MID - 1000, 10, LOB::Side::Buy); // a resting bid far away keeps the bid side non-empty
+    LOB::OrderId id = 1;
+
+    for(auto _ : state){
+        state.PauseTiming();
+        for(LOB::Price level = 0; level < SWEEPS * K; ++level){
+            book.addOrder(id++, MID + level, 10, LOB::Side::Sell);
+        }
+        state.ResumeTiming();
+
+        for(LOB::Price sweep = 0; sweep < SWEEPS; ++sweep){
+            book.addOrder(id++, MID + (sweep + 1) * K - 1, 10 * K, LOB::Side::Buy, type);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * SWEEPS);
+    state.counters["levels/s"] = benchmark::Counter(static_cast<double>(state.iterations() * SWEEPS * K), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_AggressiveSweep, LOB::MapPriceLadder)->ArgsProduct({{1, 8, 64}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_AggressiveSweep, LOB::FlatPriceLadder)->ArgsProduct({{1, 8, 64}, {0, 1}});
+
+/**
+ * @brief Builds a valid add/cancel stream: each op cancels a random live order with probability 'cancelPct'.
+ * @details Adds are passive (bids below / asks above the mid, within 32 ticks), so the book never trades
+ * and every cancel targets an order that is still resting.
+ */
+static std::vector<LOB::OrderRequest> cancelHeavyFlow(size_t ops, unsigned cancelPct){
+    std::vector<LOB::OrderRequest> flow;
+    std::vector<LOB::OrderId> live;
+    std::mt19937 gen(7);
+    LOB::OrderId next = 0;
+
+    // No cancels until the book is a few hundred orders deep.
+    while(flow.size() < ops){
+        if(live.size() > 256 && gen() % 100 < cancelPct){
+            size_t pick = gen() % live.size();
+            flow.push_back({live[pick], 0, 0, LOB::Side::Buy, LOB::RequestType::Cancel});
+            live[pick] = live.back();
+            live.pop_back();
+        }
+        else{
+            bool buy = gen() % 2;
+            LOB::Price offset = 1 + gen() % 32;
+            flow.push_back({next, buy ? MID - offset : MID + offset, 1 + gen() % 100,
+                            buy ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add});
+            live.push_back(next++);
+        }
+    }
+    return flow;
+}
+
+/**
+ * @brief Benchmark 3: Replays the cancel-heavy stream through addOrder()/cancelOrder()
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_CancelHeavyFlow(benchmark::State& state){
+    constexpr size_t OPS = 1 << 16;
+    auto flow = cancelHeavyFlow(OPS, static_cast<unsigned>(state.range(0)));
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<BenchBook<Ladder>>(benchConfig(OPS));
+        state.ResumeTiming();
+
+        for(const auto& r : flow){
+            if(r.type == LOB::RequestType::Cancel) book->cancelOrder(r.id);
+            else book->addOrder(r.id, r.price, r.qty, r.side);
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * OPS);
+}
+BENCHMARK_TEMPLATE(BM_CancelHeavyFlow, LOB::MapPriceLadder)->Arg(50)->Arg(90)->Arg(98);
+BENCHMARK_TEMPLATE(BM_CancelHeavyFlow, LOB::FlatPriceLadder)->Arg(50)->Arg(90)->Arg(98);
+
+/**
+ * @brief Benchmark 4: Cancel + re-add on a 64k-order book; hot IDs stay in cache, random IDs miss
+ * @details state.range(0): 0 = cycle through 16 recently used slots, 1 = uniform over all 64k orders.
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_CancelHotVsRandom(benchmark::State& state){
+    constexpr size_t RESTING = 1 << 16;
+    const bool random = state.range(0) != 0;
+
+    BenchBook<Ladder> book(benchConfig(RESTING));
+    std::vector<LOB::OrderId> slotId(RESTING);
+    std::vector<LOB::Price> slotPrice(RESTING);
+    std::mt19937 gen(9);
+    for(size_t i = 0; i < RESTING; ++i){
+        slotId[i] = i;
+        slotPrice[i] = MID - 1 - gen() % 256;
+        book.addOrder(slotId[i], slotPrice[i], 10, LOB::Side::Buy);
+    }
+
+    std::vector<size_t> picks(4096);
+    for(size_t i = 0; i < picks.size(); ++i) picks[i] = random ? gen() % RESTING : i % 16;
+
+    LOB::OrderId next = RESTING;
+    size_t k = 0;
+    for(auto _ : state){
+        size_t slot = picks[k++ & (picks.size() - 1)];
+        book.cancelOrder(slotId[slot]);
+        slotId[slot] = next++;
+        book.addOrder(slotId[slot], slotPrice[slot], 10, LOB::Side::Buy);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK_TEMPLATE(BM_CancelHotVsRandom, LOB::MapPriceLadder)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_CancelHotVsRandom, LOB::FlatPriceLadder)->Arg(0)->Arg(1);
+
+/**
+ * @brief Benchmark 5: Round trip through two SPSC rings (ping on one, pong on the other)
+ * @details Each iteration does state.range(0) round trips; the reported time per item is one round trip.
+ */
+static void BM_QueuePingPong(benchmark::State& state){
+    const size_t trips = static_cast<size_t>(state.range(0));
+    LOB::LockFreeQueue<uint64_t> ping(64), pong(64);
+
+    for(auto _ : state){
+        std::thread echo([&]{
+            uint64_t v;
+            for(size_t i = 0; i < trips; ++i){
+                while(!ping.pop(v)) std::this_thread::yield();
+                while(!pong.push(v)) std::this_thread::yield();
+            }
+        });
+
+        uint64_t v = 0;
+        for(size_t i = 0; i < trips; ++i){
+            while(!ping.push(i)) std::this_thread::yield();
+            while(!pong.pop(v)) std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(v);
+        echo.join();
+    }
+    state.SetItemsProcessed(state.iterations() * trips);
+}
+BENCHMARK(BM_QueuePingPong)->Arg(1 << 14)->UseRealTime();
+
+/**
+ * @brief Benchmark 6: Amend random resting orders; state.range(0): 0 = native modifyOrder(), 1 = cancel + add
+ * @details state.range(1): 0 = size down at the same price (priority kept), 1 = move one tick.
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_Modify(benchmark::State& state){
+    constexpr size_t RESTING = 1 << 16;
+    const bool cancelReplace = state.range(0) != 0;
+    const bool reprice = state.range(1) != 0;
+
+    BenchBook<Ladder> book(benchConfig(RESTING));
+    std::vector<LOB::Price> price(RESTING);
+    std::vector<LOB::Quantity> qty(RESTING, 1u << 30);
+    std::mt19937 gen(11);
+    for(size_t i = 0; i < RESTING; ++i){
+        price[i] = MID - 2 - gen() % 256;
+        book.addOrder(i, price[i], qty[i], LOB::Side::Buy);
+    }
+
+    std::vector<size_t> picks(4096);
+    for(auto& p : picks) p = gen() % RESTING;
+
+    size_t k = 0;
+    for(auto _ : state){
+        size_t i = picks[k++ & (picks.size() - 1)];
+        if(reprice) price[i] += (k & 1) ? 1 : -1; // bid-only book: nothing can cross
+        else --qty[i];
+
+        if(cancelReplace){
+            book.cancelOrder(i);
+            book.addOrder(i, price[i], qty[i], LOB::Side::Buy);
+        }
+        else{
+            book.modifyOrder(i, price[i], qty[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Modify, LOB::MapPriceLadder)->ArgsProduct({{0, 1}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_Modify, LOB::FlatPriceLadder)->ArgsProduct({{0, 1}, {0, 1}});
+
+/**
+ * @brief Benchmark 7: Records -> staged OrderRequests -> applyBatch(), as NanoReplay does with a mapped file
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_Replay(benchmark::State& state){
+    constexpr size_t OPS = 1 << 16;
+    std::vector<LOB::ReplayRecord> records;
+    uint64_t ts = 0;
+    for(const auto& r : cancelHeavyFlow(OPS, 90)){
+        auto type = r.type == LOB::RequestType::Cancel ? LOB::ReplayEventType::Cancel : LOB::ReplayEventType::Add;
+        records.push_back({ts += 100, r.id, r.price, r.qty, 0, type, r.side});
+    }
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<BenchBook<Ladder>>(benchConfig(OPS));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(LOB::replay(records, *book));
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * OPS);
+}
+BENCHMARK_TEMPLATE(BM_Replay, LOB::MapPriceLadder);
+BENCHMARK_TEMPLATE(BM_Replay, LOB::FlatPriceLadder);
+
+/**
+ * @brief Benchmark 8: recover() into an empty book; state.range(0): 0 = journal only, 1 = snapshot + journal tail
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_WarmRestart(benchmark::State& state){
+    constexpr size_t OPS = 1 << 17;
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    const std::string journalPath = dir + "/nanobench.journal";
+    const std::string snapshotPath = dir + "/nanobench.snap";
+    std::filesystem::remove(journalPath);
+    std::filesystem::remove(snapshotPath);
+
+    {
+        BenchBook<Ladder> live(benchConfig(OPS));
+        LOB::JournalWriter journal;
+        journal.open(journalPath);
+        auto flow = cancelHeavyFlow(OPS, 90);
+        for(size_t i = 0; i < flow.size(); ++i){
+            journal.append(flow[i]);
+            live.applyBatch(std::span(&flow[i], 1));
+            if(i + 1 == OPS - OPS / 100) LOB::writeSnapshot(snapshotPath, LOB::captureSnapshot(live, journal.getSequence()));
+        }
+    }
+    const std::string snapshot = state.range(0) ? snapshotPath : dir + "/nanobench.none";
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<BenchBook<Ladder>>(benchConfig(OPS));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(LOB::recover(*book, snapshot, journalPath));
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    std::filesystem::remove(journalPath);
+    std::filesystem::remove(snapshotPath);
+}
+BENCHMARK_TEMPLATE(BM_WarmRestart, LOB::MapPriceLadder)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_WarmRestart, LOB::FlatPriceLadder)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Benchmark 9: The 90% cancel flow through one policy combination (events kept, drained untimed)
+ */
+template <template <LOB::Side> class Ladder, typename Index, typename Sink, typename Lock>
+static void BM_PolicySweep(benchmark::State& state){
+    constexpr size_t OPS = 1 << 16;
+    auto flow = cancelHeavyFlow(OPS, 90);
+    LOB::BookConfig config = benchConfig(OPS);
+    config.eventQueueCapacity = OPS * 4; // never drops: every event is really published
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::BasicOrderBook<Ladder, Index, Sink, Lock>>(config);
+        state.ResumeTiming();
+
+        for(const auto& r : flow){
+            if(r.type == LOB::RequestType::Cancel) book->cancelOrder(r.id);
+            else book->addOrder(r.id, r.price, r.qty, r.side);
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * OPS);
+}
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::OrderIndex, LOB::QueueSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::OrderIndex, LOB::QueueSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::OrderIndex, LOB::NullSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::OrderIndex, LOB::NullSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::QueueSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::QueueSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::NullSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::NullSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::OrderIndex, LOB::QueueSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::OrderIndex, LOB::QueueSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::OrderIndex, LOB::NullSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::OrderIndex, LOB::NullSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::UnorderedOrderIndex, LOB::QueueSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::UnorderedOrderIndex, LOB::QueueSink, LOB::SpinLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::UnorderedOrderIndex, LOB::NullSink, LOB::NoLock);
+BENCHMARK_TEMPLATE(BM_PolicySweep, LOB::FlatPriceLadder, LOB::UnorderedOrderIndex, LOB::NullSink, LOB::SpinLock);
+
+/**
+ * @brief Benchmark 10: Limit / IOC buys each sweeping 8 ask levels of 'N' one-lot orders
+ * @details The resting orders are posted in random level order, so consecutive orders of one FIFO sit in
+ * unrelated pool slots (as in a book that has churned all day) and every fill touches a cold Order.
+ * state.range(1): 0 = Limit (posted, then matched), 1 = ImmediateOrCancel. Items = resting orders filled.
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_DeepSweep(benchmark::State& state){
+    constexpr LOB::Price LEVELS = 8;
+    constexpr size_t SWEEPS = 16;
+    const size_t perLevel = static_cast<size_t>(state.range(0));
+    const size_t resting = SWEEPS * LEVELS * perLevel;
+    const LOB::OrderType type = state.range(1) ? LOB::OrderType::ImmediateOrCancel : LOB::OrderType::Limit;
+
+    std::vector<LOB::Price> prices;
+    for(LOB::Price level = 0; level < SWEEPS * LEVELS; ++level) prices.insert(prices.end(), perLevel, MID + level);
+    for(size_t sweep = 0; sweep < SWEEPS; ++sweep){
+        auto first = prices.begin() + static_cast<std::ptrdiff_t>(sweep * LEVELS * perLevel);
+        std::shuffle(first, first + static_cast<std::ptrdiff_t>(LEVELS * perLevel), std::mt19937(static_cast<unsigned>(sweep)));
+    }
+
+    BenchBook<Ladder> book(benchConfig(resting + 2));
+    book.addOrder(0, MID - 1000, 10, LOB::Side::Buy);
+    LOB::OrderId id = 1;
+
+    for(auto _ : state){
+        state.PauseTiming();
+        for(LOB::Price p : prices) book.addOrder(id++, p, 1, LOB::Side::Sell);
+        state.ResumeTiming();
+
+        for(size_t sweep = 0; sweep < SWEEPS; ++sweep){
+            LOB::Price limit = MID + static_cast<LOB::Price>((sweep + 1) * LEVELS) - 1;
+            book.addOrder(id++, limit, static_cast<LOB::Quantity>(LEVELS * perLevel), LOB::Side::Buy, type);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * resting);
+}
+BENCHMARK_TEMPLATE(BM_DeepSweep, LOB::MapPriceLadder)->ArgsProduct({{4, 64}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_DeepSweep, LOB::FlatPriceLadder)->ArgsProduct({{4, 64}, {0, 1}});
+
+/**
+ * @brief Benchmark 11: Cancel-heavy flow from 16 accounts, into a plain book (state.range(0) == 0) or through a RiskGate (== 1)
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_RiskGate(benchmark::State& state){
+    constexpr size_t OPS = 1 << 16;
+    constexpr LOB::AccountId ACCOUNTS = 16;
+    const bool checked = state.range(0) != 0;
+    auto flow = cancelHeavyFlow(OPS, 90);
+    LOB::BookConfig config = benchConfig(OPS);
+    config.orderIndexMode = LOB::OrderIndexMode::Dense; // sequential IDs: book index and ledger both direct-mapped
+
+    LOB::RiskLimits limits;
+    limits.maxOrderQty = 1000;
+    limits.priceCollar = 1000;
+    limits.maxPosition = 1 << 30;
+    limits.maxNotional = uint64_t{1} << 50;
+
+    for(auto _ : state){
+        state.PauseTiming();
+        auto book = std::make_unique<LOB::BasicOrderBook<Ladder, LOB::OrderIndex, LOB::RiskSink<LOB::NullSink>>>(config);
+        LOB::RiskGate<std::remove_reference_t<decltype(*book)>> gate(*book);
+        for(LOB::AccountId a = 0; a < ACCOUNTS; ++a) gate.setLimits(a, limits);
+
+        auto direct = std::make_unique<BenchBook<Ladder>>(config);
+        state.ResumeTiming();
+
+        if(checked){
+            for(const auto& r : flow){
+                if(r.type == LOB::RequestType::Cancel) gate.cancelOrder(r.id);
+                else gate.addOrder(static_cast<LOB::AccountId>(r.id % ACCOUNTS), r.id, r.price, r.qty, r.side);
+            }
+        }
+        else{
+            for(const auto& r : flow){
+                if(r.type == LOB::RequestType::Cancel) direct->cancelOrder(r.id);
+                else direct->addOrder(r.id, r.price, r.qty, r.side);
+            }
+        }
+
+        state.PauseTiming();
+        book.reset();
+        direct.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * OPS);
+}
+BENCHMARK_TEMPLATE(BM_RiskGate, LOB::MapPriceLadder)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_RiskGate, LOB::FlatPriceLadder)->Arg(0)->Arg(1);
+
+/**
+ * @brief Benchmark 12: Aggregated depth over a 1024-level book, each query reaching state.range(0) levels
+ * @details Asks rest on every other tick with sizes 1-8, so the scans also skip empty ticks. One item is one
+ * estimateFill() (the VWAP / levels-to-fill query behind a FOK pre-check) plus one getVolumeWithin().
+ */
+template <template <LOB::Side> class Ladder>
+static void BM_DepthQuery(benchmark::State& state){
+    constexpr LOB::Price LEVELS = 1024;
+    const size_t reach = static_cast<size_t>(state.range(0));
+
+    BenchBook<Ladder> book(benchConfig(LEVELS + 1));
+    LOB::Quantity volume = 0;
+    for(LOB::Price level = 0; level < LEVELS; ++level){
+        LOB::Quantity qty = 1 + level % 8;
+        if(level < reach) volume += qty;
+        book.addOrder(level, MID + 2 * level, qty, LOB::Side::Sell);
+    }
+
+    for(auto _ : state){
+        LOB::FillEstimate estimate = book.estimateFill(LOB::Side::Buy, volume);
+        benchmark::DoNotOptimize(estimate);
+        benchmark::DoNotOptimize(book.getVolumeWithin(LOB::Side::Sell, 2 * reach));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_DepthQuery, LOB::MapPriceLadder)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK_TEMPLATE(BM_DepthQuery, LOB::FlatPriceLadder)->Arg(8)->Arg(64)->Arg(512);
@@ -0,0 +1,79 @@
+/**
+ * @file DepthBook.cpp
+ * @brief Implementation of the consumer-side L2 replica.
+ */
+#include "LOB/DepthBook.h"
+#include <ostream>
+#include <iomanip>
+
+namespace LOB {
+
+    namespace {
+        template <typename Levels>
+        void setLevel(Levels& levels, Price price, Quantity volume){
+            if(volume == 0) levels.erase(price);
+            else levels[price] = volume;
+        }
+
+        template <typename Levels>
+        size_t copyTop(const Levels& levels, std::span<DepthLevel> out){
+            size_t n = 0;
+            for(auto it = levels.begin(); it != levels.end() && n < out.size(); ++it){
+                out[n++] = DepthLevel{it->first, it->second};
+            }
+            return n;
+        }
+    }
+
+    bool DepthBook::apply(const ExecutionEvent& event){
+        switch(event.type){
+            case EventType::BookUpdate:
+                if(event.update.side == Side::Buy) setLevel(bids_, event.update.price, event.update.volume);
+                else setLevel(asks_, event.update.price, event.update.volume);
+                ++updates_;
+                return true;
+
+            case EventType::BookSnapshot:
+                clear();
+                ++snapshots_;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    size_t DepthBook::getBids(std::span<DepthLevel> out) const {
+        return copyTop(bids_, out);
+    }
+
+    size_t DepthBook::getAsks(std::span<DepthLevel> out) const {
+        return copyTop(asks_, out);
+    }
+
+    void DepthBook::clear(){
+        bids_.clear();
+        asks_.clear();
+    }
+
+    void DepthBook::print(std::ostream& os, size_t depth) const {
+        auto bid = bids_.begin();
+        auto ask = asks_.begin();
+        for(size_t row = 0; row < depth; ++row){
+            os << "   ";
+            if(bid != bids_.end()){
+                os << std::setw(6) << bid->second << "  " << std::setw(8) << bid->first;
+                ++bid;
+            }
+            else{
+                os << std::setw(16) << "";
+            }
+            os << "  |  ";
+            if(ask != asks_.end()){
+                os << std::left << std::setw(8) << ask->first << "  " << std::setw(6) << ask->second << std::right;
+                ++ask;
+            }
+            os << "\n";
+        }
+    }
+}
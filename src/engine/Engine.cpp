@@ -0,0 +1,155 @@
+/**
+ * @file Engine.cpp
+ * @brief Implementation of the symbol-sharded multi-book Engine.
+ * @details
+ * This file contains the logic for:
+ * 1. Symbol Registration (assigning every instrument to its shard).
+ * 2. Shard Lifecycle (pinning, building queues and books on the owning core, locking memory, draining on stop).
+ * 3. Dispatch (handing runs of same-symbol requests to OrderBook::applyBatch()).
+ *
+ * Like BasicOrderBook, BasicEngine is explicitly instantiated at the bottom of the file for every shipped book type.
+ */
+#include "LOB/Engine.h"
+#include "LOB/ThreadAffinity.h"
+
+namespace LOB {
+
+    template <typename Book>
+    BasicEngine<Book>::BasicEngine(const EngineConfig& config) : config_(config) {
+        size_t count = config_.shardCount > 0 ? config_.shardCount : 1;
+        shards_.reserve(count);
+        for(size_t i = 0; i < count; ++i){
+            shards_.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    template <typename Book>
+    BasicEngine<Book>::~BasicEngine(){
+        stop();
+    }
+
+    template <typename Book>
+    bool BasicEngine<Book>::addSymbol(SymbolId symbol){
+        if(running_.load(std::memory_order_relaxed)) return false;
+
+        Shard& shard = *shards_[shardFor(symbol)];
+        for(SymbolId s : shard.symbols){
+            if(s == symbol) return false;
+        }
+        shard.symbols.push_back(symbol);
+        return true;
+    }
+
+    template <typename Book>
+    void BasicEngine<Book>::start(){
+        if(running_.exchange(true)) return;
+
+        readyShards_.store(0, std::memory_order_relaxed);
+        for(size_t i = 0; i < shards_.size(); ++i){
+            shards_[i]->thread = std::thread(&BasicEngine::runShard, this, i);
+        }
+
+        // Acquire: the queues, books and lookup tables built by each shard are visible after this.
+        while(readyShards_.load(std::memory_order_acquire) < shards_.size()){
+            std::this_thread::yield();
+        }
+
+        // Everything hot is allocated and touched by now: lock it (and anything mapped later) in RAM.
+        if(config_.lockMemory && !memoryLocked_){
+            memoryLocked_ = lockProcessMemory();
+        }
+        accepting_.store(true, std::memory_order_release);
+    }
+
+    template <typename Book>
+    void BasicEngine<Book>::stop(){
+        // Release: every submit() made before stop() is visible to a shard that observes running_ == false.
+        accepting_.store(false, std::memory_order_relaxed);
+        if(!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+        for(auto& shard : shards_){
+            if(shard->thread.joinable()) shard->thread.join();
+        }
+    }
+
+    template <typename Book>
+    Book* BasicEngine<Book>::getBook(SymbolId symbol){
+        Shard& shard = *shards_[shardFor(symbol)];
+        auto it = shard.lookup.find(symbol);
+        return it == shard.lookup.end() ? nullptr : it->second;
+    }
+
+    template <typename Book>
+    void BasicEngine<Book>::runShard(size_t index){
+        Shard& shard = *shards_[index];
+
+        // 1. Pin first, so everything below is first-touched by this core (and allocated on its NUMA node).
+        if(config_.pinThreads){
+            shard.pinned = pinThisThread(coreFor(index));
+        }
+        shard.numaNode = currentNumaNode();
+
+        // 2. Build this shard's ingress and books (pools, indices, ladders) on the owning thread.
+        //    The queue constructor value-initializes every slot, which pre-faults the whole ring.
+        if(!shard.ingress){
+            shard.ingress.emplace(config_.shardQueueCapacity);
+        }
+        //    A restart only builds the books of symbols added since the last stop().
+        shard.books.reserve(shard.symbols.size());
+        for(SymbolId symbol : shard.symbols){
+            if(shard.lookup.count(symbol) != 0) continue;
+            shard.books.push_back(std::make_unique<Book>(config_.book));
+            shard.lookup.emplace(symbol, shard.books.back().get());
+        }
+        readyShards_.fetch_add(1, std::memory_order_release);
+
+        // 3. Poll the ingress until stopped AND drained.
+        while(true){
+            bool stopping = !running_.load(std::memory_order_acquire);
+
+            std::span<const OrderRequest> batch = shard.ingress->peek_bulk(config_.maxBatch);
+            if(batch.empty()){
+                if(stopping) break;
+                // A dedicated, isolated core returns from yield immediately; a shared one stays usable.
+                std::this_thread::yield();
+                continue;
+            }
+
+            if constexpr(LATENCY_ENABLED){
+                Timestamp popped = LatencyClock::now();
+                for(const OrderRequest& req : batch){
+                    if(getSentAt(req)) shard.latency.record(LatencyStage::QueueWait, getSentAt(req), popped);
+                }
+            }
+
+            dispatch(shard, batch);
+            shard.ingress->release(batch.size());
+            shard.processed.store(shard.processed.load(std::memory_order_relaxed) + batch.size(), std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Book>
+    void BasicEngine<Book>::dispatch(Shard& shard, std::span<const OrderRequest> batch){
+        size_t begin = 0;
+        while(begin < batch.size()){
+            SymbolId symbol = batch[begin].symbol;
+            size_t end = begin + 1;
+            while(end < batch.size() && batch[end].symbol == symbol) ++end;
+
+            auto it = shard.lookup.find(symbol);
+            if(it != shard.lookup.end()){
+                it->second->applyBatch(batch.subspan(begin, end - begin));
+            }
+            else{
+                shard.unknownSymbol.store(shard.unknownSymbol.load(std::memory_order_relaxed) + (end - begin), std::memory_order_relaxed);
+            }
+            begin = end;
+        }
+    }
+
+    // --- Explicit Instantiations (one per shipped book type) ---
+    template class BasicEngine<BasicOrderBook<MapPriceLadder, OrderIndex, QueueSink>>;
+    template class BasicEngine<BasicOrderBook<MapPriceLadder, OrderIndex, NullSink>>;
+    template class BasicEngine<BasicOrderBook<FlatPriceLadder, OrderIndex, QueueSink>>;
+    template class BasicEngine<BasicOrderBook<FlatPriceLadder, OrderIndex, NullSink>>;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file Events.cpp
+ * @brief Text formatting of execution events.
+ * @details Only ever called by consumers of the event stream (loggers, dashboards),
+ * so the matching thread never pays for iostream formatting.
+ */
+#include "LOB/Events.h"
+#include <ostream>
+
+namespace LOB {
+
+    namespace {
+        const char* toString(RejectReason reason){
+            switch(reason){
+                case RejectReason::DuplicateOrderId: return "duplicate order id";
+                case RejectReason::UnknownOrder:     return "order not found";
+                case RejectReason::InvalidPrice:     return "price off the tick grid";
+                case RejectReason::PoolExhausted:    return "order pool exhausted";
+                case RejectReason::RiskUnknownAccount: return "risk: unknown account";
+                case RejectReason::RiskOrderSize:    return "risk: order size";
+                case RejectReason::RiskPriceCollar:  return "risk: outside price collar";
+                case RejectReason::RiskPosition:     return "risk: position limit";
+                case RejectReason::RiskNotional:     return "risk: notional limit";
+                case RejectReason::RiskCapacity:     return "risk: working order table full";
+            }
+            return "unknown";
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ExecutionEvent& event){
+        switch(event.type){
+            case EventType::Trade:
+                return os << ">>> TRADE EXECUTE: " << event.trade.quantity << " shares @ " << event.trade.price
+                          << " (Bid #" << event.trade.buyOrderId << " vs Ask #" << event.trade.sellOrderId << ")";
+            case EventType::Cancel:
+                return os << ">>> Cancelled Order #" << event.cancel.orderId
+                          << " (" << event.cancel.remainingQuantity << " open)";
+            case EventType::Reject:
+                return os << "[Error] Order #" << event.reject.orderId << " rejected: " << toString(event.reject.reason);
+            case EventType::BookUpdate:
+                return os << "--- LEVEL " << (event.update.side == Side::Buy ? "BID " : "ASK ") << event.update.price
+                          << " | Vol: " << event.update.volume;
+            case EventType::Modify:
+                return os << ">>> Modified Order #" << event.modify.orderId << " -> " << event.modify.quantity
+                          << " @ " << event.modify.price;
+            case EventType::BookSnapshot:
+                return os << "=== SNAPSHOT (depth " << event.snapshot.depth << ")";
+        }
+        return os;
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file Latency.cpp
+ * @brief Text reporting of latency histograms.
+ * @details Only called by reporting code (simulation summary, dashboard), never by the matching thread.
+ */
+#include "LOB/Latency.h"
+#include <ostream>
+
+namespace LOB {
+
+    std::ostream& printSummary(std::ostream& os, const char* label, const LatencyHistogram& histogram){
+        return os << label << ": n=" << histogram.getCount()
+                  << " p50=" << histogram.percentile(50.0) << "ns"
+                  << " p99=" << histogram.percentile(99.0) << "ns"
+                  << " p99.9=" << histogram.percentile(99.9) << "ns"
+                  << " max=" << histogram.getMax() << "ns";
+    }
+
+    const char* toString(LatencyStage stage){
+        switch(stage){
+            case LatencyStage::QueueWait: return "QueueWait";
+            case LatencyStage::Ingress:   return "Ingress";
+            case LatencyStage::Match:     return "Match";
+            case LatencyStage::EndToEnd:  return "EndToEnd";
+        }
+        return "Unknown";
+    }
+
+    template <bool Enabled>
+    void BasicLatencyTracker<Enabled>::print(std::ostream& os) const {
+        for(size_t i = 0; i < LATENCY_STAGE_COUNT; ++i){
+            const LatencyHistogram& h = stages_[i];
+            if(h.getCount() == 0) continue;
+            printSummary(os, toString(static_cast<LatencyStage>(i)), h) << "\n";
+        }
+    }
+
+    void BasicLatencyTracker<false>::print(std::ostream& os) const {
+        os << "Latency tracking disabled (build with -DNANOBOOK_LATENCY=ON).\n";
+    }
+
+    template class BasicLatencyTracker<true>;
+}
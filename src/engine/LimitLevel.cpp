@@ -7,7 +7,7 @@
 
 namespace LOB{
 
-    LimitLevel::LimitLevel(Price p): price_(p), totalVolume_(0), head_(nullptr), tail_(nullptr) {}
+    LimitLevel::LimitLevel(Price p): price_(p), totalVolume_(0), head_(nullptr), tail_(nullptr), orderCount_(0) {}
 
     void LimitLevel::append(Order* order){
         if(!head_){
@@ -31,6 +31,7 @@ namespace LOB{
 
         // Cache the volume update (O(1))
         totalVolume_ += order->quantity;
+        ++orderCount_;
     }
 
     void LimitLevel::remove(Order* order){
@@ -62,6 +63,33 @@ namespace LOB{
 
         // Update cached volume
         totalVolume_ -= order->quantity;
+        --orderCount_;
+    }
+
+    void LimitLevel::fill(Order* order, Quantity qty){
+        order->quantity -= qty;
+        totalVolume_ -= qty;
+    }
+
+    void LimitLevel::reduce(Order* order, Quantity newQty){
+        totalVolume_ -= order->quantity - newQty;
+        order->quantity = newQty;
+    }
+
+    void LimitLevel::replenish(Order* order, Quantity slice){
+        // Move to the tail unless it already is the tail (then it is alone in the queue)
+        if(order != tail_){
+            if(order->prev) order->prev->next = order->next;
+            else head_ = order->next;
+            order->next->prev = order->prev;
+
+            tail_->next = order;
+            order->prev = tail_;
+            order->next = nullptr;
+            tail_ = order;
+        }
+        order->quantity = slice;
+        totalVolume_ += slice;
     }
 
     bool LimitLevel::isEmpty() const {
@@ -0,0 +1,384 @@
+/**
+ * @file Metrics.cpp
+ * @brief Sampling, Prometheus rendering and shared-memory publication of the book / queue metrics.
+ * @details Everything here runs on the exporter's thread (or a reader process), never on the matching thread.
+ */
+#include "LOB/MetricsExporter.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LOB {
+
+    const char* toString(Counter counter){
+        switch(counter){
+            case Counter::Instructions:   return "instructions";
+            case Counter::Orders:         return "orders";
+            case Counter::Modifies:       return "modifies";
+            case Counter::Trades:         return "trades";
+            case Counter::TradedQuantity: return "traded_quantity";
+            case Counter::Cancels:        return "cancels";
+            case Counter::Rejects:        return "rejects";
+        }
+        return "unknown";
+    }
+
+    const char* toString(Gauge gauge){
+        switch(gauge){
+            case Gauge::RestingOrders: return "resting_orders";
+            case Gauge::IndexCapacity: return "index_capacity";
+            case Gauge::PoolInUse:     return "pool_in_use";
+            case Gauge::PoolCapacity:  return "pool_capacity";
+            case Gauge::BidLevels:     return "bid_levels";
+            case Gauge::AskLevels:     return "ask_levels";
+        }
+        return "unknown";
+    }
+
+    namespace {
+
+        uint64_t steadyNanos(){
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // --- Prometheus ---
+
+        std::string escapeLabel(const std::string& value){
+            std::string out;
+            out.reserve(value.size());
+            for(char c : value){
+                if(c == '\\' || c == '"') out += '\\';
+                if(c == '\n'){
+                    out += "\\n";
+                    continue;
+                }
+                out += c;
+            }
+            return out;
+        }
+
+        void family(std::ostringstream& os, const std::string& name, const char* type){
+            os << "# TYPE nanobook_" << name << ' ' << type << '\n';
+        }
+
+        template <typename Value>
+        void sample(std::ostringstream& os, const std::string& name, const char* key, const std::string& label, Value value){
+            os << "nanobook_" << name << '{' << key << "=\"" << escapeLabel(label) << "\"} " << value << '\n';
+        }
+
+        double ratio(uint64_t part, uint64_t whole){
+            return whole ? static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+        }
+
+        /**
+         * @brief Writes PATH.tmp, then renames it over PATH (readers see the old or the new file, never a mix).
+         */
+        bool replaceFile(const std::string& path, const std::string& text){
+            const std::string tmp = path + ".tmp";
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if(!out) return false;
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                if(!out.flush()) return false;
+            }
+            return std::rename(tmp.c_str(), path.c_str()) == 0;
+        }
+
+        // --- Shared Memory ---
+
+        void storeWord(uint64_t& word, uint64_t value){
+            std::atomic_ref<uint64_t>(word).store(value, std::memory_order_relaxed);
+        }
+
+        uint64_t loadWord(const uint64_t& word){
+            return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(word)).load(std::memory_order_relaxed);
+        }
+
+        void storeLabel(uint64_t (&words)[SharedMetricsLayout::LABEL_WORDS], const std::string& label){
+            char text[sizeof(words)] = {};
+            std::memcpy(text, label.data(), std::min(label.size(), sizeof(text) - 1));
+            for(size_t i = 0; i < SharedMetricsLayout::LABEL_WORDS; ++i){
+                uint64_t word;
+                std::memcpy(&word, text + i * sizeof(uint64_t), sizeof(word));
+                storeWord(words[i], word);
+            }
+        }
+
+        std::string loadLabel(const uint64_t (&words)[SharedMetricsLayout::LABEL_WORDS]){
+            char text[sizeof(words)];
+            for(size_t i = 0; i < SharedMetricsLayout::LABEL_WORDS; ++i){
+                uint64_t word = loadWord(words[i]);
+                std::memcpy(text + i * sizeof(uint64_t), &word, sizeof(word));
+            }
+            return std::string(text, strnlen(text, sizeof(text)));
+        }
+    }
+
+    MetricsSnapshot MetricsRegistry::sample() const {
+        MetricsSnapshot snapshot;
+        snapshot.timestampNanos = steadyNanos();
+
+        snapshot.books.reserve(books_.size());
+        for(const BookSource& source : books_){
+            BookMetricsSample& book = snapshot.books.emplace_back();
+            book.label = source.label;
+            for(size_t i = 0; i < COUNTER_COUNT; ++i) book.counters[i] = source.metrics->get(static_cast<Counter>(i));
+            for(size_t i = 0; i < GAUGE_COUNT; ++i) book.gauges[i] = source.metrics->get(static_cast<Gauge>(i));
+        }
+
+        snapshot.queues.reserve(queues_.size());
+        for(const QueueSource& source : queues_){
+            QueueMetricsSample& queue = snapshot.queues.emplace_back(source.sample());
+            queue.label = source.label;
+        }
+        return snapshot;
+    }
+
+    std::string renderPrometheus(const MetricsSnapshot& now, const MetricsSnapshot* previous){
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3);
+
+        // Rates only against an earlier sample of the same books.
+        double seconds = 0.0;
+        if(previous && previous->books.size() == now.books.size() && now.timestampNanos > previous->timestampNanos){
+            seconds = static_cast<double>(now.timestampNanos - previous->timestampNanos) / 1e9;
+        }
+
+        // 1. Counters (one family per counter, every book inside it), then their rates
+        for(size_t i = 0; i < COUNTER_COUNT; ++i){
+            const std::string name = std::string(toString(static_cast<Counter>(i))) + "_total";
+            family(os, name, "counter");
+            for(const BookMetricsSample& book : now.books) sample(os, name, "book", book.label, book.counters[i]);
+        }
+        if(seconds > 0.0){
+            for(size_t i = 0; i < COUNTER_COUNT; ++i){
+                const std::string name = std::string(toString(static_cast<Counter>(i))) + "_per_second";
+                family(os, name, "gauge");
+                for(size_t b = 0; b < now.books.size(); ++b){
+                    uint64_t before = previous->books[b].counters[i];
+                    uint64_t after = now.books[b].counters[i];
+                    sample(os, name, "book", now.books[b].label, static_cast<double>(after >= before ? after - before : 0) / seconds);
+                }
+            }
+        }
+
+        // 2. Gauges, plus the two ratios dashboards actually alert on
+        for(size_t i = 0; i < GAUGE_COUNT; ++i){
+            const std::string name = toString(static_cast<Gauge>(i));
+            family(os, name, "gauge");
+            for(const BookMetricsSample& book : now.books) sample(os, name, "book", book.label, book.gauges[i]);
+        }
+        family(os, "index_load_factor", "gauge");
+        for(const BookMetricsSample& book : now.books){
+            sample(os, "index_load_factor", "book", book.label, ratio(book.get(Gauge::RestingOrders), book.get(Gauge::IndexCapacity)));
+        }
+        family(os, "pool_occupancy", "gauge");
+        for(const BookMetricsSample& book : now.books){
+            sample(os, "pool_occupancy", "book", book.label, ratio(book.get(Gauge::PoolInUse), book.get(Gauge::PoolCapacity)));
+        }
+
+        // 3. Queues
+        if(!now.queues.empty()){
+            family(os, "queue_depth", "gauge");
+            for(const QueueMetricsSample& queue : now.queues) sample(os, "queue_depth", "queue", queue.label, queue.depth);
+            family(os, "queue_capacity", "gauge");
+            for(const QueueMetricsSample& queue : now.queues) sample(os, "queue_capacity", "queue", queue.label, queue.capacity);
+            family(os, "queue_full_total", "counter");
+            for(const QueueMetricsSample& queue : now.queues) sample(os, "queue_full_total", "queue", queue.label, queue.fullCount);
+        }
+        return os.str();
+    }
+
+    /**
+     * @class MetricsExporter::SharedRegion
+     * @brief The exporter's mapping of its SharedMetricsLayout (the only writer).
+     */
+    class MetricsExporter::SharedRegion {
+        private:
+            std::string name_;
+            SharedMetricsLayout* layout_;
+
+        public:
+            SharedRegion(std::string name, SharedMetricsLayout* layout) : name_(std::move(name)), layout_(layout) {}
+
+            ~SharedRegion(){
+                munmap(layout_, sizeof(SharedMetricsLayout));
+                shm_unlink(name_.c_str());
+            }
+
+            /**
+             * @brief Creates (or reuses) the region and zeroes it.
+             * @return nullptr if shm_open / ftruncate / mmap fails.
+             */
+            static std::unique_ptr<SharedRegion> open(const std::string& name){
+                int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+                if(fd < 0) return nullptr;
+                void* map = MAP_FAILED;
+                if(ftruncate(fd, sizeof(SharedMetricsLayout)) == 0){
+                    map = mmap(nullptr, sizeof(SharedMetricsLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                }
+                close(fd);
+                if(map == MAP_FAILED){
+                    shm_unlink(name.c_str());
+                    return nullptr;
+                }
+
+                auto* layout = static_cast<SharedMetricsLayout*>(map);
+                std::memset(layout, 0, sizeof(SharedMetricsLayout));
+                std::atomic_ref<uint64_t>(layout->magic).store(SharedMetricsLayout::MAGIC, std::memory_order_release);
+                return std::make_unique<SharedRegion>(name, layout);
+            }
+
+            /**
+             * @brief Seqlock write: odd sequence, fields, even sequence.
+             */
+            void publish(const MetricsSnapshot& snapshot){
+                std::atomic_ref<uint64_t> sequence(layout_->sequence);
+                const uint64_t seq = sequence.load(std::memory_order_relaxed);
+                sequence.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                const size_t books = std::min(snapshot.books.size(), SharedMetricsLayout::MAX_BOOKS);
+                const size_t queues = std::min(snapshot.queues.size(), SharedMetricsLayout::MAX_QUEUES);
+                storeWord(layout_->timestampNanos, snapshot.timestampNanos);
+                storeWord(layout_->bookCount, books);
+                storeWord(layout_->queueCount, queues);
+                for(size_t b = 0; b < books; ++b){
+                    SharedMetricsLayout::Book& out = layout_->books[b];
+                    storeLabel(out.label, snapshot.books[b].label);
+                    for(size_t i = 0; i < COUNTER_COUNT; ++i) storeWord(out.counters[i], snapshot.books[b].counters[i]);
+                    for(size_t i = 0; i < GAUGE_COUNT; ++i) storeWord(out.gauges[i], snapshot.books[b].gauges[i]);
+                }
+                for(size_t q = 0; q < queues; ++q){
+                    SharedMetricsLayout::Queue& out = layout_->queues[q];
+                    storeLabel(out.label, snapshot.queues[q].label);
+                    storeWord(out.depth, snapshot.queues[q].depth);
+                    storeWord(out.capacity, snapshot.queues[q].capacity);
+                    storeWord(out.fullCount, snapshot.queues[q].fullCount);
+                }
+
+                sequence.store(seq + 2, std::memory_order_release);
+            }
+    };
+
+    bool readSharedMetrics(const std::string& name, MetricsSnapshot& out){
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if(fd < 0) return false;
+        struct stat info{};
+        void* map = MAP_FAILED;
+        if(fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedMetricsLayout)){
+            map = mmap(nullptr, sizeof(SharedMetricsLayout), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if(map == MAP_FAILED) return false;
+
+        const auto* layout = static_cast<const SharedMetricsLayout*>(map);
+        bool ok = false;
+        if(loadWord(layout->magic) == SharedMetricsLayout::MAGIC){
+            std::atomic_ref<uint64_t> sequence(const_cast<uint64_t&>(layout->sequence));
+
+            // The writer holds the odd sequence for microseconds each interval: a bounded retry is plenty.
+            for(int attempt = 0; attempt < 1000 && !ok; ++attempt){
+                const uint64_t before = sequence.load(std::memory_order_acquire);
+                if(before & 1){
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                MetricsSnapshot snapshot;
+                snapshot.timestampNanos = loadWord(layout->timestampNanos);
+                const size_t books = std::min<size_t>(loadWord(layout->bookCount), SharedMetricsLayout::MAX_BOOKS);
+                const size_t queues = std::min<size_t>(loadWord(layout->queueCount), SharedMetricsLayout::MAX_QUEUES);
+                for(size_t b = 0; b < books; ++b){
+                    const SharedMetricsLayout::Book& in = layout->books[b];
+                    BookMetricsSample& book = snapshot.books.emplace_back();
+                    book.label = loadLabel(in.label);
+                    for(size_t i = 0; i < COUNTER_COUNT; ++i) book.counters[i] = loadWord(in.counters[i]);
+                    for(size_t i = 0; i < GAUGE_COUNT; ++i) book.gauges[i] = loadWord(in.gauges[i]);
+                }
+                for(size_t q = 0; q < queues; ++q){
+                    const SharedMetricsLayout::Queue& in = layout->queues[q];
+                    QueueMetricsSample& queue = snapshot.queues.emplace_back();
+                    queue.label = loadLabel(in.label);
+                    queue.depth = loadWord(in.depth);
+                    queue.capacity = loadWord(in.capacity);
+                    queue.fullCount = loadWord(in.fullCount);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(sequence.load(std::memory_order_relaxed) == before){
+                    out = std::move(snapshot);
+                    ok = true;
+                }
+            }
+        }
+        munmap(const_cast<SharedMetricsLayout*>(layout), sizeof(SharedMetricsLayout));
+        return ok;
+    }
+
+    MetricsExporter::MetricsExporter(const MetricsRegistry& registry, ExporterOptions options)
+        : registry_(registry), options_(std::move(options))
+    {
+        if(!options_.sharedMemoryName.empty()){
+            shared_ = SharedRegion::open(options_.sharedMemoryName);
+        }
+    }
+
+    MetricsExporter::~MetricsExporter(){
+        stop();
+    }
+
+    void MetricsExporter::start(){
+        std::lock_guard<std::mutex> guard(mutex_);
+        if(running_) return;
+        running_ = true;
+        thread_ = std::thread(&MetricsExporter::run, this);
+    }
+
+    void MetricsExporter::stop(){
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if(!running_) return;
+            running_ = false;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    void MetricsExporter::run(){
+        std::unique_lock<std::mutex> lock(mutex_);
+        while(running_){
+            lock.unlock();
+            exportOnce();
+            lock.lock();
+            wake_.wait_for(lock, options_.interval, [this]{ return !running_; });
+        }
+        lock.unlock();
+
+        // Final sample: the outputs end on the values at shutdown.
+        exportOnce();
+    }
+
+    MetricsSnapshot MetricsExporter::exportOnce(){
+        MetricsSnapshot snapshot = registry_.sample();
+
+        if(!options_.prometheusPath.empty()){
+            replaceFile(options_.prometheusPath, renderPrometheus(snapshot, hasPrevious_ ? &previous_ : nullptr));
+        }
+        if(shared_){
+            shared_->publish(snapshot);
+        }
+
+        previous_ = snapshot;
+        hasPrevious_ = true;
+        return snapshot;
+    }
+}
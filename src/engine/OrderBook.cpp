@@ -4,170 +4,771 @@
  * @details
  * This file contains the logic for:
  * 1. Order Injection (Adding orders to the book).
- * 2. Order Matching (Executing trades when prices cross).
- * 3. Order Cancellation (Removing orders efficiently).
+ * 2. Order Matching (Executing trades when prices cross, and immediate Market / IOC / FOK orders).
+ * 3. Order Cancellation / Amendment (Removing or relinking orders efficiently).
  * 4. Memory Management (Using ObjectPool for zero-allocation runtime).
+ * 5. Event Reporting (Handing POD events to the Execution Sink instead of printing, flushed once per instruction).
+ * 6. Conditional Orders (Parking stops until the last trade price reaches them, replenishing iceberg slices).
+ *
+ * BasicOrderBook is a template, but its definitions live here and are explicitly
+ * instantiated at the bottom of the file for every shipped policy combination (ladder, index, sink, lock).
+ * Public instructions take the Lock policy once and then call the unlocked private helpers, so a batch or a
+ * modify that turns into a cancel never re-enters the lock.
  */
 #include "LOB/OrderBook.h"
+#include "LOB/RiskGate.h"
+#include "LOB/EventDigest.h"
+#include "LOB/SharedMemoryGateway.h"
 #include <iostream>
 #include <algorithm>
+#include <limits>
 
 namespace LOB {
 
-    // Initialize the memory pool with space for 100,000 orders to prevent runtime allocations.
-    OrderBook::OrderBook() : orderPool_(10000) {}
+    // Initialize the memory pool with BookConfig::orderPoolCapacity slots to prevent runtime allocations.
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    BasicOrderBook<Ladder, Index, Sink, Lock>::BasicOrderBook(const BookConfig& config)
+        : bids_(config), asks_(config),
+          orderMap_(config.orderIndexCapacity > 0 ? config.orderIndexCapacity : config.orderPoolCapacity, config.orderIndexMode),
+          orderPool_(config.orderPoolCapacity, PoolOptions{config.orderPoolGrowable, config.useHugePages, config.lockPages}),
+          sink_(config) {}
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::addOrder(OrderId id, Price price, Quantity qty, Side side, OrderType type){
+        std::lock_guard<Lock> guard(lock_);
+        latency_.beginOrder(0);
+        metrics_.count(Counter::Orders);
+
+        if(type != OrderType::Limit){
+            executeImmediate(id, price, qty, side, type);
+        }
+        // 1-4. Validate, allocate, index and post
+        else if(restOrder(id, price, qty, side)){
+            // 5. Attempt Execution: Check if this new order crosses the spread
+            match(side);
+        }
+
+        // 6. Publish the coalesced level deltas and the new BBO
+        endInstruction();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::addStopOrder(OrderId id, Price stopPrice, Price price, Quantity qty, Side side, OrderType type){
+        std::lock_guard<Lock> guard(lock_);
+        latency_.beginOrder(0);
+        metrics_.count(Counter::Orders);
+
+        if(orderMap_.find(id) || stops_.contains(id)){
+            sink_.onReject(Reject{id, RejectReason::DuplicateOrderId});
+            metrics_.count(Counter::Rejects);
+        }
+        else if(type == OrderType::Limit && !isValidPrice(price, side)){
+            sink_.onReject(Reject{id, RejectReason::InvalidPrice});
+            metrics_.count(Counter::Rejects);
+        }
+        else{
+            // Park it; a stop that the last trade has already reached is released straight away
+            stops_.add(StopOrder{id, stopPrice, price, qty, side, type});
+            if(lastTradePrice_ != 0 && stops_.isTriggered(lastTradePrice_)){
+                releaseStops();
+            }
+        }
+        endInstruction();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::addIcebergOrder(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side){
+        std::lock_guard<Lock> guard(lock_);
+        latency_.beginOrder(0);
+        metrics_.count(Counter::Orders);
 
-    OrderBook::~OrderBook() {
-        // Clean up all dynamically allocated LimitLevels
-        for(auto& pair : bids_) delete pair.second;
-        for(auto& pair : asks_) delete pair.second;
+        if(displayQty == 0 || displayQty >= qty){
+            // Nothing to hide: a plain limit order
+            if(restOrder(id, price, qty, side)) match(side);
+        }
+        else if(orderMap_.find(id) || stops_.contains(id)){
+            sink_.onReject(Reject{id, RejectReason::DuplicateOrderId});
+            metrics_.count(Counter::Rejects);
+        }
+        else if(!isValidPrice(price, side)){
+            sink_.onReject(Reject{id, RejectReason::InvalidPrice});
+            metrics_.count(Counter::Rejects);
+        }
+        else{
+            placeIceberg(id, price, qty, displayQty, side);
+        }
+        endInstruction();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::restoreIceberg(OrderId id, Price price, Quantity shown, Quantity reserve, Quantity displayQty, Side side){
+        std::lock_guard<Lock> guard(lock_);
+        latency_.beginOrder(0);
+        metrics_.count(Counter::Orders);
+
+        if(restOrder(id, price, shown, side) && reserve > 0){
+            icebergs_.insert(id, Iceberg{displayQty, reserve});
+            getLimitLevel(price, side)->addIceberg();
+        }
+        endInstruction();
     }
 
-    void OrderBook::addOrder(OrderId id, Price price, Quantity qty, Side side){
-        // 1. Idemptency Check: Don't add duplicate IDs
-        if(orderMap_.find(id) != orderMap_.end()){
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::placeIceberg(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side){
+        const Price previousTrade = lastTradePrice_;
+
+        // 1. The whole quantity takes liquidity first, so the resting iceberg is never a taker
+        Quantity remaining = (side == Side::Buy) ? sweep(asks_, id, price, qty, side) : sweep(bids_, id, price, qty, side);
+
+        // 2. Show one slice, hide the rest
+        if(remaining > 0){
+            const Quantity slice = std::min(displayQty, remaining);
+            if(restOrder(id, price, slice, side) && remaining > slice){
+                icebergs_.insert(id, Iceberg{displayQty, remaining - slice});
+                getLimitLevel(price, side)->addIceberg();
+            }
+        }
+        checkStops(previousTrade);
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    bool BasicOrderBook<Ladder, Index, Sink, Lock>::replenishIceberg(Order* order, LimitLevel* level){
+        Iceberg* iceberg = icebergs_.find(order->id);
+        if(!iceberg){
+            return false;
+        }
+
+        const Quantity slice = std::min(iceberg->displayQty, iceberg->reserve);
+        iceberg->reserve -= slice;
+        level->replenish(order, slice);
+
+        // The last slice is on display: from now on it is a plain order
+        if(iceberg->reserve == 0){
+            icebergs_.erase(order->id);
+            level->removeIceberg();
+        }
+        return true;
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    Quantity BasicOrderBook<Ladder, Index, Sink, Lock>::dropIceberg(OrderId id, LimitLevel& level){
+        const Iceberg* iceberg = icebergs_.find(id);
+        if(!iceberg){
+            return 0;
+        }
+        const Quantity hidden = iceberg->reserve;
+        icebergs_.erase(id);
+        level.removeIceberg();
+        return hidden;
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::releaseStops(){
+        // Stops released by a released stop are picked up by this loop, not by a nested one
+        if(releasingStops_){
             return;
         }
+        releasingStops_ = true;
+
+        StopOrder stop;
+        while(stops_.popTriggered(lastTradePrice_, stop)){
+            if(stop.type != OrderType::Limit){
+                executeImmediate(stop.id, stop.price, stop.qty, stop.side, stop.type);
+            }
+            else if(restOrder(stop.id, stop.price, stop.qty, stop.side) && isCrossed()){
+                match(stop.side);
+            }
+        }
+        releasingStops_ = false;
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    bool BasicOrderBook<Ladder, Index, Sink, Lock>::restOrder(OrderId id, Price price, Quantity qty, Side side){
+        // 1. Idemptency Check: Don't add duplicate IDs (resting orders and parked stops share one ID space)
+        if(orderMap_.find(id) || stops_.contains(id)){
+            sink_.onReject(Reject{id, RejectReason::DuplicateOrderId});
+            metrics_.count(Counter::Rejects);
+            return false;
+        }
+
+        // Tick Check: The flat ladder can only store prices on its tick grid, within reach of its window.
+        if(!isValidPrice(price, side)){
+            sink_.onReject(Reject{id, RejectReason::InvalidPrice});
+            metrics_.count(Counter::Rejects);
+            return false;
+        }
 
         // 2. Fast Allocation: Get a pre-allocated object from the pool (O(1))
         Order* order = orderPool_.allocate(id, price, qty, side);
         if(!order)
         {
-            std::cerr << "[Error] Order Pool Exhausted!\n";
-            return;
+            sink_.onReject(Reject{id, RejectReason::PoolExhausted});
+            metrics_.count(Counter::Rejects);
+            return false;
         }
 
         // 3. Indexing: Map ID -> Pointer for O(1) cancellation later
-        orderMap_[id] = order;
+        orderMap_.insert(id, order);
 
         // 4. Update the Book: Add to the specific Price Level
         LimitLevel* level = getLimitLevel(price, side);
         level->append(order);
+        publishLevel(*level, side);
+        return true;
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::executeImmediate(OrderId id, Price price, Quantity qty, Side side, OrderType type){
+        const Price previousTrade = lastTradePrice_;
+
+        // The ID of a parked stop stays reserved for it
+        if(stops_.contains(id)) [[unlikely]] {
+            sink_.onReject(Reject{id, RejectReason::DuplicateOrderId});
+            metrics_.count(Counter::Rejects);
+            return;
+        }
+
+        // Market orders accept any price on the opposite side
+        Price limit = price;
+        if(type == OrderType::Market){
+            limit = (side == Side::Buy) ? std::numeric_limits<Price>::max() : 0;
+        }
+
+        // 1. FOK Pre-Check: the aggregated depth says whether a complete fill is possible
+        if(type == OrderType::FillOrKill){
+            const FillEstimate reach = (side == Side::Buy) ? asks_.estimateFill(qty, limit) : bids_.estimateFill(qty, limit);
+            if(reach.filled < qty){
+                sink_.onCancel(Cancel{id, qty});
+                metrics_.count(Counter::Cancels);
+                return;
+            }
+        }
+
+        // 2. Take liquidity directly from the opposite side
+        Quantity remaining = (side == Side::Buy) ? sweep(asks_, id, limit, qty, side) : sweep(bids_, id, limit, qty, side);
+
+        // 3. Nothing rests: discard the remainder
+        if(remaining > 0){
+            sink_.onCancel(Cancel{id, remaining});
+            metrics_.count(Counter::Cancels);
+        }
+
+        // 4. The trades may have reached parked stops
+        checkStops(previousTrade);
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    template <typename RestingLadder>
+    Quantity BasicOrderBook<Ladder, Index, Sink, Lock>::sweep(RestingLadder& resting, OrderId id, Price limit, Quantity qty, Side side){
+        const Side restingSide = (side == Side::Buy) ? Side::Sell : Side::Buy;
+        while(qty > 0){
+            LimitLevel* level = resting.best();
+            if(!level){
+                break;
+            }
+
+            // Price Check: stop at the first level beyond the limit
+            Price levelPrice = level->getPrice();
+            if((side == Side::Buy) ? levelPrice > limit : levelPrice < limit){
+                break;
+            }
+
+            Order* head = level->getHead();
+            if(head->next){
+                prefetchForWrite(head->next);
+            }
+            else{
+                resting.prefetchNext();
+            }
+            Quantity quantity = std::min(qty, head->quantity);
+
+            // Trades print at the resting order's price
+            if(side == Side::Buy) sink_.onTrade(Trade{id, head->id, levelPrice, quantity});
+            else sink_.onTrade(Trade{head->id, id, levelPrice, quantity});
+            latency_.onTrade();
+            metrics_.count(Counter::Trades);
+            metrics_.count(Counter::TradedQuantity, quantity);
+
+            level->fill(head, quantity);
+            qty -= quantity;
+            lastTradePrice_ = levelPrice;
+
+            // A filled iceberg slice stays (replenished at the back of the level), anything else leaves
+            if(head->quantity == 0 && (level->getIcebergCount() == 0 || !replenishIceberg(head, level))) [[likely]] {
+                level->remove(head);
+                orderMap_.erase(head->id);
+                orderPool_.deallocate(head);
+            }
+
+            // One BookUpdate per level touched: when it empties, or where the sweep ends
+            if(level->isEmpty()){
+                publishLevel(*level, restingSide);
+                resting.erase(level);
+            }
+            else if(qty == 0){
+                publishLevel(*level, restingSide);
+            }
+        }
+        return qty;
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::endInstruction(){
+        sink_.flush();
+        latency_.endOrder();
+
+        if constexpr (METRICS_ENABLED){
+            metrics_.count(Counter::Instructions);
+            metrics_.set(Gauge::RestingOrders, orderMap_.size());
+            metrics_.set(Gauge::IndexCapacity, orderMap_.capacity());
+            metrics_.set(Gauge::PoolInUse, orderPool_.getCapacity() - orderPool_.getFreeCount());
+            metrics_.set(Gauge::PoolCapacity, orderPool_.getCapacity());
+            metrics_.set(Gauge::BidLevels, bids_.size());
+            metrics_.set(Gauge::AskLevels, asks_.size());
+        }
+
+        Quote quote;
+        if(const LimitLevel* bid = bids_.best()){
+            quote.bidPrice = bid->getPrice();
+            quote.bidVolume = bid->getVolume();
+            quote.bidOrders = bid->getOrderCount();
+        }
+        if(const LimitLevel* ask = asks_.best()){
+            quote.askPrice = ask->getPrice();
+            quote.askVolume = ask->getVolume();
+            quote.askOrders = ask->getOrderCount();
+        }
+
+        // Most instructions happen behind the top of book: leave the readers' cache line alone.
+        if(!quote.sameLevels(lastQuote_)){
+            lastQuote_ = quote;
+            topOfBook_.publish(quote);
+        }
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    bool BasicOrderBook<Ladder, Index, Sink, Lock>::isCrossed() const {
+        const LimitLevel* bid = bids_.best();
+        const LimitLevel* ask = asks_.best();
+        return bid && ask && bid->getPrice() >= ask->getPrice();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::prefetchRequest(const OrderRequest& request) const {
+        orderMap_.prefetch(request.id);
+        if(request.type != RequestType::Cancel){
+            if(request.side == Side::Buy) bids_.prefetch(request.price);
+            else asks_.prefetch(request.price);
+        }
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::addOrders(std::span<const OrderRequest> orders){
+        // One acquisition for the whole burst
+        std::lock_guard<Lock> guard(lock_);
+        for(size_t i = 0; i < orders.size(); ++i){
+            if(i + PREFETCH_DISTANCE < orders.size()){
+                prefetchRequest(orders[i + PREFETCH_DISTANCE]);
+            }
+
+            const OrderRequest& req = orders[i];
+
+            // The book is never left crossed, so only the order just posted can create a cross:
+            // if it did not, match() would be a no-op and is skipped.
+            latency_.beginOrder(getSentAt(req));
+            metrics_.count(Counter::Orders);
+            if(req.orderType != OrderType::Limit){
+                executeImmediate(req.id, req.price, req.qty, req.side, req.orderType);
+            }
+            else if(restOrder(req.id, req.price, req.qty, req.side) && isCrossed()){
+                match(req.side);
+            }
+            endInstruction();
+        }
+    }
 
-        // 5. Attempt Execution: Check if this new order crosses the spread
-        match();
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::applyBatch(std::span<const OrderRequest> requests){
+        std::lock_guard<Lock> guard(lock_);
+        for(size_t i = 0; i < requests.size(); ++i){
+            if(i + PREFETCH_DISTANCE < requests.size()){
+                prefetchRequest(requests[i + PREFETCH_DISTANCE]);
+            }
+
+            const OrderRequest& req = requests[i];
+            switch(req.type){
+                case RequestType::Add:
+                    latency_.beginOrder(getSentAt(req));
+                    metrics_.count(Counter::Orders);
+                    if(req.orderType != OrderType::Limit){
+                        executeImmediate(req.id, req.price, req.qty, req.side, req.orderType);
+                    }
+                    else if(restOrder(req.id, req.price, req.qty, req.side) && isCrossed()){
+                        match(req.side);
+                    }
+                    break;
+
+                case RequestType::Cancel:
+                    removeOrder(req.id);
+                    break;
+
+                case RequestType::Modify:
+                    latency_.beginOrder(getSentAt(req));
+                    amendOrder(req.id, req.price, req.qty);
+                    break;
+            }
+            endInstruction();
+        }
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::publishSnapshot(size_t depth){
+        std::lock_guard<Lock> guard(lock_);
+        sink_.onSnapshot(BookSnapshot{depth});
+
+        auto publishSide = [&](const auto& ladder, Side side){
+            size_t published = 0;
+            ladder.forEachLevelWhile([&](const LimitLevel& level){
+                publishLevel(level, side);
+                return depth == 0 || ++published < depth;
+            });
+        };
+        publishSide(bids_, Side::Buy);
+        publishSide(asks_, Side::Sell);
+        sink_.flush();
     }
 
-    void OrderBook::printBook() const {
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::printBook() const {
+        std::lock_guard<Lock> guard(lock_);
         std::cout << "\n--- ORDER BOOK SNAPSHOT ---\n";
 
         std::cout << "ASKS (Sellers):\n";
         // Iterate in reverse to show highest prices at the top
-        for(auto it = asks_.rbegin(); it != asks_.rend(); ++it){
-            std::cout << " Price: " << it->first << " | Vol: " << it->second->getVolume() << "\n";
-        }
+        asks_.forEachLevelReverse([](const LimitLevel& level){
+            std::cout << " Price: " << level.getPrice() << " | Vol: " << level.getVolume() << "\n";
+        });
 
         std::cout << "-----------------------------\n";
 
         std::cout << "BIDS (Buyers):\n";
-        for(auto const& [price, level] : bids_){
-            std::cout << " Price: " << price << " | Vol: " << level->getVolume() << "\n";
-        }
+        bids_.forEachLevel([](const LimitLevel& level){
+            std::cout << " Price: " << level.getPrice() << " | Vol: " << level.getVolume() << "\n";
+        });
 
         std::cout << "-----------------------------\n";
     }
 
-    LimitLevel* OrderBook::getLimitLevel(Price price, Side side){
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    bool BasicOrderBook<Ladder, Index, Sink, Lock>::isValidPrice(Price price, Side side) const {
+        return (side == Side::Buy) ? bids_.isValidPrice(price) : asks_.isValidPrice(price);
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    LimitLevel* BasicOrderBook<Ladder, Index, Sink, Lock>::getLimitLevel(Price price, Side side){
         if(side == Side::Buy){
-            if(bids_.find(price) == bids_.end()){
-                bids_[price] = new LimitLevel(price);
-            }
-            return bids_[price];
+            return bids_.getOrCreate(price);
         }
         else{
-            if(asks_.find(price) == asks_.end()){
-                asks_[price] = new LimitLevel(price);
-            }
-            return asks_[price];
+            return asks_.getOrCreate(price);
         }
     }
 
-    void OrderBook::match(){
-        while (true){
-            // Stop if one side is empty
-            if(bids_.empty() || asks_.empty()){
-                break;
-            }
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::match(Side aggressor){
+        const Price previousTrade = lastTradePrice_;
 
-            // Get the best prices (Top of Book)
-            auto bestBidLevel = bids_.begin()->second;
-            auto bestAskLevel = asks_.begin()->second;
+        // Resolve the orientation once: the kernel below is then specialised for each side.
+        if(aggressor == Side::Buy) cross(bids_, asks_, Side::Buy);
+        else cross(asks_, bids_, Side::Sell);
 
-            // Spread Check: If Bid < Ask, no trade is possible.
-            if(bestBidLevel->getPrice() < bestAskLevel->getPrice()){
-                break;
-            }
+        // Stops are only looked at if this match moved the last trade price
+        checkStops(previousTrade);
+    }
 
-            // Get the oldest orders (FIFO) at these levels
-            Order* bidOrder = bestBidLevel->getHead();
-            Order* askOrder = bestAskLevel->getHead();
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    template <typename TakerLadder, typename MakerLadder>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::cross(TakerLadder& takers, MakerLadder& makers, Side takerSide){
+        LimitLevel* takerLevel = takers.best();
 
-            // Calculate fill quantity (min of both)
-            Quantity quantity = std::min(bidOrder->quantity, askOrder->quantity);
+        while(takerLevel){
+            // 1. Spread Check: stop once the best prices no longer cross (or the makers are exhausted)
+            LimitLevel* makerLevel = makers.best();
+            if(!makerLevel){
+                break;
+            }
+            LimitLevel* bidLevel = (takerSide == Side::Buy) ? takerLevel : makerLevel;
+            LimitLevel* askLevel = (takerSide == Side::Buy) ? makerLevel : takerLevel;
+            if(bidLevel->getPrice() < askLevel->getPrice()){
+                break;
+            }
+            // Trades print at the resting order's price, as in sweep()
+            const Price price = makerLevel->getPrice();
 
-            std::cout << ">>> TRADE EXECUTE: " << quantity << " shares @ " << bestAskLevel->getPrice() << " (Bid #" << bidOrder->id << " vs Ask #" << askOrder->id << ")\n";
+            // The level after this one is next in line if the sweep continues
+            makers.prefetchNext();
 
-            // Update quantities
-            bidOrder->quantity -= quantity;
-            askOrder->quantity -= quantity;
+            // 2. Fill Kernel: both levels stay hoisted until one of them runs out. Only a maker level holding an
+            //    iceberg gets the variant that replenishes filled slices.
+            if(makerLevel->getIcebergCount() == 0) [[likely]] {
+                fillLevels<false>(takerLevel, makerLevel, price, takerSide);
+            }
+            else{
+                fillLevels<true>(takerLevel, makerLevel, price, takerSide);
+            }
+            lastTradePrice_ = price;
 
-            // Cleanup: If Bid is fully filled
-            if(bidOrder->quantity == 0){
-                bestBidLevel->remove(bidOrder);  // Unlink from list
-                orderMap_.erase(bidOrder->id);   // Remove from index
-                orderPool_.deallocate(bidOrder); // Return to pool
+            // 3. One BookUpdate per level pair (bids first, as the sink always sees them)
+            publishLevel(*bidLevel, Side::Buy);
+            publishLevel(*askLevel, Side::Sell);
 
-                // If the entire price level is empty, remove it
-                if(bestBidLevel->isEmpty()){
-                    delete bestBidLevel;
-                    bids_.erase(bids_.begin()); // Iterator invalidation safe because we restart loop
-                }   
+            // 4. Drop emptied levels. A taker level that empties ends the sweep unless the next one also crosses.
+            if(makerLevel->isEmpty()){
+                makers.erase(makerLevel);
             }
+            if(takerLevel->isEmpty()){
+                takers.erase(takerLevel);
+                takerLevel = takers.best();
+            }
+        }
+    }
 
-            // Cleanup: If Ask if fully filled
-            if(askOrder->quantity == 0){
-                bestAskLevel->remove(askOrder);
-                orderMap_.erase(askOrder->id);
-
-                orderPool_.deallocate(askOrder);
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    template <bool Icebergs>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::fillLevels(LimitLevel* takerLevel, LimitLevel* makerLevel, Price price, Side takerSide){
+        Order* taker = takerLevel->getHead();
+        Order* maker = makerLevel->getHead();
+        while(true){
+            Order* nextMaker = maker->next;
+            if(nextMaker){
+                prefetchForWrite(nextMaker);
+            }
 
-                if(bestAskLevel->isEmpty()){
-                    delete bestAskLevel;
-                    asks_.erase(asks_.begin());
+            Quantity quantity = std::min(taker->quantity, maker->quantity);
+            if(takerSide == Side::Buy) sink_.onTrade(Trade{taker->id, maker->id, price, quantity});
+            else sink_.onTrade(Trade{maker->id, taker->id, price, quantity});
+            latency_.onTrade();
+            metrics_.count(Counter::Trades);
+            metrics_.count(Counter::TradedQuantity, quantity);
+
+            takerLevel->fill(taker, quantity);
+            makerLevel->fill(maker, quantity);
+
+            // Sweeping: the resting order is consumed and the aggressor carries on to the next one
+            const bool makerFilled = maker->quantity == 0;
+            if(makerFilled) [[likely]] {
+                if(Icebergs && replenishIceberg(maker, makerLevel)){
+                    // The slice went to the back of the queue: whatever is now at the head is next
+                    nextMaker = makerLevel->getHead();
                 }
+                else{
+                    makerLevel->remove(maker);
+                    orderMap_.erase(maker->id);
+                    orderPool_.deallocate(maker);
+                }
+            }
+
+            // The aggressor is done (the last fill of every sweep)
+            if(taker->quantity == 0) [[unlikely]] {
+                takerLevel->remove(taker);
+                orderMap_.erase(taker->id);
+                orderPool_.deallocate(taker);
+                if(takerLevel->isEmpty()) return;
+                taker = takerLevel->getHead();
+                if(!makerFilled) continue;
             }
+
+            if(!nextMaker) return;
+            maker = nextMaker;
         }
     }
 
-    void OrderBook::cancelOrder(OrderId id){
-        auto it = orderMap_.find(id);
-        if(it == orderMap_.end()){
-            std::cout << "[Error] Cancel failed: Order #" << id << " not found.\n";
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::cancelOrder(OrderId id){
+        std::lock_guard<Lock> guard(lock_);
+        removeOrder(id);
+        endInstruction();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::removeOrder(OrderId id){
+        // Lookup and unindex in a single probe
+        Order* order = orderMap_.extract(id);
+        if(!order){
+            // Not resting: it may be a parked stop
+            Quantity parked = 0;
+            if(stops_.cancel(id, parked)){
+                sink_.onCancel(Cancel{id, parked});
+                metrics_.count(Counter::Cancels);
+                return;
+            }
+            sink_.onReject(Reject{id, RejectReason::UnknownOrder});
+            metrics_.count(Counter::Rejects);
             return;
         }
 
-        Order* order = it->second;
-        LimitLevel* level = getLimitLevel(order->price, order->side);
+        Side side = order->side;
+        Quantity remaining = order->quantity;
+        LimitLevel* level = (side == Side::Buy) ? bids_.find(order->price) : asks_.find(order->price);
+
+        // An iceberg's hidden reserve is cancelled with it
+        if(level->getIcebergCount() != 0) [[unlikely]] {
+            remaining += dropIceberg(id, *level);
+        }
 
         // 1. Remove from the Linked List (O(1))
         level->remove(order);
 
-        // 2. Remove from the Index (O(1))
-        orderMap_.erase(it);
-
-        // 3. Return memory to pool (O(1))
+        // 2. Return memory to pool (O(1))
         orderPool_.deallocate(order);
 
-        // 4. Cleanup empty levels to keep the tree small
+        sink_.onCancel(Cancel{id, remaining});
+
+        metrics_.count(Counter::Cancels);
+        publishLevel(*level, side);
+
+        // 3. Cleanup empty levels to keep the ladder small
         if(level->isEmpty()){
-            if(order->side == Side::Buy){
-                bids_.erase(order->price);
+            if(side == Side::Buy){
+                bids_.erase(level);
             }
             else{
-                asks_.erase(order->price);
+                asks_.erase(level);
+            }
+        }
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::modifyOrder(OrderId id, Price newPrice, Quantity newQty){
+        std::lock_guard<Lock> guard(lock_);
+        latency_.beginOrder(0);
+        amendOrder(id, newPrice, newQty);
+        endInstruction();
+    }
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::amendOrder(OrderId id, Price newPrice, Quantity newQty){
+        if(newQty == 0){
+            removeOrder(id);
+            return;
+        }
+
+        Order* order = orderMap_.find(id);
+        if(!order){
+            sink_.onReject(Reject{id, RejectReason::UnknownOrder});
+            metrics_.count(Counter::Rejects);
+            return;
+        }
+        if(!isValidPrice(newPrice, order->side)){
+            sink_.onReject(Reject{id, RejectReason::InvalidPrice});
+            metrics_.count(Counter::Rejects);
+            return;
+        }
+
+        Side side = order->side;
+        LimitLevel* level = (side == Side::Buy) ? bids_.find(order->price) : asks_.find(order->price);
+
+        // 0. Iceberg: leaves the book and re-enters with the new total (sweep, then a fresh slice at the back)
+        if(level->getIcebergCount() != 0) [[unlikely]] {
+            if(const Iceberg* iceberg = icebergs_.find(id)){
+                const Quantity displayQty = iceberg->displayQty;
+                dropIceberg(id, *level);
+                level->remove(order);
+                orderMap_.erase(id);
+                orderPool_.deallocate(order);
+                publishLevel(*level, side);
+                if(level->isEmpty()){
+                    if(side == Side::Buy) bids_.erase(level);
+                    else asks_.erase(level);
+                }
+                sink_.onModify(Modify{id, newPrice, newQty});
+                metrics_.count(Counter::Modifies);
+                placeIceberg(id, newPrice, newQty, displayQty, side);
+                return;
             }
-            delete level;
         }
-        std::cout << ">>> Cancelled Order #" << id << "\n";
+
+        // 1. Same price, size down: the only amendment that keeps time priority. Cannot cross.
+        if(newPrice == order->price && newQty <= order->quantity){
+            level->reduce(order, newQty);
+            sink_.onModify(Modify{id, newPrice, newQty});
+            metrics_.count(Counter::Modifies);
+            publishLevel(*level, side);
+            return;
+        }
+
+        // 2. Size up: requeue at the tail of the same level
+        if(newPrice == order->price){
+            level->remove(order);
+            order->quantity = newQty;
+            level->append(order);
+            sink_.onModify(Modify{id, newPrice, newQty});
+            metrics_.count(Counter::Modifies);
+            publishLevel(*level, side);
+            return;
+        }
+
+        // 3. Price change: unlink (dropping the old level if it empties), then relink the same object.
+        //    The index still maps id -> order, so neither the pool nor orderMap_ is touched.
+        level->remove(order);
+        publishLevel(*level, side);
+        if(level->isEmpty()){
+            if(side == Side::Buy) bids_.erase(level);
+            else asks_.erase(level);
+        }
+
+        order->price = newPrice;
+        order->quantity = newQty;
+        LimitLevel* target = getLimitLevel(newPrice, side);
+        target->append(order);
+        sink_.onModify(Modify{id, newPrice, newQty});
+        metrics_.count(Counter::Modifies);
+        publishLevel(*target, side);
+
+        // 4. Only the amended order can have created a cross
+        if(isCrossed()){
+            match(side);
+        }
     }
-}
\ No newline at end of file
+
+    template <template <Side> class Ladder, typename Index, typename Sink, typename Lock>
+    void BasicOrderBook<Ladder, Index, Sink, Lock>::publishLevel(const LimitLevel& level, Side side){
+        if(side == Side::Buy) bids_.syncVolume(level);
+        else asks_.syncVolume(level);
+        sink_.onBookUpdate(BookUpdate{level.getPrice(), level.getVolume(), side});
+    }
+
+    // --- Explicit Instantiations (one per Price Ladder x Order Index x Execution Sink x Lock policy) ---
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, QueueSink, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, QueueSink, SpinLock>;
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, NullSink, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, NullSink, SpinLock>;
+    template class BasicOrderBook<MapPriceLadder, UnorderedOrderIndex, QueueSink, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, UnorderedOrderIndex, QueueSink, SpinLock>;
+    template class BasicOrderBook<MapPriceLadder, UnorderedOrderIndex, NullSink, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, UnorderedOrderIndex, NullSink, SpinLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, QueueSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, QueueSink, SpinLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, NullSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, NullSink, SpinLock>;
+    template class BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, QueueSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, QueueSink, SpinLock>;
+    template class BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, NullSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, NullSink, SpinLock>;
+
+    // Books with the pre-trade risk ledger in their sink (RiskGate.h)
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, RiskSink<QueueSink>, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, RiskSink<NullSink>, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, RiskSink<QueueSink>, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, RiskSink<NullSink>, NoLock>;
+
+    // Books that digest their event stream (EventDigest.h, ReplayVerifier.h)
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, DigestSink, NoLock>;
+    template class BasicOrderBook<MapPriceLadder, UnorderedOrderIndex, DigestSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, DigestSink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, DigestSink, NoLock>;
+
+    // Books that publish into a shared-memory gateway region (SharedMemoryGateway.h)
+    template class BasicOrderBook<MapPriceLadder, OrderIndex, SharedMemorySink, NoLock>;
+    template class BasicOrderBook<FlatPriceLadder, OrderIndex, SharedMemorySink, NoLock>;
+}
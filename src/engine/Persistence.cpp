@@ -0,0 +1,235 @@
+/**
+ * @file Persistence.cpp
+ * @brief Journal writer thread, journal/snapshot parsing and snapshot files.
+ * @details Only JournalWriter::append() runs on the matching thread, and it is a queue push.
+ * Everything that touches a file runs on the writer thread or at startup.
+ */
+#include "LOB/Persistence.h"
+#include <cstring>
+#include <filesystem>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace LOB {
+
+    namespace {
+
+        /**
+         * @brief Flushes stdio buffers and forces the file's data to disk.
+         */
+        bool syncFile(std::FILE* file){
+            if(std::fflush(file) != 0) return false;
+#if defined(__linux__)
+            if(fdatasync(fileno(file)) != 0) return false;
+#endif
+            return true;
+        }
+
+        /**
+         * @brief Makes a rename inside 'directory' durable (best effort where directories cannot be opened).
+         */
+        bool syncDirectory(const std::filesystem::path& directory){
+#if defined(__linux__)
+            int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+            if(fd < 0) return false;
+            bool ok = fsync(fd) == 0;
+            ::close(fd);
+            return ok;
+#else
+            (void)directory;
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Does the file start with a journal header of this version and record size?
+         */
+        bool hasJournalHeader(const MappedFile& file){
+            if(file.size() < sizeof(JournalFileHeader)) return false;
+
+            JournalFileHeader header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            if(std::memcmp(header.magic, JournalFileHeader{}.magic, sizeof(header.magic)) != 0) return false;
+            if(header.version != JournalFileHeader{}.version) return false;
+            return header.recordSize == sizeof(JournalRecord);
+        }
+    }
+
+    JournalWriter::JournalWriter(size_t queueCapacity) : queue_(queueCapacity) {}
+
+    JournalWriter::~JournalWriter(){
+        close();
+    }
+
+    bool JournalWriter::open(const std::string& path){
+        close();
+        std::error_code ec;
+        uint64_t size = std::filesystem::is_regular_file(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+
+        if(size > 0){
+            // 1. Existing journal: validate its header, cut a torn trailing record (possibly the first one),
+            //    continue after its last sequence
+            MappedFile existing;
+            if(!existing.open(path) || !hasJournalHeader(existing)) return false;
+            std::span<const JournalRecord> records = journalRecords(existing);
+            sequence_ = records.empty() ? 0 : records.back().sequence;
+
+            uint64_t whole = sizeof(JournalFileHeader) + records.size_bytes();
+            existing.close();
+            if(whole != size){
+                std::filesystem::resize_file(path, whole, ec);
+                if(ec) return false;
+            }
+            file_ = std::fopen(path.c_str(), "ab");
+        }
+        else{
+            // 2. New journal: header first
+            sequence_ = 0;
+            file_ = std::fopen(path.c_str(), "wb");
+            JournalFileHeader header;
+            if(file_ && std::fwrite(&header, sizeof(header), 1, file_) != 1){
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+        }
+        if(!file_) return false;
+
+        failed_.store(false, std::memory_order_relaxed);
+        lost_.store(0, std::memory_order_relaxed);
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this]{ run(); });
+        return true;
+    }
+
+    void JournalWriter::close(){
+        if(thread_.joinable()){
+            running_.store(false, std::memory_order_release);
+            thread_.join();
+        }
+        if(file_){
+            bool ok = syncFile(file_);
+            ok = (std::fclose(file_) == 0) && ok;
+            if(!ok) failed_.store(true, std::memory_order_release);
+            file_ = nullptr;
+        }
+    }
+
+    uint64_t JournalWriter::append(const OrderRequest& request){
+        JournalRecord record{0, request.id, request.price, request.qty, request.symbol,
+                             request.side, request.type, request.orderType};
+        return push(record);
+    }
+
+    uint64_t JournalWriter::appendStop(OrderId id, Price stopPrice, Price price, Quantity qty, Side side, OrderType type, SymbolId symbol){
+        JournalRecord record{0, id, price, qty, symbol, side, RequestType::Add, type, PersistedKind::Stop, stopPrice};
+        return push(record);
+    }
+
+    uint64_t JournalWriter::appendIceberg(OrderId id, Price price, Quantity qty, Quantity displayQty, Side side, SymbolId symbol){
+        JournalRecord record{0, id, price, qty, symbol, side, RequestType::Add, OrderType::Limit, PersistedKind::Iceberg, 0, displayQty};
+        return push(record);
+    }
+
+    uint64_t JournalWriter::push(JournalRecord& record){
+        record.sequence = ++sequence_;
+        if(!queue_.push(record)) [[unlikely]] {
+            ++stalls_;
+            while(!queue_.push(record)) std::this_thread::yield();
+        }
+        return sequence_;
+    }
+
+    void JournalWriter::run(){
+        while(true){
+            // Read the flag BEFORE draining: everything appended before close() is then written.
+            bool stopping = !running_.load(std::memory_order_acquire);
+
+            // Records count as written once fflush() has handed them to the page cache (survives a process crash).
+            bool wrote = false;
+            uint64_t pending = 0;
+            while(true){
+                std::span<const JournalRecord> burst = queue_.peek_bulk(256);
+                if(burst.empty()) break;
+
+                // After a failure nothing more is written: a journal with a hole would replay the wrong book.
+                size_t stored = 0;
+                if(!failed_.load(std::memory_order_relaxed)){
+                    stored = std::fwrite(burst.data(), sizeof(JournalRecord), burst.size(), file_);
+                }
+                pending += stored;
+                if(stored != burst.size()) [[unlikely]] {
+                    lost_.fetch_add(burst.size() - stored, std::memory_order_release);
+                    failed_.store(true, std::memory_order_release);
+                }
+                queue_.release(burst.size());
+                wrote = true;
+            }
+
+            if(wrote){
+                if(pending > 0 && std::fflush(file_) == 0) written_.fetch_add(pending, std::memory_order_release);
+                else if(pending > 0) [[unlikely]] {
+                    lost_.fetch_add(pending, std::memory_order_release);
+                    failed_.store(true, std::memory_order_release);
+                }
+            }
+            else if(stopping) break;
+            else std::this_thread::yield();
+        }
+    }
+
+    std::span<const JournalRecord> journalRecords(const MappedFile& file){
+        if(!hasJournalHeader(file)) return {};
+
+        size_t count = (file.size() - sizeof(JournalFileHeader)) / sizeof(JournalRecord);
+        return {reinterpret_cast<const JournalRecord*>(file.data() + sizeof(JournalFileHeader)), count};
+    }
+
+    bool readSnapshot(const MappedFile& file, SnapshotFileHeader& header, std::span<const SnapshotOrder>& orders){
+        if(file.size() < sizeof(SnapshotFileHeader)) return false;
+
+        std::memcpy(&header, file.data(), sizeof(header));
+        if(std::memcmp(header.magic, SnapshotFileHeader{}.magic, sizeof(header.magic)) != 0) return false;
+        if(header.version != SnapshotFileHeader{}.version || header.recordSize != sizeof(SnapshotOrder)) return false;
+
+        // A snapshot is all or nothing: a short file is unusable.
+        if(file.size() != sizeof(SnapshotFileHeader) + header.orderCount * sizeof(SnapshotOrder)) return false;
+        orders = {reinterpret_cast<const SnapshotOrder*>(file.data() + sizeof(SnapshotFileHeader)),
+                  static_cast<size_t>(header.orderCount)};
+        return true;
+    }
+
+    bool writeSnapshot(const std::string& path, const Snapshot& snapshot){
+        const std::string tmp = path + ".tmp";
+        std::error_code ec;
+
+        // 1. Write and sync the temporary file: it must be complete on disk before it can replace anything
+        std::FILE* out = std::fopen(tmp.c_str(), "wb");
+        if(!out) return false;
+
+        SnapshotFileHeader header;
+        header.lastSequence = snapshot.lastSequence;
+        header.orderCount = snapshot.orders.size();
+        header.lastTradePrice = snapshot.lastTradePrice;
+        bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+        if(ok && !snapshot.orders.empty()){
+            ok = std::fwrite(snapshot.orders.data(), sizeof(SnapshotOrder), snapshot.orders.size(), out) == snapshot.orders.size();
+        }
+        ok = ok && syncFile(out);
+        ok = (std::fclose(out) == 0) && ok;
+        if(!ok){
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+
+        // 2. Atomically replace the old snapshot, then make the new directory entry durable
+        std::filesystem::rename(tmp, path, ec);
+        if(ec){
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return syncDirectory(std::filesystem::path(path).parent_path());
+    }
+}
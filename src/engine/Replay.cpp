@@ -0,0 +1,208 @@
+/**
+ * @file Replay.cpp
+ * @brief Replay file I/O (memory mapping, writing) and the ITCH-style capture converter.
+ * @details None of this runs on the matching thread's hot path: files are mapped once, and conversion
+ * is an offline step that produces the fixed-width records the Replayer consumes.
+ */
+#include "LOB/ReplayFormat.h"
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace LOB {
+
+    MappedFile::~MappedFile(){
+        close();
+    }
+
+    bool MappedFile::open(const std::string& path){
+        close();
+#if defined(__linux__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) return false;
+
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size == 0){
+            ::close(fd);
+            return false;
+        }
+
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if(p == MAP_FAILED) return false;
+
+        // Replays stream front to back: ask for aggressive read-ahead.
+        madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = p;
+        size_ = static_cast<size_t>(st.st_size);
+        mapped_ = true;
+        return true;
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if(!in) return false;
+        fallback_.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        if(fallback_.empty() || !in.read(reinterpret_cast<char*>(fallback_.data()), fallback_.size())) return false;
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+        return true;
+#endif
+    }
+
+    void MappedFile::close(){
+#if defined(__linux__)
+        if(mapped_) munmap(const_cast<void*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        fallback_.clear();
+    }
+
+    std::span<const ReplayRecord> MappedFile::records() const {
+        if(size_ < sizeof(ReplayFileHeader)) return {};
+
+        ReplayFileHeader header;
+        std::memcpy(&header, data_, sizeof(header));
+        if(std::memcmp(header.magic, ReplayFileHeader{}.magic, sizeof(header.magic)) != 0) return {};
+        if(header.version != 1 || header.recordSize != sizeof(ReplayRecord)) return {};
+
+        // Never trust the count beyond what is actually in the file.
+        size_t available = (size_ - sizeof(ReplayFileHeader)) / sizeof(ReplayRecord);
+        size_t count = header.recordCount < available ? static_cast<size_t>(header.recordCount) : available;
+        return {reinterpret_cast<const ReplayRecord*>(data() + sizeof(ReplayFileHeader)), count};
+    }
+
+    bool writeReplayFile(const std::string& path, std::span<const ReplayRecord> records){
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+
+        ReplayFileHeader header;
+        header.recordCount = records.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+        return static_cast<bool>(out);
+    }
+
+    namespace {
+        // ITCH integers are big-endian and unaligned.
+        uint64_t readBE(const unsigned char* p, size_t bytes){
+            uint64_t v = 0;
+            for(size_t i = 0; i < bytes; ++i) v = (v << 8) | p[i];
+            return v;
+        }
+
+        struct LiveOrder {
+            Quantity shares;
+            Price price;
+            Side side;
+            SymbolId symbol;
+        };
+    }
+
+    ItchStats convertItch(std::span<const unsigned char> capture, std::vector<ReplayRecord>& out){
+        ItchStats stats;
+        std::unordered_map<OrderId, LiveOrder> live;
+
+        auto emit = [&](uint64_t ts, OrderId id, Price price, Quantity qty, SymbolId symbol, ReplayEventType type, Side side){
+            out.push_back(ReplayRecord{ts, id, price, qty, symbol, type, side});
+            ++stats.converted;
+        };
+
+        size_t pos = 0;
+        while(pos + 2 <= capture.size()){
+            size_t length = static_cast<size_t>(readBE(&capture[pos], 2));
+            if(pos + 2 + length > capture.size()){
+                stats.truncated = true;
+                break;
+            }
+            const unsigned char* m = &capture[pos + 2];
+            pos += 2 + length;
+            ++stats.messages;
+            if(length < 19){ // shorter than the smallest order message
+                ++stats.skipped;
+                continue;
+            }
+
+            // Common prefix: type(1) stockLocate(2) trackingNumber(2) timestamp(6) orderReference(8)
+            char type = static_cast<char>(m[0]);
+            SymbolId locate = static_cast<SymbolId>(readBE(m + 1, 2));
+            uint64_t ts = readBE(m + 5, 6);
+            OrderId ref = readBE(m + 11, 8);
+
+            switch(type){
+                case 'A':
+                case 'F': {
+                    if(length < 36){ ++stats.skipped; break; }
+                    Side side = (m[19] == 'B') ? Side::Buy : Side::Sell;
+                    Quantity shares = readBE(m + 20, 4);
+                    Price price = readBE(m + 32, 4);
+                    live[ref] = LiveOrder{shares, price, side, locate};
+                    emit(ts, ref, price, shares, locate, ReplayEventType::Add, side);
+                    break;
+                }
+                case 'E':
+                case 'C': {
+                    if(length < 31){ ++stats.skipped; break; }
+                    auto it = live.find(ref);
+                    if(it == live.end()){ ++stats.orphans; break; }
+                    Quantity executed = readBE(m + 19, 4);
+                    emit(ts, ref, it->second.price, executed, it->second.symbol, ReplayEventType::Execute, it->second.side);
+                    if(executed >= it->second.shares) live.erase(it);
+                    else it->second.shares -= executed;
+                    break;
+                }
+                case 'X': {
+                    if(length < 23){ ++stats.skipped; break; }
+                    auto it = live.find(ref);
+                    if(it == live.end()){ ++stats.orphans; break; }
+                    Quantity cancelled = readBE(m + 19, 4);
+                    LiveOrder& o = it->second;
+                    if(cancelled >= o.shares){
+                        emit(ts, ref, o.price, 0, o.symbol, ReplayEventType::Cancel, o.side);
+                        live.erase(it);
+                    }
+                    else{
+                        o.shares -= cancelled;
+                        emit(ts, ref, o.price, o.shares, o.symbol, ReplayEventType::Modify, o.side);
+                    }
+                    break;
+                }
+                case 'D': {
+                    auto it = live.find(ref);
+                    if(it == live.end()){ ++stats.orphans; break; }
+                    emit(ts, ref, it->second.price, 0, it->second.symbol, ReplayEventType::Cancel, it->second.side);
+                    live.erase(it);
+                    break;
+                }
+                case 'U': {
+                    if(length < 35){ ++stats.skipped; break; }
+                    auto it = live.find(ref);
+                    if(it == live.end()){ ++stats.orphans; break; }
+                    LiveOrder replaced = it->second;
+                    live.erase(it);
+
+                    OrderId newRef = readBE(m + 19, 8);
+                    replaced.shares = readBE(m + 27, 4);
+                    replaced.price = readBE(m + 31, 4);
+                    emit(ts, ref, replaced.price, 0, replaced.symbol, ReplayEventType::Cancel, replaced.side);
+                    emit(ts, newRef, replaced.price, replaced.shares, replaced.symbol, ReplayEventType::Add, replaced.side);
+                    live[newRef] = replaced;
+                    break;
+                }
+                default:
+                    ++stats.skipped;
+                    break;
+            }
+        }
+        if(pos < capture.size() && !stats.truncated) stats.truncated = true;
+        return stats;
+    }
+}
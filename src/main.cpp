@@ -4,6 +4,9 @@
  * @details
  * This is the visual entry point for the project. It runs a continuous simulation
  * of market data and renders a "Bloomberg Terminal" style TUI (Text User Interface).
+ * The ladder is rendered from a DepthBook replica fed by the book's event stream, never by walking the book.
+ * With '--persist DIR' every order is journaled and the book is snapshotted every few seconds; a restart
+ * resumes from DIR/nanobook.snap + the tail of DIR/nanobook.journal instead of starting empty.
  * * NOTE: This is for demonstration purposes. For actual performance measurements,
  * see 'src/benchmark.cpp'.
  */
@@ -13,7 +16,10 @@
 #include <chrono>
 #include <random>
 #include <iomanip>
+#include <string>
 #include "LOB/OrderBook.h"
+#include "LOB/DepthBook.h"
+#include "LOB/Persistence.h"
 
 /**
  * @brief Clears the console screen using ANSI escape codes.
@@ -29,19 +35,45 @@ void clearScreen() {
 /**
  * @brief Prints the static dashboard header.
  * @param orders Total number of orders processed in this session.
+ * @param book The engine, whose measured entry -> first fill latency is shown (NANOBOOK_LATENCY builds).
  */
-void printHeader(int orders) {
+void printHeader(int orders, const LOB::OrderBook& book) {
     std::cout << "================================================================\n";
-    std::cout << "   NANOBOOK v3.0  |  HFT ENGINE  |  LATENCY: <5ns  |  OPS: " << orders << "\n";
+    std::cout << "   NANOBOOK v3.0  |  HFT ENGINE  |  ";
+#if NANOBOOK_LATENCY
+    const LOB::LatencyHistogram& match = book.getLatency().get(LOB::LatencyStage::Match);
+    std::cout << "MATCH p50: " << match.percentile(50.0) << "ns p99: " << match.percentile(99.0) << "ns";
+#else
+    (void)book;
+    std::cout << "LATENCY: n/a";
+#endif
+    std::cout << "  |  OPS: " << orders << "\n";
     std::cout << "================================================================\n";
     std::cout << "   [BID]                       [ASK]                \n";
     std::cout << "   Vol      Price  |  Price      Vol                \n";
     std::cout << "----------------------------------------------------------------\n";
 }
 
-int main() {
+int main(int argc, char** argv) {
     // The core engine instance
     LOB::OrderBook book;
+
+    // --- Optional Persistence: warm restart from snapshot + journal tail ---
+    std::string persistDir = (argc == 3 && std::string(argv[1]) == "--persist") ? argv[2] : "";
+    LOB::JournalWriter journal;
+    std::thread snapshotWriter;
+    uint64_t nextId = 1;
+    if(!persistDir.empty()){
+        LOB::RecoveryStats recovered = LOB::recover(book, persistDir + "/nanobook.snap", persistDir + "/nanobook.journal");
+        nextId = recovered.maxOrderId + 1;
+        std::cout << "[Persist] restored " << recovered.restoredOrders << " orders + " << recovered.replayedCommands
+                  << " journaled commands in " << recovered.elapsedNanos / 1000 << " us\n";
+        if(!journal.open(persistDir + "/nanobook.journal")){
+            std::cerr << "[Persist] cannot open the journal in " << persistDir << "\n";
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
     
     // --- Random Number Generation Setup ---
     // We use std::mt19937 (Mersenne Twister) for high-quality random numbers
@@ -58,6 +90,14 @@ int main() {
     std::uniform_int_distribution<> sideDist(0, 1);
 
     int ordersProcessed = 0;
+
+    // Trade tape: the engine reports fills as events, the dashboard drains them between frames.
+    uint64_t tradesExecuted = 0;
+    LOB::ExecutionEvent lastTrade;
+
+    // L2 replica: rebuilt from the BookUpdate deltas; resynced by a snapshot if the event queue ever overflowed.
+    LOB::DepthBook depth;
+    uint64_t droppedSeen = 0;
     
     // --- Main Simulation Loop ---
     while (true) {
@@ -68,29 +108,54 @@ int main() {
             LOB::Quantity q = qtyDist(gen);
             LOB::Side s = (sideDist(gen) == 0) ? LOB::Side::Buy : LOB::Side::Sell;
             
-            // Static ID ensures unique Order IDs across iterations
-            static uint64_t id = 1;
-            
             // The Engine Call: This is where the magic happens (O(1) / O(log N))
-            book.addOrder(id++, p, q, s);
+            LOB::OrderRequest request{nextId++, p, q, s, LOB::RequestType::Add};
+            if(!persistDir.empty()) journal.append(request);
+            book.addOrder(request.id, request.price, request.qty, request.side);
             ordersProcessed++;
         }
 
-        // 2. Render the TUI (Text User Interface)
+        // Every ~5 s: copy the book here (no I/O), write it from another thread
+        if(!persistDir.empty() && ordersProcessed % 500 == 0){
+            if(snapshotWriter.joinable()) snapshotWriter.join();
+            snapshotWriter = std::thread([snapshot = LOB::captureSnapshot(book, journal.getSequence()), persistDir]{
+                LOB::writeSnapshot(persistDir + "/nanobook.snap", snapshot);
+            });
+        }
+
+        // 2. Drain the execution events produced by this burst
+        if(book.getSink().getDroppedCount() != droppedSeen){
+            droppedSeen = book.getSink().getDroppedCount();
+            book.publishSnapshot();
+        }
+        LOB::ExecutionEvent event;
+        while(book.getSink().events().pop(event)){
+            depth.apply(event);
+            if(event.type == LOB::EventType::Trade){
+                lastTrade = event;
+                tradesExecuted++;
+            }
+        }
+
+        // 3. Render the TUI (Text User Interface)
         clearScreen();
-        printHeader(ordersProcessed);
+        printHeader(ordersProcessed, book);
         
-        // Print the top levels of the book
-        book.printBook(); 
+        // Print the top levels of the book (from the replica)
+        depth.print(std::cout, 10);
         
         std::cout << "\n----------------------------------------------------------------\n";
+        std::cout << " Trades: " << tradesExecuted;
+        if(tradesExecuted > 0) std::cout << "  |  Last " << lastTrade;
+        std::cout << "\n";
         std::cout << " System Status:  [ONLINE]  Matching Engine Active\n";
         std::cout << " Press Ctrl+C to Exit\n";
 
-        // 3. Throttle the display
+        // 4. Throttle the display
         // We sleep for 100ms so the human eye can actually read the numbers.
         // In a real HFT system, we would NEVER sleep!
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
+    if(snapshotWriter.joinable()) snapshotWriter.join();
     return 0;
 }
\ No newline at end of file
@@ -6,48 +6,91 @@
  * 1. Network Thread (Producer): Represents the NIC (Network Interface Card) receiving packets.
  * 2. Engine Thread (Consumer): Represents the dedicated core processing the Order Book.
  * 3. LockFreeQueue (Ring Buffer): The "lockless bridge" transferring data between threads.
+ * 4. Logger Thread (Consumer): Drains the engine's execution events off the hot path.
+ * 5. Latency Report: push -> pop -> book entry -> first fill, as p50/p99/p99.9/max per stage.
+ * 6. Placement (optional): `NanoSimulation [--pin NETWORK_CORE ENGINE_CORE] [--mlock]` pins both hot threads;
+ *    the engine thread builds the queue and the book after pinning, so their pages are local to its core.
+ * 7. Verification (`NanoSimulation --verify [COUNT]`): a mixed add / cancel / modify / IOC / FOK / market stream
+ *    runs through the reference book (std::map ladders, std::unordered_map index, one call per request) and the
+ *    optimized one (flat ladders, dense index, huge pages, batches) on two threads. Their rolling per-sequence
+ *    XXH64 digests must match; otherwise the first divergent sequence number and both event lists are printed.
+ * 8. Metrics (`--metrics PATH`): a background exporter samples the book's counters / gauges and both queues every
+ *    100ms into a Prometheus text file (NANOBOOK_METRICS builds); the engine thread never formats or writes.
  *
  * * Key Takeaway: The Matching Engine runs at 100% speed without ever waiting for a mutex.
  */
 #include <iostream>
 #include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <vector>
 #include "LOB/OrderBook.h"
 #include "LOB/LockFreeQueue.h"
+#include "LOB/OrderRequest.h"
+#include "LOB/ThreadAffinity.h"
+#include "LOB/ReplayVerifier.h"
+#include "LOB/MetricsExporter.h"
 
-// A struct representing a raw packet from the exchange.
-// In a real system, this would be a specialized network packet (e.g., UDP/TCP payload).
-struct OrderRequest {
-    LOB::OrderId id;
-    LOB::Price price;
-    LOB::Quantity qty;
-    LOB::Side side;
-    bool isCancel;
+/**
+ * @brief Core assignment of the hot threads and the optional metrics file (from the command line).
+ */
+struct Placement {
+    bool pin = false;
+    unsigned networkCore = 0;
+    unsigned engineCore = 1;
+    bool lockMemory = false;
+    const char* metricsPath = nullptr;
 };
 
+static Placement parsePlacement(int argc, char** argv){
+    Placement placement;
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "--pin") == 0 && i + 2 < argc){
+            placement.pin = true;
+            placement.networkCore = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            placement.engineCore = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if(std::strcmp(argv[i], "--mlock") == 0){
+            placement.lockMemory = true;
+        }
+        else if(std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc){
+            placement.metricsPath = argv[++i];
+        }
+    }
+    return placement;
+}
+
 /**
  * @brief The Producer Thread (Simulates Network Hardware)
  * @details
- * Generates orders as fast as possible and pushes them into the Ring Buffer.
+ * Generates orders as fast as possible and writes them straight into the Ring Buffer slots
+ * (try_claim/commit), so no temporary OrderRequest is built and copied.
  * If the buffer is full, it "busy waits" (spins) until space is available.
  */
-void networkThread(LOB::LockFreeQueue<OrderRequest>& queue){
+void networkThread(LOB::LockFreeQueue<LOB::OrderRequest>& queue){
     std::cout << "[Network] Started. Generating 500,000 orders...\n";
 
     for(int i=0; i<500000; ++i){
-        OrderRequest req = {
-            (uint64_t)i,                  // Unique ID
-            100 + (uint64_t)(i % 10),     // Price 100-109
-            10,                           // Quantity
-            (i % 2 == 0 ? LOB::Side::Buy : LOB::Side::Sell), // Alternate Buy/Sell
-            false                         // Not a cancellation
-        };
-
         // Busy Wait Strategy:
         // We do not sleep if the queue is full. We spin until the Engine catches up.
         // This avoids the latency penalty of context switching.
-        while(!queue.push(req)){
+        LOB::OrderRequest* slot;
+        while(!(slot = queue.try_claim())){
             // In a real Low-Latency setup, we might use _mm_pause() here.
         }
+
+        *slot = {
+            (uint64_t)i,                  // Unique ID
+            100 + (uint64_t)(i % 10),     // Price 100-109
+            10,                           // Quantity
+            (i % 2 == 0 ? LOB::Side::Buy : LOB::Side::Sell), // Alternate Buy/Sell
+            LOB::RequestType::Add         // Not a cancellation
+        };
+        LOB::stampSent(*slot);            // Push timestamp (no-op without NANOBOOK_LATENCY)
+        queue.commit();
     }
     std::cout << "[Network] DONE. All orders pushed.\n";
 }
@@ -55,25 +98,26 @@ void networkThread(LOB::LockFreeQueue<OrderRequest>& queue){
 /**
  * @brief The Consumer Thread (The Matching Engine)
  * @details
- * Polls the Ring Buffer for new messages.
+ * Polls the Ring Buffer for new messages and hands every contiguous run of them to the book
+ * in place (peek_bulk -> applyBatch -> release): one index update per batch, no copies.
  * Note: This thread owns the OrderBook exclusively, so it needs NO locks for the book itself.
  */
-void engineThread(LOB::LockFreeQueue<OrderRequest>& queue, LOB::OrderBook& book){
+void engineThread(LOB::LockFreeQueue<LOB::OrderRequest>& queue, LOB::OrderBook& book){
     std::cout << "[Engine] Started. Waiting for data...\n";
-    
-    int processedCount = 0;
+    constexpr size_t MAX_BATCH = 64;
+
+    size_t processedCount = 0;
     while(processedCount < 500000){
-        OrderRequest req;
-        
-        // Non-blocking pop. If false, the queue is empty.
-        if(queue.pop(req)){
-            if(req.isCancel){
-                book.cancelOrder(req.id);
+        // Non-blocking peek. An empty span means the queue is empty.
+        std::span<const LOB::OrderRequest> batch = queue.peek_bulk(MAX_BATCH);
+        if(!batch.empty()){
+            if constexpr(LOB::LATENCY_ENABLED){
+                LOB::Timestamp popped = LOB::LatencyClock::now();
+                for(const auto& req : batch) book.getLatency().record(LOB::LatencyStage::QueueWait, LOB::getSentAt(req), popped);
             }
-            else{
-                book.addOrder(req.id, req.price, req.qty, req.side);
-            }
-            processedCount++;
+            book.applyBatch(batch);
+            queue.release(batch.size());
+            processedCount += batch.size();
         }
         // If queue is empty, we just loop again immediately (Busy Wait).
         // The CPU core is dedicated 100% to this while loop.
@@ -81,25 +125,189 @@ void engineThread(LOB::LockFreeQueue<OrderRequest>& queue, LOB::OrderBook& book)
     std::cout << "[Engine] DONE. Processed " << processedCount << " orders.\n";
 }
 
-int main(){
+/**
+ * @brief The Logger Thread (Drop-Copy Consumer)
+ * @details
+ * Drains the OrderBook's QueueSink. Formatting and I/O happen here, so the engine
+ * thread never touches std::cout. Runs until the engine is done AND the queue is empty.
+ */
+void loggerThread(LOB::LockFreeQueue<LOB::ExecutionEvent>& events, const std::atomic<bool>& engineDone){
+    uint64_t trades = 0, cancels = 0, rejects = 0, updates = 0, modifies = 0;
+    LOB::ExecutionEvent event;
+
+    while(true){
+        // Read the flag BEFORE draining: everything the engine published before finishing is then visible.
+        bool done = engineDone.load(std::memory_order_acquire);
+
+        while(events.pop(event)){
+            switch(event.type){
+                case LOB::EventType::Trade:      ++trades;  break;
+                case LOB::EventType::Cancel:     ++cancels; break;
+                case LOB::EventType::Reject:     ++rejects; break;
+                case LOB::EventType::BookUpdate: ++updates; break;
+                case LOB::EventType::Modify:     ++modifies; break;
+                case LOB::EventType::BookSnapshot: break;   // the engine never requests snapshots here
+            }
+        }
+        if(done) break;
+    }
+    std::cout << "[Logger] DONE. Trades: " << trades << " | Cancels: " << cancels
+              << " | Rejects: " << rejects
+              << " | Modifies: " << modifies << " | Level Updates: " << updates << "\n";
+}
+
+/**
+ * @brief A deterministic stream exercising every instruction and order type around a drifting mid.
+ */
+static std::vector<LOB::OrderRequest> verificationFlow(size_t count){
+    std::mt19937_64 rng(2026);
+    std::vector<LOB::OrderRequest> flow;
+    std::vector<LOB::OrderId> live;
+    flow.reserve(count);
+
+    for(LOB::OrderId id = 1; flow.size() < count; ++id){
+        LOB::Price mid = 10000 + (id / 5000) % 20 * 10;
+        LOB::Side side = (rng() & 1) ? LOB::Side::Buy : LOB::Side::Sell;
+        LOB::Price price = mid + rng() % 41 - 20;
+        LOB::Quantity qty = 1 + rng() % 100;
+        uint64_t roll = rng() % 100;
+
+        if(roll < 35 && !live.empty()){
+            size_t pick = rng() % live.size();
+            flow.push_back({live[pick], 0, 0, side, LOB::RequestType::Cancel});
+            live[pick] = live.back();
+            live.pop_back();
+        }
+        else if(roll < 50 && !live.empty()){
+            flow.push_back({live[rng() % live.size()], price, qty, side, LOB::RequestType::Modify});
+        }
+        else{
+            LOB::OrderType type = roll < 90 ? LOB::OrderType::Limit
+                                : roll < 95 ? LOB::OrderType::ImmediateOrCancel
+                                : roll < 98 ? LOB::OrderType::FillOrKill : LOB::OrderType::Market;
+            flow.push_back({id, price, qty, side, LOB::RequestType::Add, type});
+            if(type == LOB::OrderType::Limit) live.push_back(id);
+        }
+    }
+    return flow;
+}
+
+/**
+ * @brief --verify: reference vs optimized book over the same stream, compared per sequence number.
+ * @return The process exit code (1 on divergence).
+ */
+static int runVerification(size_t count){
+    using Reference = LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::DigestSink>;
+    using Candidate = LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::DigestSink>;
+
+    std::cout << "--- DETERMINISTIC REPLAY VERIFICATION ---\n";
+    std::vector<LOB::OrderRequest> flow = verificationFlow(count);
+
+    LOB::BookConfig reference;
+    reference.orderPoolCapacity = 65536;
+    reference.orderPoolGrowable = true;
+
+    LOB::BookConfig candidate = reference;
+    candidate.orderIndexMode = LOB::OrderIndexMode::Dense;   // the generator issues increasing IDs
+    candidate.orderIndexCapacity = count + 1;
+    candidate.useHugePages = true;
+    candidate.ladderTicks = 256;                             // small window: recentering is exercised too
+
+    LOB::VerifyReport report = LOB::verifyReplay<Reference, Candidate>(flow, reference, candidate, 64);
+    std::cout << "[Verify] " << report.instructions << " instructions | reference "
+              << report.referenceNanos / 1000000 << " ms | candidate " << report.candidateNanos / 1000000 << " ms\n";
+    std::cout << std::hex << "[Verify] digests: reference 0x" << report.referenceDigest
+              << " | candidate 0x" << report.candidateDigest << std::dec << "\n";
+
+    if(report.identical()){
+        std::cout << "[Verify] IDENTICAL: every sequence number produced the same events.\n";
+        return 0;
+    }
+    std::cout << "[Verify] DIVERGED at sequence " << report.firstDivergence << "\n";
+    std::cout << "  Reference:\n";
+    for(const auto& event : report.referenceEvents) std::cout << "    " << event << "\n";
+    std::cout << "  Candidate:\n";
+    for(const auto& event : report.candidateEvents) std::cout << "    " << event << "\n";
+    return 1;
+}
+
+int main(int argc, char** argv){
+    if(argc > 1 && std::strcmp(argv[1], "--verify") == 0){
+        return runVerification(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 500000);
+    }
+
     std::cout << "--- LOCK-FREE ARCHITECTURE DEMO ---\n";
+    const Placement placement = parsePlacement(argc, argv);
 
-    // 1. Initialize the Ring Buffer (Size 1024)
-    // Acts as the buffer between Network Card and CPU.
-    LOB::LockFreeQueue<OrderRequest> queue(1024);
-    
-    // 2. Initialize the Engine
+    // 1. The Ring Buffer (Size 1024) and the Engine are built by the engine thread (step 3), once pinned,
+    // so their memory is first-touched on that core's NUMA node.
     // Note: We use the standard 'OrderBook', NOT 'ThreadSafeOrderBook'.
     // The Lock-Free Queue guarantees that only one thread accesses the engine at a time.
-    LOB::OrderBook book;
+    // The order pool grows by whole pre-touched slabs, so a burst of resting orders is never rejected.
+    std::optional<LOB::LockFreeQueue<LOB::OrderRequest>> queue;
+    std::optional<LOB::OrderBook> book;
+    LOB::BookConfig config;
+    config.orderPoolCapacity = 65536;
+    config.orderPoolGrowable = true;
+    config.lockPages = placement.lockMemory;
+
+    // 2. Engine Thread: pin, allocate, signal ready, then match
+    std::atomic<bool> ready{false};
+    std::atomic<bool> engineDone{false};
+    std::thread consumer([&]{
+        if(placement.pin && !LOB::pinThisThread(placement.engineCore)){
+            std::cout << "[Engine] Could not pin to core " << placement.engineCore << ".\n";
+        }
+        queue.emplace(1024);
+        book.emplace(config);
+        ready.store(true, std::memory_order_release);
+
+        engineThread(*queue, *book);
+        engineDone.store(true, std::memory_order_release);
+    });
+    while(!ready.load(std::memory_order_acquire)) std::this_thread::yield();
+
+    // 3. Everything hot is allocated: lock it in RAM before the first order arrives
+    if(placement.lockMemory && !LOB::lockProcessMemory()){
+        std::cout << "[Main] mlockall refused (needs CAP_IPC_LOCK or a larger RLIMIT_MEMLOCK).\n";
+    }
+
+    // 4. Off-thread metrics (sampled by the exporter, never formatted on the engine thread)
+    LOB::MetricsRegistry registry;
+    registry.addBook("SIM", book->getMetrics());
+    registry.addQueue("ingress", *queue);
+    registry.addQueue("events", book->getSink().events());
+    std::optional<LOB::MetricsExporter> exporter;
+    if(placement.metricsPath){
+        exporter.emplace(registry, LOB::ExporterOptions{std::chrono::milliseconds(100), placement.metricsPath, {}});
+        exporter->start();
+    }
 
-    // 3. Launch Threads (Pinning to cores would happen here in production)
-    std::thread producer(networkThread, std::ref(queue));
-    std::thread consumer(engineThread, std::ref(queue), std::ref(book));
+    // 5. Network and Logger Threads
+    std::thread producer([&]{
+        if(placement.pin && !LOB::pinThisThread(placement.networkCore)){
+            std::cout << "[Network] Could not pin to core " << placement.networkCore << ".\n";
+        }
+        networkThread(*queue);
+    });
+    std::thread logger(loggerThread, std::ref(book->getSink().events()), std::cref(engineDone));
 
-    // 4. Wait for completion
+    // 6. Wait for completion
     producer.join();
     consumer.join();
+    logger.join();
+    if(exporter){
+        exporter->stop();
+        std::cout << "[Metrics] Final sample written to " << placement.metricsPath << ".\n";
+    }
+
+    if(book->getSink().getDroppedCount() > 0){
+        std::cout << "[Engine] WARNING: " << book->getSink().getDroppedCount() << " events dropped (logger too slow).\n";
+    }
+
+    // 7. Latency report (per pipeline stage, recorded on the engine thread)
+    std::cout << "[Latency]\n";
+    book->getLatency().print(std::cout);
 
     std::cout << "--- SIMULATION COMPLETE ---\n";
     return 0;
@@ -0,0 +1,73 @@
+/**
+ * @file CompactOrderTests.cpp
+ * @brief Unit Tests for the compact (index-linked) order layout.
+ * @details
+ * Verified functionality:
+ * 1. Layout: size and side packing
+ * 2. IndexPool handle allocation, recycling and exhaustion
+ * 3. CompactLevel FIFO order, removal from the middle and volume tracking
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/LOB/CompactOrder.h"
+
+using Compact = LOB::CompactOrder<uint32_t, uint32_t>;
+
+// 1. Layout
+TEST(CompactOrderTest, PacksSideIntoPrevLink) {
+    EXPECT_EQ(sizeof(Compact), 24u);
+    EXPECT_EQ(sizeof(LOB::CompactOrder<uint64_t, uint64_t>), 32u);
+
+    Compact sell(1, 100, 10, LOB::Side::Sell);
+    EXPECT_EQ(sell.side(), LOB::Side::Sell);
+    EXPECT_EQ(sell.prev(), Compact::NIL);
+
+    sell.setPrev(12345);
+    EXPECT_EQ(sell.prev(), 12345u);
+    EXPECT_EQ(sell.side(), LOB::Side::Sell);
+
+    Compact buy(2, 100, 10, LOB::Side::Buy);
+    buy.setPrev(7);
+    EXPECT_EQ(buy.side(), LOB::Side::Buy);
+}
+
+// 2. Handles
+TEST(CompactOrderTest, IndexPoolRecyclesHandles) {
+    LOB::IndexPool<Compact> pool(2);
+    uint32_t a = pool.allocate(1, 100, 10, LOB::Side::Buy);
+    uint32_t b = pool.allocate(2, 101, 20, LOB::Side::Sell);
+    EXPECT_EQ(pool.allocate(3, 102, 30, LOB::Side::Buy), LOB::IndexPool<Compact>::NIL);
+
+    pool.deallocate(a);
+    uint32_t c = pool.allocate(4, 103, 40, LOB::Side::Sell);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(pool[c].id, 4u);
+    EXPECT_EQ(pool[c].next, Compact::NIL);
+    EXPECT_EQ(pool[b].quantity, 20u);
+}
+
+// 3. Queue semantics match LimitLevel
+TEST(CompactOrderTest, LevelKeepsTimePriority) {
+    LOB::IndexPool<Compact> pool(8);
+    LOB::CompactLevel<Compact> level(100);
+    std::vector<uint32_t> ids;
+    for(uint32_t i = 0; i < 4; ++i){
+        ids.push_back(pool.allocate(i, 100, 10 * (i + 1), LOB::Side::Buy));
+        level.append(ids.back(), pool);
+    }
+    EXPECT_EQ(level.getVolume(), 100u);
+
+    level.remove(ids[1], pool);
+    level.fill(ids[0], 5, pool);
+    EXPECT_EQ(level.getVolume(), 75u);
+
+    std::vector<LOB::OrderId> walk;
+    for(uint32_t i = level.getHead(); i != Compact::NIL; i = pool[i].next) walk.push_back(pool[i].id);
+    EXPECT_EQ(walk, (std::vector<LOB::OrderId>{0, 2, 3}));
+
+    level.remove(ids[3], pool);
+    level.remove(ids[0], pool);
+    level.remove(ids[2], pool);
+    EXPECT_TRUE(level.isEmpty());
+    EXPECT_EQ(level.getVolume(), 0u);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file DepthBookTests.cpp
+ * @brief Unit Tests for the incremental depth feed (coalesced BookUpdates, snapshots, DepthBook replica).
+ * @details
+ * Verified functionality:
+ * 1. One delta per touched level per instruction (coalescing)
+ * 2. A replica fed only by the event stream matches the book after random flow
+ * 3. Snapshots rebuild a replica that joined late
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <utility>
+#include "../include/LOB/OrderBook.h"
+#include "../include/LOB/DepthBook.h"
+
+namespace {
+    std::vector<LOB::ExecutionEvent> drain(LOB::OrderBook& book){
+        std::vector<LOB::ExecutionEvent> events;
+        LOB::ExecutionEvent event;
+        while(book.getSink().events().pop(event)) events.push_back(event);
+        return events;
+    }
+
+    std::vector<std::pair<LOB::Price, LOB::Quantity>> levels(const LOB::DepthBook& depth, LOB::Side side){
+        std::vector<LOB::DepthLevel> buffer(256);
+        size_t n = (side == LOB::Side::Buy) ? depth.getBids(buffer) : depth.getAsks(buffer);
+        std::vector<std::pair<LOB::Price, LOB::Quantity>> out;
+        for(size_t i = 0; i < n; ++i) out.emplace_back(buffer[i].price, buffer[i].volume);
+        return out;
+    }
+}
+
+// 1. A sweep fills three orders at one level: one BookUpdate for it, after the trades
+TEST(DepthFeedTest, CoalescesLevelUpdatesPerInstruction) {
+    LOB::OrderBook book;
+    for(LOB::OrderId id = 1; id <= 3; ++id) book.addOrder(id, 100, 10, LOB::Side::Sell);
+    book.addOrder(4, 101, 10, LOB::Side::Sell);
+    drain(book);
+
+    book.addOrder(5, 101, 35, LOB::Side::Buy);
+    std::vector<LOB::BookUpdate> updates;
+    size_t trades = 0;
+    for(const auto& e : drain(book)){
+        if(e.type == LOB::EventType::Trade){
+            EXPECT_TRUE(updates.empty()); // deltas are published at the end of the instruction
+            ++trades;
+        }
+        if(e.type == LOB::EventType::BookUpdate) updates.push_back(e.update);
+    }
+    EXPECT_EQ(trades, 4u);
+    ASSERT_EQ(updates.size(), 3u); // bid 101 (posted, then consumed), ask 100, ask 101
+    EXPECT_EQ(updates[0].side, LOB::Side::Buy);
+    EXPECT_EQ(updates[0].volume, 0u);
+    EXPECT_EQ(updates[1].price, 100u);
+    EXPECT_EQ(updates[1].volume, 0u);
+    EXPECT_EQ(updates[2].price, 101u);
+    EXPECT_EQ(updates[2].volume, 5u);
+}
+
+// 2. Deltas alone keep the replica identical to the book (checked against the top of book and a fresh snapshot)
+TEST(DepthFeedTest, ReplicaTracksBookFromDeltas) {
+    LOB::OrderBook book;
+    LOB::DepthBook replica;
+    std::mt19937 gen(5);
+
+    for(LOB::OrderId id = 1; id <= 3000; ++id){
+        LOB::Side side = (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell;
+        switch(gen() % 4){
+            case 0:  book.cancelOrder(id - 1 - gen() % 20); break;
+            case 1:  book.modifyOrder(id - 1 - gen() % 20, 95 + gen() % 11, 1 + gen() % 30); break;
+            default: book.addOrder(id, 95 + gen() % 11, 1 + gen() % 30, side); break;
+        }
+        for(const auto& e : drain(book)) replica.apply(e);
+    }
+
+    ASSERT_NE(book.getBestBid(), nullptr);
+    ASSERT_NE(book.getBestAsk(), nullptr);
+    auto bids = levels(replica, LOB::Side::Buy);
+    auto asks = levels(replica, LOB::Side::Sell);
+    ASSERT_FALSE(bids.empty());
+    ASSERT_FALSE(asks.empty());
+    EXPECT_EQ(bids[0].first, book.getBestBid()->getPrice());
+    EXPECT_EQ(bids[0].second, book.getBestBid()->getVolume());
+    EXPECT_EQ(asks[0].first, book.getBestAsk()->getPrice());
+    EXPECT_EQ(asks[0].second, book.getBestAsk()->getVolume());
+
+    LOB::DepthBook fresh;
+    book.publishSnapshot();
+    for(const auto& e : drain(book)) fresh.apply(e);
+    EXPECT_EQ(fresh.getSnapshotCount(), 1u);
+    EXPECT_EQ(levels(fresh, LOB::Side::Buy), bids);
+    EXPECT_EQ(levels(fresh, LOB::Side::Sell), asks);
+}
+
+// 3. A limited snapshot carries only the top N levels per side and replaces stale state
+TEST(DepthFeedTest, SnapshotRebuildsLateReplica) {
+    LOB::OrderBook book;
+    for(LOB::OrderId id = 0; id < 5; ++id){
+        book.addOrder(id, 100 - id, 10, LOB::Side::Buy);
+        book.addOrder(100 + id, 101 + id, 10, LOB::Side::Sell);
+    }
+    drain(book);
+
+    LOB::DepthBook late;
+    late.apply(LOB::ExecutionEvent(LOB::BookUpdate{42, 1, LOB::Side::Buy})); // stale garbage
+    book.publishSnapshot(2);
+    for(const auto& e : drain(book)) late.apply(e);
+
+    using Levels = std::vector<std::pair<LOB::Price, LOB::Quantity>>;
+    EXPECT_EQ(levels(late, LOB::Side::Buy), (Levels{{100, 10}, {99, 10}}));
+    EXPECT_EQ(levels(late, LOB::Side::Sell), (Levels{{101, 10}, {102, 10}}));
+}
@@ -0,0 +1,230 @@
+/**
+ * @file EngineTests.cpp
+ * @brief Unit Tests for the symbol-sharded Engine.
+ * @details
+ * Verified functionality:
+ * 1. Requests reach the book of their own symbol, across several shards
+ * 2. The sharded result equals feeding each symbol's stream into a standalone OrderBook
+ * 3. Unknown symbols are counted, not crashed on
+ * 4. Explicit shard cores: shards pin where told, build their queues there and still route correctly
+ * 5. submit() refuses requests outside start() .. stop(); each book's events can be drained while running
+ * 6. A symbol added between stop() and a restart gets its book; existing books keep their orders
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <map>
+#include "../include/LOB/Engine.h"
+
+static LOB::EngineConfig smallEngine(size_t shards){
+    LOB::EngineConfig config;
+    config.shardCount = shards;
+    config.shardQueueCapacity = 1024;
+    config.book.orderPoolCapacity = 4096;
+    config.book.eventQueueCapacity = 1 << 16;
+    return config;
+}
+
+static void submitAll(LOB::Engine& engine, const std::vector<LOB::OrderRequest>& requests){
+    for(const auto& r : requests){
+        while(!engine.submit(r)) std::this_thread::yield();
+    }
+}
+
+// 1. Every symbol's orders rest only in that symbol's book
+TEST(EngineTest, RoutesToOwningBook) {
+    LOB::Engine engine(smallEngine(3));
+    for(LOB::SymbolId s = 1; s <= 12; ++s) ASSERT_TRUE(engine.addSymbol(s));
+    EXPECT_FALSE(engine.addSymbol(5));
+
+    engine.start();
+    std::vector<LOB::OrderRequest> requests;
+    for(LOB::SymbolId s = 1; s <= 12; ++s){
+        for(LOB::OrderId i = 0; i < s; ++i){
+            requests.push_back({i, 100 - i, 10, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, s});
+        }
+    }
+    submitAll(engine, requests);
+    engine.stop();
+
+    uint64_t processed = 0;
+    for(size_t shard = 0; shard < engine.getShardCount(); ++shard) processed += engine.getProcessedCount(shard);
+    EXPECT_EQ(processed, requests.size());
+
+    for(LOB::SymbolId s = 1; s <= 12; ++s){
+        LOB::OrderBook* book = engine.getBook(s);
+        ASSERT_NE(book, nullptr);
+        EXPECT_EQ(book->getOrderCount(), s);
+        EXPECT_EQ(book->getBestBid()->getPrice(), 100u);
+    }
+}
+
+// 2. Interleaved multi-symbol traffic gives each book exactly the standalone result
+TEST(EngineTest, MatchesStandaloneBooks) {
+    constexpr LOB::SymbolId SYMBOLS = 8;
+    LOB::Engine engine(smallEngine(4));
+    for(LOB::SymbolId s = 0; s < SYMBOLS; ++s) engine.addSymbol(s);
+
+    std::mt19937 gen(11);
+    std::vector<LOB::OrderRequest> requests;
+    for(LOB::OrderId id = 0; id < 8000; ++id){
+        LOB::SymbolId symbol = gen() % SYMBOLS;
+        LOB::Side side = (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell;
+        requests.push_back({id, 95 + gen() % 11, 1 + gen() % 20, side, LOB::RequestType::Add, LOB::OrderType::Limit, symbol});
+    }
+
+    engine.start();
+    submitAll(engine, requests);
+    engine.stop();
+
+    std::map<LOB::SymbolId, std::unique_ptr<LOB::OrderBook>> reference;
+    for(LOB::SymbolId s = 0; s < SYMBOLS; ++s) reference[s] = std::make_unique<LOB::OrderBook>(smallEngine(1).book);
+    for(const auto& r : requests) reference[r.symbol]->addOrder(r.id, r.price, r.qty, r.side);
+
+    for(LOB::SymbolId s = 0; s < SYMBOLS; ++s){
+        LOB::OrderBook* book = engine.getBook(s);
+        ASSERT_NE(book, nullptr);
+        EXPECT_EQ(book->getOrderCount(), reference[s]->getOrderCount());
+
+        auto* bid = book->getBestBid();
+        auto* refBid = reference[s]->getBestBid();
+        ASSERT_EQ(bid == nullptr, refBid == nullptr);
+        if(bid){
+            EXPECT_EQ(bid->getPrice(), refBid->getPrice());
+            EXPECT_EQ(bid->getVolume(), refBid->getVolume());
+        }
+        auto* ask = book->getBestAsk();
+        auto* refAsk = reference[s]->getBestAsk();
+        ASSERT_EQ(ask == nullptr, refAsk == nullptr);
+        if(ask){
+            EXPECT_EQ(ask->getPrice(), refAsk->getPrice());
+            EXPECT_EQ(ask->getVolume(), refAsk->getVolume());
+        }
+    }
+}
+
+// 3. A request for an unregistered symbol is counted and dropped
+TEST(EngineTest, CountsUnknownSymbols) {
+    LOB::Engine engine(smallEngine(2));
+    engine.addSymbol(1);
+    engine.start();
+    EXPECT_FALSE(engine.addSymbol(2)); // registration is closed while running
+
+    std::vector<LOB::OrderRequest> requests = {
+        {1, 100, 10, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, 1},
+        {2, 100, 10, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, 2},
+        {3, 100, 10, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, 2},
+    };
+    submitAll(engine, requests);
+    engine.stop();
+
+    uint64_t unknown = 0;
+    for(size_t shard = 0; shard < engine.getShardCount(); ++shard) unknown += engine.getUnknownSymbolCount(shard);
+    EXPECT_EQ(unknown, 2u);
+    EXPECT_EQ(engine.getBook(1)->getOrderCount(), 1u);
+    EXPECT_EQ(engine.getBook(2), nullptr);
+}
+
+// 4. shardCores overrides firstCore + i; the ingress is built by the (pinned) shard thread
+TEST(EngineTest, PinsShardsToExplicitCores) {
+    LOB::EngineConfig config = smallEngine(2);
+    config.pinThreads = true;
+    config.firstCore = 1000;         // would fail: shardCores wins
+    config.shardCores = {0, 0};
+    LOB::Engine engine(config);
+    for(LOB::SymbolId s = 1; s <= 4; ++s) engine.addSymbol(s);
+    EXPECT_EQ(engine.getNumaNode(0), -1);
+
+    engine.start();
+    std::vector<LOB::OrderRequest> requests;
+    for(LOB::SymbolId s = 1; s <= 4; ++s){
+        requests.push_back({s, 100, 10, LOB::Side::Sell, LOB::RequestType::Add, LOB::OrderType::Limit, s});
+        requests.push_back({s + 10, 100, 4, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, s});
+    }
+    submitAll(engine, requests);
+    engine.stop();
+
+    for(size_t shard = 0; shard < engine.getShardCount(); ++shard){
+#if defined(__linux__)
+        EXPECT_TRUE(engine.isPinned(shard));
+        EXPECT_GE(engine.getNumaNode(shard), 0);
+#endif
+    }
+    EXPECT_FALSE(engine.isMemoryLocked());
+    for(LOB::SymbolId s = 1; s <= 4; ++s){
+        EXPECT_EQ(engine.getBook(s)->findOrder(s)->quantity, 6u);
+    }
+}
+
+// 5. Lifecycle guards and live event draining
+TEST(EngineTest, DrainsSinksWhileRunning) {
+    LOB::EngineConfig config = smallEngine(2);
+    config.book.eventQueueCapacity = 64;    // far fewer slots than the events produced below
+    LOB::Engine engine(config);
+    ASSERT_TRUE(engine.addSymbol(1));
+    ASSERT_TRUE(engine.addSymbol(2));
+
+    LOB::OrderRequest request{1, 100, 1, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, 1};
+    EXPECT_FALSE(engine.submit(request));
+    EXPECT_EQ(engine.getSink(1), nullptr);
+
+    engine.start();
+    LOB::QueueSink* sinks[] = {engine.getSink(1), engine.getSink(2)};
+    ASSERT_NE(sinks[0], nullptr);
+    ASSERT_NE(sinks[1], nullptr);
+    EXPECT_EQ(engine.getSink(3), nullptr);
+
+    const LOB::OrderId ORDERS = 2000;
+    uint64_t trades = 0;
+    LOB::ExecutionEvent event;
+    auto drain = [&]{
+        for(LOB::QueueSink* sink : sinks){
+            while(sink->events().pop(event)) trades += (event.type == LOB::EventType::Trade);
+        }
+    };
+    for(LOB::OrderId id = 1; id <= ORDERS; ++id){
+        LOB::OrderRequest r{id, 100, 1, (id % 2) ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add,
+                            LOB::OrderType::Limit, static_cast<LOB::SymbolId>(1 + id % 4 / 2)};
+        while(!engine.submit(r)){
+            drain();
+            std::this_thread::yield();
+        }
+        // Every 16 requests, wait for the shards and drain, so the event queues never overflow
+        if(id % 16 == 0){
+            auto processed = [&]{ return engine.getProcessedCount(0) + engine.getProcessedCount(1); };
+            while(processed() < id){
+                drain();
+                std::this_thread::yield();
+            }
+            drain();
+        }
+    }
+    engine.stop();
+    drain();
+
+    EXPECT_FALSE(engine.submit(request));
+    EXPECT_EQ(sinks[0]->getDroppedCount() + sinks[1]->getDroppedCount(), 0u);
+    EXPECT_EQ(trades, ORDERS / 2);
+}
+
+// 6. stop() -> addSymbol() -> start()
+TEST(EngineTest, RestartBuildsBooksForNewSymbols) {
+    LOB::SilentEngine engine(smallEngine(2));
+    ASSERT_TRUE(engine.addSymbol(1));
+    engine.start();
+    ASSERT_TRUE(engine.submit({1, 100, 5, LOB::Side::Buy, LOB::RequestType::Add, LOB::OrderType::Limit, 1}));
+    engine.stop();
+
+    ASSERT_TRUE(engine.addSymbol(2));
+    EXPECT_EQ(engine.getBook(2), nullptr);
+    engine.start();
+    EXPECT_FALSE(engine.addSymbol(3));
+    ASSERT_TRUE(engine.submit({2, 101, 7, LOB::Side::Sell, LOB::RequestType::Add, LOB::OrderType::Limit, 2}));
+    engine.stop();
+
+    ASSERT_NE(engine.getBook(1), nullptr);
+    ASSERT_NE(engine.getBook(2), nullptr);
+    EXPECT_EQ(engine.getBook(1)->findOrder(1)->quantity, 5u);
+    EXPECT_EQ(engine.getBook(2)->findOrder(2)->quantity, 7u);
+    EXPECT_EQ(engine.getUnknownSymbolCount(0) + engine.getUnknownSymbolCount(1), 0u);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file LatencyTests.cpp
+ * @brief Unit Tests for the latency histograms and the book's stage timestamps.
+ * @details
+ * Verified functionality:
+ * 1. Bucket boundaries (exact below 32, <= 1/32 relative error above)
+ * 2. Percentiles against a sorted reference
+ * 3. Merge of per-thread histograms
+ * 4. The book times entry -> first fill only for orders that trade (NANOBOOK_LATENCY builds)
+ * 5. A crossing amendment is timed from the amendment, not from when the order first rested
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include "../include/LOB/Latency.h"
+#include "../include/LOB/OrderBook.h"
+
+// 1. Every value lands in a bucket whose upper bound is at most ~3% above it
+TEST(LatencyHistogramTest, BucketBounds) {
+    for(uint64_t v = 0; v < 32; ++v){
+        EXPECT_EQ(LOB::LatencyHistogram::bucketUpperBound(LOB::LatencyHistogram::bucketOf(v)), v);
+    }
+    std::mt19937_64 gen(1);
+    for(int i = 0; i < 100000; ++i){
+        uint64_t v = gen() >> (gen() % 40 + 24);
+        uint64_t upper = LOB::LatencyHistogram::bucketUpperBound(LOB::LatencyHistogram::bucketOf(v));
+        ASSERT_GE(upper, v);
+        ASSERT_LE(upper - v, v / 32 + 1);
+    }
+    EXPECT_LT(LOB::LatencyHistogram::bucketOf(~uint64_t{0}), LOB::LatencyHistogram::BUCKETS);
+}
+
+// 2. Percentiles track the exact order statistics within bucket precision
+TEST(LatencyHistogramTest, PercentilesMatchReference) {
+    LOB::LatencyHistogram histogram;
+    std::vector<uint64_t> values;
+    std::mt19937_64 gen(2);
+    std::lognormal_distribution<double> dist(4.0, 1.0); // long right tail, like real latencies
+    for(int i = 0; i < 50000; ++i){
+        uint64_t v = static_cast<uint64_t>(dist(gen));
+        values.push_back(v);
+        histogram.record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    for(double p : {50.0, 90.0, 99.0, 99.9}){
+        uint64_t exact = values[static_cast<size_t>(p / 100.0 * values.size() + 0.999999) - 1];
+        uint64_t reported = histogram.percentile(p);
+        EXPECT_GE(reported, exact);
+        EXPECT_LE(reported, exact + exact / 32 + 1);
+    }
+    EXPECT_EQ(histogram.percentile(100.0), values.back());
+    EXPECT_EQ(histogram.getMax(), values.back());
+    EXPECT_EQ(histogram.getCount(), values.size());
+}
+
+// 3. Combining two writers' histograms
+TEST(LatencyHistogramTest, MergesHistograms) {
+    LOB::LatencyHistogram a, b;
+    for(uint64_t v = 1; v <= 100; ++v) a.record(v);
+    for(uint64_t v = 1000; v <= 1099; ++v) b.record(v);
+    a.merge(b);
+    EXPECT_EQ(a.getCount(), 200u);
+    EXPECT_EQ(a.getMax(), 1099u);
+    EXPECT_LE(a.percentile(50.0), 103u); // 100 shares the bucket [100, 103]
+    EXPECT_GE(a.percentile(51.0), 1000u);
+}
+
+#if NANOBOOK_LATENCY
+// 4. Only aggressive orders produce a Match sample; queued requests also produce Ingress/EndToEnd
+TEST(LatencyTrackerTest, BookRecordsStages) {
+    LOB::OrderBook book;
+    book.addOrder(1, 100, 10, LOB::Side::Sell);
+    book.addOrder(2, 99, 10, LOB::Side::Buy);
+    EXPECT_EQ(book.getLatency().get(LOB::LatencyStage::Match).getCount(), 0u);
+
+    book.addOrder(3, 100, 5, LOB::Side::Buy);
+    EXPECT_EQ(book.getLatency().get(LOB::LatencyStage::Match).getCount(), 1u);
+
+    LOB::OrderRequest sweep{4, 100, 5, LOB::Side::Buy, LOB::RequestType::Add};
+    LOB::stampSent(sweep);
+    book.applyBatch(std::span(&sweep, 1));
+    EXPECT_EQ(book.getLatency().get(LOB::LatencyStage::Match).getCount(), 2u);
+    EXPECT_EQ(book.getLatency().get(LOB::LatencyStage::Ingress).getCount(), 1u);
+    EXPECT_EQ(book.getLatency().get(LOB::LatencyStage::EndToEnd).getCount(), 1u);
+}
+
+// 5. An order that rested for 50 ms and is then repriced through the spread: the Match sample is the amend only
+TEST(LatencyTrackerTest, ModifyIsTimedFromTheAmendment) {
+    LOB::OrderBook book;
+    book.addOrder(1, 100, 10, LOB::Side::Sell);
+    book.addOrder(2, 99, 10, LOB::Side::Buy);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    book.modifyOrder(2, 100, 10);
+    const LOB::LatencyHistogram& match = book.getLatency().get(LOB::LatencyStage::Match);
+    ASSERT_EQ(match.getCount(), 1u);
+    EXPECT_LT(match.getMax(), 10'000'000u);
+}
+#endif
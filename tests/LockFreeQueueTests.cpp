@@ -0,0 +1,126 @@
+/**
+ * @file LockFreeQueueTests.cpp
+ * @brief Unit Tests for the SPSC LockFreeQueue.
+ * @details
+ * Verified functionality:
+ * 1. Power-of-two capacity, full/empty detection and index wrap-around
+ * 2. FIFO order and no loss across a real producer/consumer thread pair
+ * 3. Bulk push/pop across the wrap point, partial bulk on a nearly full queue
+ * 4. Zero-copy claim/commit and front/peek_bulk/release
+ * 5. Every push refused (or cut short) by a full ring is counted
+ */
+#include <gtest/gtest.h>
+#include <thread>
+#include <cstdint>
+#include <vector>
+#include <numeric>
+#include "../include/LOB/LockFreeQueue.h"
+
+// 1. Capacity is rounded up and every slot is usable, across many wraps
+TEST(LockFreeQueueTest, FillsEverySlotAndWraps) {
+    LOB::LockFreeQueue<int> queue(100);
+    ASSERT_EQ(queue.getCapacity(), 128u);
+
+    int value = -1;
+    for(int round = 0; round < 10; ++round){
+        for(int i = 0; i < 128; ++i) ASSERT_TRUE(queue.push(round * 1000 + i));
+        EXPECT_FALSE(queue.push(-1));
+        EXPECT_EQ(queue.size(), 128u);
+
+        for(int i = 0; i < 128; ++i){
+            ASSERT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, round * 1000 + i);
+        }
+        EXPECT_FALSE(queue.pop(value));
+        EXPECT_EQ(queue.size(), 0u);
+    }
+}
+
+// 2. Two threads: every item arrives exactly once, in order
+TEST(LockFreeQueueTest, PreservesOrderAcrossThreads) {
+    constexpr uint64_t COUNT = 1'000'000;
+    LOB::LockFreeQueue<uint64_t> queue(1024);
+
+    std::thread producer([&]{
+        for(uint64_t i = 0; i < COUNT; ++i){
+            while(!queue.push(i)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0, value = 0;
+    while(expected < COUNT){
+        if(queue.pop(value)){
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(queue.pop(value));
+}
+
+// 3. Bulk operations split correctly at the physical end of the buffer
+TEST(LockFreeQueueTest, BulkWrapsAndTruncates) {
+    LOB::LockFreeQueue<int> queue(8);
+    std::vector<int> in(12), out(12, -1);
+    std::iota(in.begin(), in.end(), 0);
+
+    // Move the indices to the middle so the next run wraps.
+    ASSERT_EQ(queue.push_bulk(in.data(), 5), 5u);
+    ASSERT_EQ(queue.pop_bulk(out.data(), 5), 5u);
+
+    EXPECT_EQ(queue.push_bulk(in.data(), 12), 8u); // only 8 slots
+    EXPECT_EQ(queue.push_bulk(in.data(), 1), 0u);
+    EXPECT_EQ(queue.pop_bulk(out.data(), 12), 8u);
+    for(int i = 0; i < 8; ++i) EXPECT_EQ(out[i], i);
+    EXPECT_EQ(queue.pop_bulk(out.data(), 12), 0u);
+}
+
+// 4. In-place produce and consume
+TEST(LockFreeQueueTest, ClaimCommitFrontRelease) {
+    LOB::LockFreeQueue<int> queue(4);
+    EXPECT_EQ(queue.front(), nullptr);
+
+    for(int i = 0; i < 4; ++i){
+        int* slot = queue.try_claim();
+        ASSERT_NE(slot, nullptr);
+        *slot = i * 10;
+        EXPECT_EQ(queue.size(), static_cast<size_t>(i)); // not visible before commit
+        queue.commit();
+    }
+    EXPECT_EQ(queue.try_claim(), nullptr);
+
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(*queue.front(), 0);
+    queue.release();
+
+    std::span<const int> view = queue.peek_bulk(10);
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_EQ(view[0], 10);
+    EXPECT_EQ(view[2], 30);
+    queue.release(view.size());
+
+    EXPECT_EQ(queue.front(), nullptr);
+    EXPECT_NE(queue.try_claim(), nullptr);
+}
+
+// 5. Back-pressure counter
+TEST(LockFreeQueueTest, CountsFullRetries) {
+    LOB::LockFreeQueue<int> queue(4);
+    int items[4] = {1, 2, 3, 4};
+    EXPECT_EQ(queue.push_bulk(items, 4), 4u);
+    EXPECT_EQ(queue.getFullCount(), 0u);
+
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(queue.try_claim(), nullptr);
+    EXPECT_EQ(queue.push_bulk(items, 2), 0u);
+    EXPECT_EQ(queue.getFullCount(), 3u);
+
+    int value = 0;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(queue.push_bulk(items, 2), 1u);   // cut short
+    EXPECT_EQ(queue.getFullCount(), 4u);
+
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_TRUE(queue.push(6));
+    EXPECT_EQ(queue.getFullCount(), 4u);
+}
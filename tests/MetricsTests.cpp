@@ -0,0 +1,152 @@
+/**
+ * @file MetricsTests.cpp
+ * @brief Unit Tests for the book metrics and the off-thread exporter.
+ * @details
+ * Verified functionality:
+ * 1. Both ladders count orders, fills, cancels, modifies, rejects and refresh their gauges (NANOBOOK_METRICS builds)
+ * 2. Prometheus text: counter totals, per-second rates, derived ratios, queue series, label escaping
+ * 3. The exporter replaces its text file and publishes a shared-memory sample a reader can map back
+ */
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "../include/LOB/OrderBook.h"
+#include "../include/LOB/MetricsExporter.h"
+
+namespace {
+
+    std::string readFile(const std::string& path){
+        std::ifstream in(path);
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    bool contains(const std::string& text, const std::string& line){
+        return text.find(line + "\n") != std::string::npos;
+    }
+
+#if NANOBOOK_METRICS
+    template <typename Book>
+    void expectCountedFlow(){
+        Book book;
+        book.addOrder(1, 100, 10, LOB::Side::Sell);
+        book.addOrder(2, 101, 5, LOB::Side::Sell);
+        book.addOrder(3, 100, 4, LOB::Side::Buy);                                   // 1 fill (4)
+        book.addOrder(4, 102, 20, LOB::Side::Buy, LOB::OrderType::ImmediateOrCancel); // 2 fills (6 + 5), 9 cancelled
+        book.addOrder(5, 90, 10, LOB::Side::Buy);
+        book.modifyOrder(5, 91, 10);
+        book.cancelOrder(99);                                                       // unknown
+        book.addOrder(5, 92, 1, LOB::Side::Buy);                                    // duplicate
+        book.cancelOrder(5);
+        book.addOrder(6, 95, 1, LOB::Side::Buy);
+        book.addOrder(7, 110, 1, LOB::Side::Sell);
+
+        const LOB::BookMetrics& m = book.getMetrics();
+        EXPECT_EQ(m.get(LOB::Counter::Instructions), 11u);
+        EXPECT_EQ(m.get(LOB::Counter::Orders), 8u);
+        EXPECT_EQ(m.get(LOB::Counter::Modifies), 1u);
+        EXPECT_EQ(m.get(LOB::Counter::Trades), 3u);
+        EXPECT_EQ(m.get(LOB::Counter::TradedQuantity), 15u);
+        EXPECT_EQ(m.get(LOB::Counter::Cancels), 2u);
+        EXPECT_EQ(m.get(LOB::Counter::Rejects), 2u);
+
+        EXPECT_EQ(m.get(LOB::Gauge::RestingOrders), 2u);
+        EXPECT_EQ(m.get(LOB::Gauge::PoolInUse), 2u);
+        EXPECT_EQ(m.get(LOB::Gauge::PoolCapacity), book.getOrderPool().getCapacity());
+        EXPECT_EQ(m.get(LOB::Gauge::IndexCapacity), book.getOrderIndex().capacity());
+        EXPECT_EQ(m.get(LOB::Gauge::BidLevels), 1u);
+        EXPECT_EQ(m.get(LOB::Gauge::AskLevels), 1u);
+    }
+#endif
+}
+
+#if NANOBOOK_METRICS
+// 1. Known flow, both ladder backends
+TEST(MetricsTest, BookCountsEvents) {
+    expectCountedFlow<LOB::OrderBook>();
+    expectCountedFlow<LOB::FlatOrderBook>();
+}
+#endif
+
+// 2. Rendering of two hand-made samples, two seconds apart
+TEST(MetricsTest, RendersPrometheusText) {
+    LOB::MetricsSnapshot before;
+    before.timestampNanos = 1'000'000'000;
+    before.books.push_back({"AAPL", {}, {}});
+    before.books[0].counters[static_cast<size_t>(LOB::Counter::Orders)] = 100;
+
+    LOB::MetricsSnapshot after = before;
+    after.timestampNanos = 3'000'000'000;
+    after.books[0].counters[static_cast<size_t>(LOB::Counter::Orders)] = 110;
+    after.books[0].gauges[static_cast<size_t>(LOB::Gauge::RestingOrders)] = 3;
+    after.books[0].gauges[static_cast<size_t>(LOB::Gauge::IndexCapacity)] = 12;
+    after.books.push_back({"A\"B", {}, {}});
+    after.queues.push_back({"ingress", 7, 1024, 2});
+
+    std::string first = LOB::renderPrometheus(before);
+    EXPECT_TRUE(contains(first, "# TYPE nanobook_orders_total counter"));
+    EXPECT_TRUE(contains(first, "nanobook_orders_total{book=\"AAPL\"} 100"));
+    EXPECT_EQ(first.find("_per_second"), std::string::npos);
+    EXPECT_EQ(first.find("queue_"), std::string::npos);
+
+    // Different book sets: no rates rather than wrong ones
+    EXPECT_EQ(LOB::renderPrometheus(after, &before).find("_per_second"), std::string::npos);
+
+    LOB::MetricsSnapshot sameBooks = after;
+    sameBooks.books.pop_back();
+    std::string text = LOB::renderPrometheus(sameBooks, &before);
+    EXPECT_TRUE(contains(text, "nanobook_orders_total{book=\"AAPL\"} 110"));
+    EXPECT_TRUE(contains(text, "nanobook_orders_per_second{book=\"AAPL\"} 5.000"));
+    EXPECT_TRUE(contains(text, "nanobook_resting_orders{book=\"AAPL\"} 3"));
+    EXPECT_TRUE(contains(text, "nanobook_index_load_factor{book=\"AAPL\"} 0.250"));
+    EXPECT_TRUE(contains(text, "nanobook_pool_occupancy{book=\"AAPL\"} 0.000"));
+    EXPECT_TRUE(contains(text, "nanobook_queue_depth{queue=\"ingress\"} 7"));
+    EXPECT_TRUE(contains(text, "nanobook_queue_full_total{queue=\"ingress\"} 2"));
+
+    EXPECT_TRUE(contains(LOB::renderPrometheus(after), "nanobook_orders_total{book=\"A\\\"B\"} 0"));
+}
+
+// 3. Both outputs of a running exporter
+TEST(MetricsExporterTest, WritesTextFileAndSharedMemory) {
+    LOB::OrderBook book;
+    LOB::LockFreeQueue<int> queue(8);
+    queue.push(1);
+
+    LOB::MetricsRegistry registry;
+    registry.addBook("BOOK", book.getMetrics());
+    registry.addQueue("ingress", queue);
+
+    const std::string path = ::testing::TempDir() + "nanobook_metrics.prom";
+    const std::string shm = "/nanobook_metrics_test_" + std::to_string(getpid());
+    {
+        LOB::MetricsExporter exporter(registry, LOB::ExporterOptions{std::chrono::milliseconds(5), path, shm});
+        ASSERT_TRUE(exporter.hasSharedMemory());
+
+        exporter.start();
+        book.addOrder(1, 100, 10, LOB::Side::Buy);
+        book.addOrder(2, 100, 4, LOB::Side::Sell);
+        exporter.stop();   // final sample holds both instructions
+
+        std::string text = readFile(path);
+        EXPECT_TRUE(contains(text, "nanobook_queue_depth{queue=\"ingress\"} 1"));
+        EXPECT_TRUE(contains(text, "nanobook_queue_capacity{queue=\"ingress\"} 8"));
+        EXPECT_TRUE(contains(text, "nanobook_instructions_total{book=\"BOOK\"} " + std::to_string(LOB::METRICS_ENABLED ? 2 : 0)));
+
+        LOB::MetricsSnapshot shared;
+        ASSERT_TRUE(LOB::readSharedMetrics(shm, shared));
+        ASSERT_EQ(shared.books.size(), 1u);
+        EXPECT_EQ(shared.books[0].label, "BOOK");
+        EXPECT_EQ(shared.books[0].get(LOB::Counter::TradedQuantity), LOB::METRICS_ENABLED ? 4u : 0u);
+        EXPECT_EQ(shared.books[0].get(LOB::Gauge::RestingOrders), LOB::METRICS_ENABLED ? 1u : 0u);
+        ASSERT_EQ(shared.queues.size(), 1u);
+        EXPECT_EQ(shared.queues[0].label, "ingress");
+        EXPECT_EQ(shared.queues[0].depth, 1u);
+    }
+
+    // The exporter unlinks its region
+    LOB::MetricsSnapshot gone;
+    EXPECT_FALSE(LOB::readSharedMetrics(shm, gone));
+}
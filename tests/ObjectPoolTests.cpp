@@ -0,0 +1,108 @@
+/**
+ * @file ObjectPoolTests.cpp
+ * @brief Unit Tests for the ObjectPool slab allocator.
+ * @details
+ * Verified functionality:
+ * 1. Placement construction (no stale fields or links from a previous tenant)
+ * 2. Exhaustion of a fixed pool and its reporting through the OrderBook
+ * 3. Slab growth without moving existing objects
+ * 4. Cache-line alignment of slabs
+ * 5. Page-locked slabs stay usable whether or not the system grants the lock
+ */
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "../include/LOB/ObjectPool.h"
+#include "../include/LOB/OrderBook.h"
+
+// 1. A recycled slot is a brand new object
+TEST(ObjectPoolTest, ConstructsFreshObjects) {
+    LOB::ObjectPool<LOB::Order> pool(4);
+    LOB::Order other(9, 1, 1, LOB::Side::Sell);
+
+    LOB::Order* first = pool.allocate(1, 100, 10, LOB::Side::Buy);
+    first->next = &other;
+    first->prev = &other;
+    pool.deallocate(first);
+
+    // LIFO: the same slot comes back, but fully re-constructed
+    LOB::Order* second = pool.allocate(2, 105, 20, LOB::Side::Sell);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->id, 2u);
+    EXPECT_EQ(second->price, 105u);
+    EXPECT_EQ(second->quantity, 20u);
+    EXPECT_EQ(second->side, LOB::Side::Sell);
+    EXPECT_EQ(second->next, nullptr);
+    EXPECT_EQ(second->prev, nullptr);
+}
+
+// 2. A fixed pool fails cleanly, and the book reports it as a Reject
+TEST(ObjectPoolTest, FixedPoolExhausts) {
+    LOB::ObjectPool<LOB::Order> pool(2);
+    EXPECT_NE(pool.allocate(1, 100, 10, LOB::Side::Buy), nullptr);
+    EXPECT_NE(pool.allocate(2, 100, 10, LOB::Side::Buy), nullptr);
+    EXPECT_EQ(pool.allocate(3, 100, 10, LOB::Side::Buy), nullptr);
+    EXPECT_EQ(pool.getFreeCount(), 0u);
+
+    LOB::BookConfig config;
+    config.orderPoolCapacity = 1;
+    LOB::OrderBook book(config);
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(2, 101, 10, LOB::Side::Buy);
+
+    LOB::ExecutionEvent event;
+    bool rejected = false;
+    while(book.getSink().events().pop(event)){
+        if(event.type == LOB::EventType::Reject){
+            EXPECT_EQ(event.reject.orderId, 2u);
+            EXPECT_EQ(event.reject.reason, LOB::RejectReason::PoolExhausted);
+            rejected = true;
+        }
+    }
+    EXPECT_TRUE(rejected);
+}
+
+// 3. Growth adds slabs and never relocates live objects
+TEST(ObjectPoolTest, GrowsWithoutMovingObjects) {
+    LOB::ObjectPool<LOB::Order> pool(8, LOB::PoolOptions{true, false});
+    std::vector<LOB::Order*> orders;
+
+    for(uint64_t i = 0; i < 100; ++i){
+        orders.push_back(pool.allocate(i, 100 + i, 10, LOB::Side::Buy));
+        ASSERT_NE(orders.back(), nullptr);
+    }
+    EXPECT_GE(pool.getSlabCount(), 13u);
+    EXPECT_EQ(pool.getCapacity(), pool.getSlabCount() * 8);
+
+    for(uint64_t i = 0; i < 100; ++i){
+        EXPECT_EQ(orders[i]->id, i);
+        EXPECT_EQ(orders[i]->price, 100 + i);
+    }
+}
+
+// 4. Slabs start on a cache line, with or without huge pages
+TEST(ObjectPoolTest, SlabsAreCacheLineAligned) {
+    LOB::ObjectPool<LOB::Order> pool(16);
+    LOB::ObjectPool<LOB::Order> hugePool(16, LOB::PoolOptions{false, true});
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(pool.allocate(1, 100, 10, LOB::Side::Buy)) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(hugePool.allocate(1, 100, 10, LOB::Side::Buy)) % 64, 0u);
+}
+
+// 5. mlock is best effort: a locked or refused slab behaves the same
+TEST(ObjectPoolTest, LockedSlabsStayUsable) {
+    LOB::ObjectPool<LOB::Order> pool(8, LOB::PoolOptions{true, false, true});
+    std::vector<LOB::Order*> orders;
+
+    for(uint64_t i = 0; i < 20; ++i){
+        orders.push_back(pool.allocate(i, 100, 10, LOB::Side::Sell));
+        ASSERT_NE(orders.back(), nullptr);
+    }
+    EXPECT_EQ(pool.getSlabCount(), 3u);
+    EXPECT_LE(pool.getLockedSlabCount(), pool.getSlabCount());
+    for(LOB::Order* order : orders) pool.deallocate(order);
+    EXPECT_EQ(pool.getFreeCount(), pool.getCapacity());
+
+    LOB::ObjectPool<LOB::Order> unlocked(8);
+    EXPECT_EQ(unlocked.getLockedSlabCount(), 0u);
+}
@@ -6,8 +6,21 @@
  * 1. Order Submission (Smoke Test)
  * 2. Trade Execution (Matching Logic)
  * 3. Order Cancellation
+ * 4. Reject Events (Duplicate IDs, Unknown Cancels)
+ * 5. Batch APIs (identical event sequence to one-by-one submission)
+ * 6. Order Amendment (queue-priority rules, no pool traffic)
+ * 7. Market / IOC / FOK orders (never rest, FOK all-or-nothing)
+ * 8. Policy combinations (same events for every ladder / index / lock)
+ * 9. Multi-level sweeps (price-time priority, one BookUpdate per level), printed at the resting price
+ * 10. Stop / stop-limit orders (released by the last trade price, cascades, cancels, IDs reserved while parked)
+ * 11. Iceberg orders (slices replenished at the back of the level, hidden quantity on cancel / amend)
+ *
+ * Assertions are made on the structured event stream (QueueSink), not on console output.
  */
 #include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
 #include "../include/LOB/OrderBook.h"
 
 /**
@@ -20,6 +33,27 @@
 class OrderBookTest : public ::testing::Test {
 protected:
     LOB::OrderBook book;
+
+    /**
+     * @brief Pops every pending event from the book's QueueSink.
+     */
+    std::vector<LOB::ExecutionEvent> drainEvents() {
+        std::vector<LOB::ExecutionEvent> events;
+        LOB::ExecutionEvent event;
+        while(book.getSink().events().pop(event)) events.push_back(event);
+        return events;
+    }
+
+    /**
+     * @brief Keeps only the events of one type.
+     */
+    std::vector<LOB::ExecutionEvent> drainEvents(LOB::EventType type) {
+        std::vector<LOB::ExecutionEvent> filtered;
+        for(const auto& event : drainEvents()){
+            if(event.type == type) filtered.push_back(event);
+        }
+        return filtered;
+    }
 };
 
 // 1. Basic Add Verification
@@ -35,15 +69,16 @@ TEST_F(OrderBookTest, ExecutesTrade) {
     book.addOrder(1, 100, 10, LOB::Side::Buy);
     
     // Action: Add a matching Sell order (Aggressive)
-    // We capture stdout because the engine prints "TRADE EXECUTE" to console.
-    testing::internal::CaptureStdout();
-    
     book.addOrder(2, 100, 10, LOB::Side::Sell);
     
-    std::string output = testing::internal::GetCapturedStdout();
-    
-    // Assertion: Verify the trade log appeared
-    EXPECT_TRUE(output.find("TRADE EXECUTE") != std::string::npos);
+    // Assertion: Exactly one Trade event with both sides and the full quantity
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].trade.buyOrderId, 1u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 2u);
+    EXPECT_EQ(trades[0].trade.price, 100u);
+    EXPECT_EQ(trades[0].trade.quantity, 10u);
+    EXPECT_EQ(book.getOrderCount(), 0u);
 }
 
 // 3. Cancel Verification
@@ -52,11 +87,497 @@ TEST_F(OrderBookTest, CancelsOrder) {
     book.addOrder(1, 100, 10, LOB::Side::Buy);
     
     // Action: Cancel it
-    testing::internal::CaptureStdout();
     book.cancelOrder(1);
-    std::string output = testing::internal::GetCapturedStdout();
     
-    // Assertion: Verify the cancellation log
-    // Note: Matches the "Cancelled" string from OrderBook.cpp
-    EXPECT_TRUE(output.find("Cancelled") != std::string::npos);
-}
\ No newline at end of file
+    // Assertion: Verify the Cancel event and that the level was reported as gone
+    auto events = drainEvents();
+    ASSERT_GE(events.size(), 2u);
+    const auto& cancel = events[events.size() - 2];
+    ASSERT_EQ(cancel.type, LOB::EventType::Cancel);
+    EXPECT_EQ(cancel.cancel.orderId, 1u);
+    EXPECT_EQ(cancel.cancel.remainingQuantity, 10u);
+
+    const auto& update = events.back();
+    ASSERT_EQ(update.type, LOB::EventType::BookUpdate);
+    EXPECT_EQ(update.update.price, 100u);
+    EXPECT_EQ(update.update.volume, 0u);
+    EXPECT_EQ(book.getBestBid(), nullptr);
+}
+
+// 4. Reject Verification
+TEST_F(OrderBookTest, RejectsDuplicatesAndUnknownCancels) {
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(1, 101, 10, LOB::Side::Buy);
+    book.cancelOrder(42);
+
+    auto rejects = drainEvents(LOB::EventType::Reject);
+    ASSERT_EQ(rejects.size(), 2u);
+    EXPECT_EQ(rejects[0].reject.orderId, 1u);
+    EXPECT_EQ(rejects[0].reject.reason, LOB::RejectReason::DuplicateOrderId);
+    EXPECT_EQ(rejects[1].reject.orderId, 42u);
+    EXPECT_EQ(rejects[1].reject.reason, LOB::RejectReason::UnknownOrder);
+}
+
+// 5. Partial Fill Verification: level volume follows the fills
+TEST_F(OrderBookTest, PartialFillUpdatesLevelVolume) {
+    book.addOrder(1, 100, 30, LOB::Side::Sell);
+    book.addOrder(2, 100, 10, LOB::Side::Buy);
+
+    auto updates = drainEvents(LOB::EventType::BookUpdate);
+    ASSERT_FALSE(updates.empty());
+    EXPECT_EQ(updates.back().update.side, LOB::Side::Sell);
+    EXPECT_EQ(updates.back().update.volume, 20u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 20u);
+}
+/**
+ * @brief Flattens an event into comparable fields.
+ */
+static std::vector<uint64_t> eventFields(const LOB::ExecutionEvent& e) {
+    switch(e.type){
+        case LOB::EventType::Trade:      return {0, e.trade.buyOrderId, e.trade.sellOrderId, e.trade.price, e.trade.quantity};
+        case LOB::EventType::Cancel:     return {1, e.cancel.orderId, e.cancel.remainingQuantity};
+        case LOB::EventType::Reject:     return {2, e.reject.orderId, static_cast<uint64_t>(e.reject.reason)};
+        case LOB::EventType::BookUpdate: return {3, e.update.price, e.update.volume, static_cast<uint64_t>(e.update.side)};
+        case LOB::EventType::Modify:     return {4, e.modify.orderId, e.modify.price, e.modify.quantity};
+        case LOB::EventType::BookSnapshot: return {5, e.snapshot.depth};
+    }
+    return {};
+}
+
+template <typename Book>
+static std::vector<std::vector<uint64_t>> drainFields(Book& book) {
+    std::vector<std::vector<uint64_t>> out;
+    LOB::ExecutionEvent event;
+    while(book.getSink().events().pop(event)) out.push_back(eventFields(event));
+    return out;
+}
+
+// 6. Batch Verification: applyBatch == sequential calls, event for event
+TEST(OrderBookBatchTest, MatchesSequentialSubmission) {
+    std::mt19937 gen(2024);
+    std::vector<LOB::OrderRequest> requests;
+    for(LOB::OrderId id = 1; id <= 3000; ++id){
+        LOB::Side side = (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell;
+        LOB::Price price = 95 + gen() % 11;
+        LOB::RequestType type = LOB::RequestType::Add;
+        LOB::OrderId target = id;
+        if(id > 10 && gen() % 4 == 0){
+            type = (gen() % 2) ? LOB::RequestType::Cancel : LOB::RequestType::Modify;
+            target = id - 1 - gen() % 10;
+        }
+        requests.push_back({target, price, 1 + gen() % 50, side, type});
+    }
+
+    LOB::OrderBook sequential, batched;
+    for(const auto& r : requests){
+        switch(r.type){
+            case LOB::RequestType::Add:    sequential.addOrder(r.id, r.price, r.qty, r.side); break;
+            case LOB::RequestType::Cancel: sequential.cancelOrder(r.id); break;
+            case LOB::RequestType::Modify: sequential.applyBatch(std::span(&r, 1)); break;
+        }
+    }
+    batched.applyBatch(requests);
+
+    EXPECT_EQ(drainFields(sequential), drainFields(batched));
+    EXPECT_EQ(sequential.getOrderCount(), batched.getOrderCount());
+}
+
+// 7. addOrders: a burst of passive orders followed by one sweeping order
+TEST(OrderBookBatchTest, AddOrdersMatchesWhenCrossing) {
+    LOB::OrderBook book;
+    std::vector<LOB::OrderRequest> burst;
+    for(LOB::OrderId id = 1; id <= 5; ++id){
+        burst.push_back({id, 100 + id, 10, LOB::Side::Sell, LOB::RequestType::Add});
+    }
+    burst.push_back({6, 103, 25, LOB::Side::Buy, LOB::RequestType::Add});
+    book.addOrders(burst);
+
+    uint64_t traded = 0;
+    LOB::ExecutionEvent event;
+    while(book.getSink().events().pop(event)){
+        if(event.type == LOB::EventType::Trade) traded += event.trade.quantity;
+    }
+    EXPECT_EQ(traded, 25u);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 103u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 5u);
+}
+
+// 8. Modify down at the same price: in place, level volume follows, queue position kept
+TEST_F(OrderBookTest, ModifyReduceKeepsPriority) {
+    book.addOrder(1, 100, 30, LOB::Side::Sell);
+    book.addOrder(2, 100, 10, LOB::Side::Sell);
+    size_t freeSlots = book.getOrderPool().getFreeCount();
+
+    book.modifyOrder(1, 100, 5);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 15u);
+    EXPECT_EQ(book.getBestAsk()->getHead()->id, 1u);
+    EXPECT_EQ(book.getOrderPool().getFreeCount(), freeSlots);
+
+    auto modifies = drainEvents(LOB::EventType::Modify);
+    ASSERT_EQ(modifies.size(), 1u);
+    EXPECT_EQ(modifies[0].modify.orderId, 1u);
+    EXPECT_EQ(modifies[0].modify.quantity, 5u);
+
+    // The reduced order still trades first
+    book.addOrder(3, 100, 5, LOB::Side::Buy);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 1u);
+}
+
+// 9. Modify up, or to a new price: the order goes to the back of its (new) level
+TEST_F(OrderBookTest, ModifyIncreaseOrRepriceLosesPriority) {
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(2, 100, 10, LOB::Side::Buy);
+    book.addOrder(3, 99, 10, LOB::Side::Buy);
+
+    book.modifyOrder(1, 100, 20);
+    EXPECT_EQ(book.getBestBid()->getHead()->id, 2u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 30u);
+
+    book.modifyOrder(2, 99, 10);
+    EXPECT_EQ(book.getBestBid()->getHead()->id, 1u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 20u);
+
+    book.modifyOrder(1, 98, 20); // the 100 level empties and is dropped
+    EXPECT_EQ(book.getBestBid()->getPrice(), 99u);
+    EXPECT_EQ(book.getBestBid()->getHead()->id, 3u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 20u);
+    EXPECT_EQ(book.getOrderCount(), 3u);
+}
+
+// 10. A reprice across the spread trades; unknown IDs are rejected; quantity 0 cancels
+TEST_F(OrderBookTest, ModifyCrossesRejectsAndCancels) {
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(2, 105, 4, LOB::Side::Sell);
+    drainEvents();
+
+    book.modifyOrder(1, 105, 10);
+    auto events = drainEvents();
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.front().type, LOB::EventType::Modify);
+    auto oldLevel = std::find_if(events.begin(), events.end(), [](const auto& e){
+        return e.type == LOB::EventType::BookUpdate && e.update.price == 100u;
+    });
+    ASSERT_NE(oldLevel, events.end());
+    EXPECT_EQ(oldLevel->update.volume, 0u); // old level gone
+    auto trade = std::find_if(events.begin(), events.end(), [](const auto& e){ return e.type == LOB::EventType::Trade; });
+    ASSERT_NE(trade, events.end());
+    EXPECT_EQ(trade->trade.quantity, 4u);
+    EXPECT_EQ(book.getBestBid()->getPrice(), 105u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 6u);
+
+    book.modifyOrder(42, 100, 1);
+    auto rejects = drainEvents(LOB::EventType::Reject);
+    ASSERT_EQ(rejects.size(), 1u);
+    EXPECT_EQ(rejects[0].reject.reason, LOB::RejectReason::UnknownOrder);
+
+    book.modifyOrder(1, 105, 0);
+    EXPECT_EQ(drainEvents(LOB::EventType::Cancel).size(), 1u);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+}
+
+// 11. Market and IOC orders trade what they can and discard the rest; nothing rests, no pool slot is used
+TEST_F(OrderBookTest, MarketAndIocNeverRest) {
+    book.addOrder(1, 100, 5, LOB::Side::Sell);
+    book.addOrder(2, 101, 5, LOB::Side::Sell);
+    book.addOrder(3, 103, 5, LOB::Side::Sell);
+    drainEvents();
+    size_t freeSlots = book.getOrderPool().getFreeCount();
+
+    book.addOrder(10, 0, 12, LOB::Side::Buy, LOB::OrderType::Market);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 3u);
+    EXPECT_EQ(trades[0].trade.buyOrderId, 10u);
+    EXPECT_EQ(trades[0].trade.price, 100u);
+    EXPECT_EQ(trades[2].trade.price, 103u);
+    EXPECT_EQ(trades[2].trade.quantity, 2u);
+    EXPECT_EQ(book.getOrderPool().getFreeCount(), freeSlots + 2); // only the two filled asks came back
+    EXPECT_EQ(book.getBestBid(), nullptr);
+
+    book.addOrder(11, 102, 10, LOB::Side::Buy, LOB::OrderType::ImmediateOrCancel);
+    EXPECT_TRUE(drainEvents(LOB::EventType::Trade).empty());
+    EXPECT_EQ(book.getBestBid(), nullptr);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 3u);
+    EXPECT_EQ(book.getOrderCount(), 1u);
+}
+
+// 12. FOK: killed without side effects unless the reachable volume covers it, also through applyBatch()
+TEST_F(OrderBookTest, FillOrKillIsAllOrNothing) {
+    book.addOrder(1, 100, 5, LOB::Side::Buy);
+    book.addOrder(2, 99, 5, LOB::Side::Buy);
+    book.addOrder(3, 95, 50, LOB::Side::Buy);
+    drainEvents();
+
+    book.addOrder(10, 99, 11, LOB::Side::Sell, LOB::OrderType::FillOrKill);
+    auto events = drainEvents();
+    ASSERT_EQ(events.size(), 1u);
+    ASSERT_EQ(events[0].type, LOB::EventType::Cancel);
+    EXPECT_EQ(events[0].cancel.orderId, 10u);
+    EXPECT_EQ(events[0].cancel.remainingQuantity, 11u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 5u);
+
+    LOB::OrderRequest fok{11, 99, 8, LOB::Side::Sell, LOB::RequestType::Add, LOB::OrderType::FillOrKill};
+    book.applyBatch(std::span(&fok, 1));
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 11u);
+    EXPECT_EQ(trades[0].trade.price, 100u);
+    EXPECT_EQ(trades[1].trade.price, 99u);
+    EXPECT_EQ(trades[1].trade.quantity, 3u);
+    EXPECT_EQ(book.getBestBid()->getPrice(), 99u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 2u);
+    EXPECT_EQ(book.getBestAsk(), nullptr);
+}
+
+// 13. Policies: every ladder / index / lock combination produces the same event stream as the default book
+template <typename Book>
+static std::vector<std::vector<uint64_t>> runPolicyFlow() {
+    std::mt19937 gen(77);
+    std::vector<LOB::OrderRequest> requests;
+    for(LOB::OrderId id = 1; id <= 2000; ++id){
+        LOB::Side side = (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell;
+        LOB::OrderRequest r{id, 95 + gen() % 11, 1 + gen() % 50, side, LOB::RequestType::Add};
+        if(id > 10 && gen() % 4 == 0){
+            r.type = (gen() % 2) ? LOB::RequestType::Cancel : LOB::RequestType::Modify;
+            r.id = id - 1 - gen() % 10;
+        }
+        if(gen() % 8 == 0) r.orderType = LOB::OrderType::ImmediateOrCancel;
+        requests.push_back(r);
+    }
+
+    Book book;
+    std::span<const LOB::OrderRequest> all(requests);
+    book.applyBatch(all.first(1000));
+    for(const auto& r : all.subspan(1000)){
+        switch(r.type){
+            case LOB::RequestType::Add:    book.addOrder(r.id, r.price, r.qty, r.side, r.orderType); break;
+            case LOB::RequestType::Cancel: book.cancelOrder(r.id); break;
+            case LOB::RequestType::Modify: book.modifyOrder(r.id, r.price, r.qty); break;
+        }
+    }
+    auto events = drainFields(book);
+    events.push_back({book.getOrderCount(), book.getQuote().bidVolume, book.getQuote().askVolume});
+    return events;
+}
+
+TEST(OrderBookPolicyTest, CombinationsAreEquivalent) {
+    using namespace LOB;
+    const auto expected = runPolicyFlow<OrderBook>();
+    EXPECT_EQ((runPolicyFlow<BasicOrderBook<MapPriceLadder, UnorderedOrderIndex>>()), expected);
+    EXPECT_EQ((runPolicyFlow<BasicOrderBook<MapPriceLadder, OrderIndex, QueueSink, SpinLock>>()), expected);
+    EXPECT_EQ((runPolicyFlow<BasicOrderBook<FlatPriceLadder, OrderIndex, QueueSink, NoLock>>()), expected);
+    EXPECT_EQ((runPolicyFlow<BasicOrderBook<FlatPriceLadder, UnorderedOrderIndex, QueueSink, SpinLock>>()), expected);
+}
+
+// 14. Sweep kernel: a Limit buy consumes many resting orders across levels in price-time priority, the rest posts
+TEST_F(OrderBookTest, SweepConsumesLevelsInPriorityOrder) {
+    LOB::OrderId id = 1;
+    for(LOB::Price price = 100; price < 104; ++price){
+        for(int i = 0; i < 5; ++i) book.addOrder(id++, price, 2, LOB::Side::Sell);
+    }
+    drainEvents();
+    const size_t freeBefore = book.getOrderPool().getFreeCount();
+
+    book.addOrder(100, 102, 31, LOB::Side::Buy);
+    auto events = drainEvents();
+
+    std::vector<LOB::Trade> trades;
+    for(const auto& e : events) if(e.type == LOB::EventType::Trade) trades.push_back(e.trade);
+    ASSERT_EQ(trades.size(), 15u);
+    for(size_t i = 0; i < trades.size(); ++i){
+        EXPECT_EQ(trades[i].buyOrderId, 100u);
+        EXPECT_EQ(trades[i].sellOrderId, i + 1);
+        EXPECT_EQ(trades[i].price, 100 + i / 5);
+        EXPECT_EQ(trades[i].quantity, 2u);
+    }
+
+    // One delta per level: the remainder posted at 102, then the three emptied ask levels
+    std::vector<LOB::BookUpdate> updates;
+    for(const auto& e : events) if(e.type == LOB::EventType::BookUpdate) updates.push_back(e.update);
+    ASSERT_EQ(updates.size(), 4u);
+    EXPECT_EQ(updates[0].side, LOB::Side::Buy);
+    EXPECT_EQ(updates[0].price, 102u);
+    EXPECT_EQ(updates[0].volume, 1u);
+    for(size_t i = 1; i < 4; ++i){
+        EXPECT_EQ(updates[i].side, LOB::Side::Sell);
+        EXPECT_EQ(updates[i].price, 99 + i);
+        EXPECT_EQ(updates[i].volume, 0u);
+    }
+
+    // 15 resting orders released, one new order resting
+    EXPECT_EQ(book.getOrderPool().getFreeCount(), freeBefore + 14);
+    EXPECT_EQ(book.getOrderCount(), 6u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 1u);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 103u);
+    EXPECT_EQ(book.findOrder(15), nullptr);
+}
+
+// 15. Stops: parked until a trade reaches them, released nearest first, cascading through their own trades
+TEST_F(OrderBookTest, StopOrdersTriggerOnLastTrade) {
+    book.addOrder(1, 100, 5, LOB::Side::Buy);
+    book.addOrder(2, 99, 5, LOB::Side::Buy);
+    book.addOrder(3, 98, 5, LOB::Side::Buy);
+    drainEvents();
+    book.addStopOrder(10, 100, 0, 5, LOB::Side::Sell);
+    book.addStopOrder(11, 99, 0, 5, LOB::Side::Sell);   // only reached by the trades of stop 10
+    book.addStopOrder(12, 90, 0, 5, LOB::Side::Sell);
+    book.addStopOrder(3, 90, 0, 5, LOB::Side::Sell);    // duplicate of a resting ID
+    auto events = drainEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, LOB::EventType::Reject);
+    EXPECT_EQ(book.getStopOrderCount(), 3u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 5u);
+
+    book.addOrder(20, 100, 1, LOB::Side::Sell);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    const LOB::OrderId sellers[] = {20, 10, 10, 11, 11};
+    const LOB::Price prices[] = {100, 100, 99, 99, 98};
+    const LOB::Quantity quantities[] = {1, 4, 1, 4, 1};
+    ASSERT_EQ(trades.size(), 5u);
+    for(size_t i = 0; i < trades.size(); ++i){
+        EXPECT_EQ(trades[i].trade.sellOrderId, sellers[i]);
+        EXPECT_EQ(trades[i].trade.price, prices[i]);
+        EXPECT_EQ(trades[i].trade.quantity, quantities[i]);
+    }
+    EXPECT_EQ(book.getStopOrderCount(), 1u);
+    EXPECT_EQ(book.getLastTradePrice(), 98u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 4u);
+
+    // A parked stop cancels like an order; one already reached executes on arrival
+    book.cancelOrder(12);
+    book.cancelOrder(12);
+    events = drainEvents();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type, LOB::EventType::Cancel);
+    EXPECT_EQ(events[0].cancel.remainingQuantity, 5u);
+    EXPECT_EQ(events[1].type, LOB::EventType::Reject);
+    EXPECT_EQ(book.getStopOrderCount(), 0u);
+
+    book.addStopOrder(13, 99, 0, 2, LOB::Side::Sell);
+    trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 13u);
+    EXPECT_EQ(book.getStopOrderCount(), 0u);
+}
+
+// 16. Stop-limit: released as a limit order, the unfilled part rests
+TEST_F(OrderBookTest, StopLimitRestsRemainder) {
+    book.addOrder(1, 101, 5, LOB::Side::Sell);
+    book.addOrder(2, 103, 5, LOB::Side::Sell);
+    book.addStopOrder(10, 101, 101, 8, LOB::Side::Buy, LOB::OrderType::Limit);
+    EXPECT_EQ(book.findOrder(10), nullptr);
+
+    book.addOrder(20, 101, 1, LOB::Side::Buy);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades[1].trade.buyOrderId, 10u);
+    EXPECT_EQ(trades[1].trade.quantity, 4u);
+    ASSERT_NE(book.findOrder(10), nullptr);
+    EXPECT_EQ(book.findOrder(10)->quantity, 4u);
+    EXPECT_EQ(book.getBestBid()->getPrice(), 101u);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 103u);
+}
+
+// 17. Icebergs: one slot shows slice after slice at the back of its level; hidden quantity is cancelled / amended with it
+TEST_F(OrderBookTest, IcebergReplenishesInPlace) {
+    book.addIcebergOrder(1, 100, 10, 3, LOB::Side::Sell);
+    book.addOrder(2, 100, 4, LOB::Side::Sell);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 7u);
+    EXPECT_EQ(book.getHiddenQuantity(1), 7u);
+    drainEvents();
+    const size_t freeSlots = book.getOrderPool().getFreeCount();
+
+    // The first slice fills, the next one queues behind order 2
+    book.addOrder(10, 100, 5, LOB::Side::Buy);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 1u);
+    EXPECT_EQ(trades[0].trade.quantity, 3u);
+    EXPECT_EQ(trades[1].trade.sellOrderId, 2u);
+    EXPECT_EQ(trades[1].trade.quantity, 2u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 5u);
+    EXPECT_EQ(book.getBestAsk()->getOrderCount(), 2u);
+    EXPECT_EQ(book.getHiddenQuantity(1), 4u);
+    EXPECT_EQ(book.getOrderPool().getFreeCount(), freeSlots);
+
+    // Sweep through every remaining slice
+    book.addOrder(11, 100, 20, LOB::Side::Buy);
+    trades = drainEvents(LOB::EventType::Trade);
+    const LOB::OrderId makers[] = {2, 1, 1, 1};
+    const LOB::Quantity quantities[] = {2, 3, 3, 1};
+    ASSERT_EQ(trades.size(), 4u);
+    for(size_t i = 0; i < trades.size(); ++i){
+        EXPECT_EQ(trades[i].trade.sellOrderId, makers[i]);
+        EXPECT_EQ(trades[i].trade.quantity, quantities[i]);
+    }
+    EXPECT_EQ(book.getBestAsk(), nullptr);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 11u);
+    EXPECT_EQ(book.getHiddenQuantity(1), 0u);
+
+    // An incoming iceberg trades its whole size first; what is left is smaller than a slice
+    book.addIcebergOrder(31, 100, 15, 5, LOB::Side::Sell);
+    EXPECT_EQ(drainEvents(LOB::EventType::Trade).size(), 1u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 4u);
+    EXPECT_EQ(book.getHiddenQuantity(31), 0u);
+
+    // Market orders replenish slices too (immediate sweep path)
+    book.addIcebergOrder(32, 101, 12, 2, LOB::Side::Sell);
+    book.addOrder(40, 0, 8, LOB::Side::Buy, LOB::OrderType::Market);
+    trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 3u);
+    EXPECT_EQ(trades[2].trade.sellOrderId, 32u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 2u);
+    EXPECT_EQ(book.getHiddenQuantity(32), 6u);
+
+    // Amending resets the total; cancelling reports displayed + hidden
+    book.modifyOrder(32, 102, 5);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 102u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 2u);
+    EXPECT_EQ(book.getHiddenQuantity(32), 3u);
+    drainEvents();
+    book.cancelOrder(32);
+    auto cancels = drainEvents(LOB::EventType::Cancel);
+    ASSERT_EQ(cancels.size(), 1u);
+    EXPECT_EQ(cancels[0].cancel.remainingQuantity, 5u);
+    EXPECT_EQ(book.getBestAsk(), nullptr);
+}
+
+// 18. Price convention: a crossing Limit and an IOC hitting the same level both trade at the resting price
+TEST_F(OrderBookTest, TradesPrintAtRestingPrice) {
+    book.addOrder(1, 101, 5, LOB::Side::Buy);
+    book.addOrder(2, 101, 5, LOB::Side::Buy);
+    book.addOrder(10, 99, 3, LOB::Side::Sell);
+    book.addOrder(11, 99, 3, LOB::Side::Sell, LOB::OrderType::ImmediateOrCancel);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 3u);
+    for(const auto& t : trades) EXPECT_EQ(t.trade.price, 101u);
+    EXPECT_EQ(trades[0].trade.sellOrderId, 10u);
+    EXPECT_EQ(trades[1].trade.sellOrderId, 11u);
+    EXPECT_EQ(trades[2].trade.sellOrderId, 11u);
+}
+
+// 19. One ID space: a parked stop's ID is refused to limit, immediate and iceberg orders, and the stop still fires
+TEST_F(OrderBookTest, ParkedStopReservesItsId) {
+    book.addOrder(1, 100, 5, LOB::Side::Buy);
+    book.addStopOrder(7, 100, 0, 2, LOB::Side::Sell);
+    drainEvents();
+
+    book.addOrder(7, 105, 1, LOB::Side::Sell);
+    book.addOrder(7, 100, 1, LOB::Side::Sell, LOB::OrderType::ImmediateOrCancel);
+    book.addIcebergOrder(7, 105, 10, 2, LOB::Side::Sell);
+    LOB::OrderRequest batched{7, 106, 1, LOB::Side::Sell, LOB::RequestType::Add};
+    book.applyBatch(std::span(&batched, 1));
+    auto rejects = drainEvents(LOB::EventType::Reject);
+    ASSERT_EQ(rejects.size(), 4u);
+    for(const auto& r : rejects) EXPECT_EQ(r.reject.reason, LOB::RejectReason::DuplicateOrderId);
+    EXPECT_EQ(book.getOrderCount(), 1u);
+    EXPECT_EQ(book.getStopOrderCount(), 1u);
+
+    book.addOrder(8, 100, 1, LOB::Side::Sell);
+    auto trades = drainEvents(LOB::EventType::Trade);
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades[1].trade.sellOrderId, 7u);
+    EXPECT_EQ(trades[1].trade.quantity, 2u);
+    EXPECT_EQ(book.getStopOrderCount(), 0u);
+}
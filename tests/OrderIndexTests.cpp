@@ -0,0 +1,97 @@
+/**
+ * @file OrderIndexTests.cpp
+ * @brief Unit Tests for the open-addressing OrderIndex.
+ * @details
+ * Verified functionality:
+ * 1. Random insert/find/erase against a std::unordered_map reference (both modes)
+ * 2. Dense mode spill-over when an old order still owns a direct slot
+ * 3. Growth past the pre-sized capacity
+ * 4. Cancels through a Dense-indexed book
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <unordered_map>
+#include "../include/LOB/OrderIndex.h"
+#include "../include/LOB/OrderBook.h"
+
+class OrderIndexTest : public ::testing::TestWithParam<LOB::OrderIndexMode> {};
+
+// 1. Behaves exactly like a map under a random workload (exercises backward shift deletion)
+TEST_P(OrderIndexTest, MatchesReferenceMap) {
+    LOB::OrderIndex index(256, GetParam());
+    std::unordered_map<LOB::OrderId, LOB::Order*> reference;
+    std::vector<LOB::Order> orders(1024);
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<LOB::OrderId> idDist(0, 1023);
+
+    for(int i = 0; i < 20000; ++i){
+        LOB::OrderId id = idDist(gen);
+        if(gen() % 2){
+            bool inserted = index.insert(id, &orders[id]);
+            EXPECT_EQ(inserted, reference.emplace(id, &orders[id]).second);
+        }
+        else{
+            LOB::Order* removed = index.extract(id);
+            auto it = reference.find(id);
+            EXPECT_EQ(removed, it == reference.end() ? nullptr : it->second);
+            if(it != reference.end()) reference.erase(it);
+        }
+        ASSERT_EQ(index.size(), reference.size());
+    }
+
+    for(LOB::OrderId id = 0; id < 1024; ++id){
+        auto it = reference.find(id);
+        EXPECT_EQ(index.find(id), it == reference.end() ? nullptr : it->second);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, OrderIndexTest,
+                         ::testing::Values(LOB::OrderIndexMode::Hashed, LOB::OrderIndexMode::Dense));
+
+// 2. A new ID whose direct slot is taken by an old resting order still works
+TEST(OrderIndexDenseTest, SpillsOverOnWrapAround) {
+    LOB::OrderIndex index(16, LOB::OrderIndexMode::Dense);
+    LOB::Order oldOrder, newOrder;
+
+    ASSERT_TRUE(index.insert(3, &oldOrder));
+    ASSERT_TRUE(index.insert(3 + 16, &newOrder)); // same direct slot
+    EXPECT_FALSE(index.insert(3 + 16, &newOrder));
+
+    EXPECT_EQ(index.find(3), &oldOrder);
+    EXPECT_EQ(index.find(19), &newOrder);
+
+    // Once the old order leaves, the spilled ID must not be duplicated into the free direct slot
+    EXPECT_EQ(index.extract(3), &oldOrder);
+    EXPECT_FALSE(index.insert(19, &newOrder));
+    EXPECT_EQ(index.extract(19), &newOrder);
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// 3. An under-sized index grows instead of failing
+TEST(OrderIndexHashedTest, GrowsPastCapacity) {
+    LOB::OrderIndex index(4);
+    std::vector<LOB::Order> orders(1000);
+    for(LOB::OrderId id = 0; id < 1000; ++id){
+        ASSERT_TRUE(index.insert(id * 977, &orders[id]));
+    }
+    for(LOB::OrderId id = 0; id < 1000; ++id){
+        EXPECT_EQ(index.find(id * 977), &orders[id]);
+    }
+    EXPECT_LE(index.loadFactor(), 0.875);
+}
+
+// 4. The book works the same with the dense index
+TEST(OrderIndexDenseTest, BookCancelsThroughDenseIndex) {
+    LOB::BookConfig config;
+    config.orderIndexMode = LOB::OrderIndexMode::Dense;
+    config.orderIndexCapacity = 64;
+    LOB::OrderBook book(config);
+
+    for(LOB::OrderId id = 1; id <= 200; ++id){
+        book.addOrder(id, 100 + id % 5, 10, LOB::Side::Buy);
+        if(id > 10) book.cancelOrder(id - 10);
+    }
+    EXPECT_EQ(book.getOrderCount(), 10u);
+    EXPECT_EQ(book.getOrderIndex().getMode(), LOB::OrderIndexMode::Dense);
+}
@@ -0,0 +1,288 @@
+/**
+ * @file PersistenceTests.cpp
+ * @brief Unit Tests for the command journal, snapshots and warm restart.
+ * @details
+ * Verified functionality:
+ * 1. Journal round trip (sequences, fields) and continuation after reopening
+ * 2. A torn trailing record is dropped, even when it is the first one
+ * 3. Snapshots preserve queue (FIFO) order
+ * 4. Snapshot + journal tail rebuilds exactly the book that crashed
+ * 5. Write failures are reported (sticky flag, lost records) and never replace a good snapshot
+ * 6. Iceberg reserves, parked stops and the last trade price survive a snapshot and a journal replay
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "../include/LOB/Persistence.h"
+#include "../include/LOB/OrderBook.h"
+
+namespace {
+    std::string tempPath(const char* name){
+        std::string path = ::testing::TempDir() + name;
+        std::remove(path.c_str());
+        return path;
+    }
+
+    std::vector<std::vector<uint64_t>> restingOrders(const LOB::OrderBook& book){
+        std::vector<std::vector<uint64_t>> out;
+        book.forEachRestingOrder([&](const LOB::Order& o){
+            out.push_back({o.id, o.price, o.quantity, static_cast<uint64_t>(o.side), book.getHiddenQuantity(o.id)});
+        });
+        return out;
+    }
+
+    std::vector<std::vector<uint64_t>> parkedStops(const LOB::OrderBook& book){
+        std::vector<std::vector<uint64_t>> out;
+        book.forEachStopOrder([&](const LOB::StopOrder& s){
+            out.push_back({s.id, s.stopPrice, s.price, s.qty, static_cast<uint64_t>(s.side), static_cast<uint64_t>(s.type)});
+        });
+        return out;
+    }
+}
+
+// 1. Records come back in order with their sequence numbers; a reopened journal continues the numbering
+TEST(PersistenceTest, JournalRoundTrip) {
+    std::string path = tempPath("roundtrip.journal");
+    {
+        LOB::JournalWriter journal(16); // small queue: exercises the writer keeping up
+        ASSERT_TRUE(journal.open(path));
+        for(LOB::OrderId id = 1; id <= 100; ++id){
+            journal.append({id, 100 + id % 5, id, LOB::Side::Buy, LOB::RequestType::Add});
+        }
+        EXPECT_EQ(journal.getSequence(), 100u);
+    }
+    {
+        LOB::JournalWriter journal;
+        ASSERT_TRUE(journal.open(path));
+        EXPECT_EQ(journal.getSequence(), 100u);
+        EXPECT_EQ(journal.append({7, 0, 0, LOB::Side::Buy, LOB::RequestType::Cancel}), 101u);
+        journal.close();
+        EXPECT_EQ(journal.getWrittenCount(), 1u);
+    }
+
+    LOB::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    auto records = LOB::journalRecords(file);
+    ASSERT_EQ(records.size(), 101u);
+    EXPECT_EQ(records[41].sequence, 42u);
+    EXPECT_EQ(records[41].id, 42u);
+    EXPECT_EQ(records[41].qty, 42u);
+    EXPECT_EQ(records.back().type, LOB::RequestType::Cancel);
+}
+
+// 2. Half a record at the end (crash mid-write) is ignored and cut off on reopen
+TEST(PersistenceTest, TornTailIsDropped) {
+    std::string path = tempPath("torn.journal");
+    {
+        LOB::JournalWriter journal;
+        ASSERT_TRUE(journal.open(path));
+        journal.append({1, 100, 10, LOB::Side::Buy, LOB::RequestType::Add});
+        journal.append({2, 101, 10, LOB::Side::Sell, LOB::RequestType::Add});
+    }
+    auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 7);
+
+    LOB::JournalWriter journal;
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_EQ(journal.getSequence(), 1u);
+    journal.append({3, 102, 10, LOB::Side::Sell, LOB::RequestType::Add});
+    journal.close();
+
+    LOB::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    auto records = LOB::journalRecords(file);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].sequence, 2u);
+    EXPECT_EQ(records[1].id, 3u);
+
+    // Crash while writing the very first record: header + a partial record still reopens, from sequence 0
+    std::string early = tempPath("torn_first.journal");
+    {
+        LOB::JournalWriter first;
+        ASSERT_TRUE(first.open(early));
+        first.append({1, 100, 10, LOB::Side::Buy, LOB::RequestType::Add});
+    }
+    std::filesystem::resize_file(early, sizeof(LOB::JournalFileHeader) + 9);
+
+    LOB::JournalWriter reopened;
+    ASSERT_TRUE(reopened.open(early));
+    EXPECT_EQ(reopened.getSequence(), 0u);
+    EXPECT_EQ(reopened.append({2, 101, 10, LOB::Side::Sell, LOB::RequestType::Add}), 1u);
+    reopened.close();
+    EXPECT_EQ(std::filesystem::file_size(early), sizeof(LOB::JournalFileHeader) + sizeof(LOB::JournalRecord));
+
+    // A file that is not a journal is still refused
+    std::filesystem::resize_file(early, 0);
+    std::filesystem::resize_file(early, 40);
+    EXPECT_FALSE(reopened.open(early));
+}
+
+// 3. Orders queued at one price come back in the same priority order
+TEST(PersistenceTest, SnapshotKeepsQueueOrder) {
+    LOB::OrderBook book;
+    book.addOrder(3, 100, 10, LOB::Side::Buy);
+    book.addOrder(1, 100, 20, LOB::Side::Buy);
+    book.addOrder(2, 100, 30, LOB::Side::Buy);
+    book.addOrder(9, 105, 5, LOB::Side::Sell);
+
+    std::string path = tempPath("fifo.snap");
+    ASSERT_TRUE(LOB::writeSnapshot(path, LOB::captureSnapshot(book, 4)));
+
+    LOB::OrderBook restored;
+    LOB::RecoveryStats stats = LOB::recover(restored, path, tempPath("none.journal"));
+    EXPECT_TRUE(stats.snapshotLoaded);
+    EXPECT_EQ(stats.snapshotSequence, 4u);
+    EXPECT_EQ(stats.restoredOrders, 4u);
+    EXPECT_EQ(stats.maxOrderId, 9u);
+    EXPECT_EQ(restingOrders(restored), restingOrders(book));
+    EXPECT_EQ(restored.getBestBid()->getHead()->id, 3u);
+}
+
+// 4. Crash after a snapshot: snapshot + journal tail == the book that was running
+TEST(PersistenceTest, WarmRestartMatchesLiveBook) {
+    std::string journalPath = tempPath("restart.journal");
+    std::string snapshotPath = tempPath("restart.snap");
+    std::mt19937 gen(21);
+
+    LOB::OrderBook live;
+    {
+        LOB::JournalWriter journal;
+        ASSERT_TRUE(journal.open(journalPath));
+        for(LOB::OrderId id = 1; id <= 4000; ++id){
+            LOB::OrderRequest r{id, 95 + gen() % 11, 1 + gen() % 40, (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add};
+            switch(gen() % 6){
+                case 0: r.type = LOB::RequestType::Cancel; r.id = id - 1 - gen() % 30; break;
+                case 1: r.type = LOB::RequestType::Modify; r.id = id - 1 - gen() % 30; break;
+                case 2: r.orderType = LOB::OrderType::ImmediateOrCancel; break;
+                default: break;
+            }
+            journal.append(r);
+            live.applyBatch(std::span(&r, 1));
+
+            if(id == 2500){
+                ASSERT_TRUE(LOB::writeSnapshot(snapshotPath, LOB::captureSnapshot(live, journal.getSequence())));
+            }
+        }
+    } // "crash": the journal is closed, the book is gone
+
+    LOB::OrderBook restored;
+    LOB::RecoveryStats stats = LOB::recover(restored, snapshotPath, journalPath);
+    EXPECT_TRUE(stats.snapshotLoaded);
+    EXPECT_EQ(stats.snapshotSequence, 2500u);
+    EXPECT_EQ(stats.replayedCommands, 1500u);
+    EXPECT_EQ(stats.lastSequence, 4000u);
+    EXPECT_EQ(restingOrders(restored), restingOrders(live));
+
+    // Without the snapshot the full journal gives the same book
+    LOB::OrderBook cold;
+    LOB::RecoveryStats full = LOB::recover(cold, tempPath("missing.snap"), journalPath);
+    EXPECT_FALSE(full.snapshotLoaded);
+    EXPECT_EQ(full.replayedCommands, 4000u);
+    EXPECT_EQ(restingOrders(cold), restingOrders(live));
+}
+
+// 5. A full device: the journal flags itself failed and counts what it lost; a failed snapshot keeps the old one
+TEST(PersistenceTest, WriteFailuresAreReported) {
+    if(!std::filesystem::exists("/dev/full")) GTEST_SKIP() << "needs /dev/full";
+
+    LOB::JournalWriter journal(16);
+    ASSERT_TRUE(journal.open("/dev/full"));
+    for(LOB::OrderId id = 1; id <= 100; ++id){
+        journal.append({id, 100, 1, LOB::Side::Buy, LOB::RequestType::Add});
+    }
+    journal.close();
+    EXPECT_TRUE(journal.hasFailed());
+    EXPECT_EQ(journal.getWrittenCount() + journal.getLostCount(), 100u);
+    EXPECT_GT(journal.getLostCount(), 0u);
+
+    LOB::OrderBook book;
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    std::string path = tempPath("kept.snap");
+    ASSERT_TRUE(LOB::writeSnapshot(path, LOB::captureSnapshot(book, 1)));
+    std::string missingDir = ::testing::TempDir() + "no_such_dir/kept.snap";
+    EXPECT_FALSE(LOB::writeSnapshot(missingDir, LOB::captureSnapshot(book, 2)));
+
+    LOB::OrderBook restored;
+    LOB::RecoveryStats stats = LOB::recover(restored, path, tempPath("none.journal"));
+    EXPECT_EQ(stats.snapshotSequence, 1u);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+}
+
+// 6. Stops and icebergs are journaled and snapshotted like plain orders: nothing is lost across a restart
+TEST(PersistenceTest, ConditionalOrdersSurviveRestart) {
+    std::string journalPath = tempPath("conditional.journal");
+    std::string snapshotPath = tempPath("conditional.snap");
+    std::mt19937 gen(5);
+
+    LOB::OrderBook live;
+    LOB::Price snapshotTrade = 0;
+    {
+        LOB::JournalWriter journal;
+        ASSERT_TRUE(journal.open(journalPath));
+        for(LOB::OrderId id = 1; id <= 3000; ++id){
+            LOB::Side side = (gen() % 2) ? LOB::Side::Buy : LOB::Side::Sell;
+            LOB::Price price = 95 + gen() % 11;
+            LOB::Quantity qty = 1 + gen() % 40;
+            switch(gen() % 8){
+                case 0: {
+                    LOB::Price trigger = 95 + gen() % 11;
+                    LOB::OrderType type = (gen() % 2) ? LOB::OrderType::Limit : LOB::OrderType::Market;
+                    journal.appendStop(id, trigger, price, qty, side, type);
+                    live.addStopOrder(id, trigger, price, qty, side, type);
+                    break;
+                }
+                case 1: {
+                    LOB::Quantity display = 1 + gen() % 8;
+                    journal.appendIceberg(id, price, qty + 20, display, side);
+                    live.addIcebergOrder(id, price, qty + 20, display, side);
+                    break;
+                }
+                default: {
+                    LOB::OrderRequest r{id, price, qty, side, LOB::RequestType::Add};
+                    if(gen() % 4 == 0){ r.type = LOB::RequestType::Cancel; r.id = id - 1 - gen() % 30; }
+                    journal.append(r);
+                    live.applyBatch(std::span(&r, 1));
+                    break;
+                }
+            }
+
+            if(id == 2000){
+                LOB::Snapshot snapshot = LOB::captureSnapshot(live, journal.getSequence());
+                ASSERT_GT(live.getStopOrderCount(), 0u);
+                ASSERT_EQ(snapshot.orders.size(), live.getOrderCount() + live.getStopOrderCount());
+                ASSERT_TRUE(LOB::writeSnapshot(snapshotPath, snapshot));
+                snapshotTrade = live.getLastTradePrice();
+            }
+        }
+    }
+    ASSERT_GT(live.getStopOrderCount(), 0u);
+
+    bool hidden = false;
+    for(const auto& order : restingOrders(live)) hidden = hidden || order[4] > 0;
+    ASSERT_TRUE(hidden);
+
+    LOB::OrderBook restored;
+    LOB::RecoveryStats stats = LOB::recover(restored, snapshotPath, journalPath);
+    EXPECT_TRUE(stats.snapshotLoaded);
+    EXPECT_EQ(stats.replayedCommands, 1000u);
+    EXPECT_EQ(restingOrders(restored), restingOrders(live));
+    EXPECT_EQ(parkedStops(restored), parkedStops(live));
+    EXPECT_EQ(restored.getLastTradePrice(), live.getLastTradePrice());
+
+    LOB::OrderBook cold;
+    LOB::recover(cold, tempPath("missing.snap"), journalPath);
+    EXPECT_EQ(restingOrders(cold), restingOrders(live));
+    EXPECT_EQ(parkedStops(cold), parkedStops(live));
+
+    // The snapshot alone restores the last trade, so a stop at that price still triggers on arrival
+    LOB::OrderBook snapshotOnly;
+    LOB::recover(snapshotOnly, snapshotPath, tempPath("none.journal"));
+    ASSERT_NE(snapshotTrade, 0u);
+    EXPECT_EQ(snapshotOnly.getLastTradePrice(), snapshotTrade);
+    const size_t parked = snapshotOnly.getStopOrderCount();
+    snapshotOnly.addStopOrder(9000, snapshotTrade, 0, 1, LOB::Side::Buy);
+    EXPECT_EQ(snapshotOnly.getStopOrderCount(), parked);
+}
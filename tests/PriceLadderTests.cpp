@@ -0,0 +1,353 @@
+/**
+ * @file PriceLadderTests.cpp
+ * @brief Unit Tests for the Price Ladder backends.
+ * @details
+ * Verified functionality:
+ * 1. Best price tracking on both sides (Map and Flat backends)
+ * 2. Best price recovery after the top level empties
+ * 3. Flat ladder recentering when the market drifts out of the window
+ * 4. Matching through a FlatOrderBook
+ * 5. Occupancy bitmap next/previous search (against a std::set reference)
+ * 6. Level recycling in the map backend
+ * 7. SIMD depth kernels (every instruction set the CPU has) against the scalar reference
+ * 8. Aggregated depth queries: the flat SoA scans agree with the map walk, through fills, cancels and recenters
+ * 9. The flat window never grows past maxLadderTicks: prices it cannot reach are rejected, a zero tick counts as 1
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include <set>
+#include <random>
+#include "../include/LOB/OrderBook.h"
+#include "../include/LOB/PriceLadder.h"
+#include "../include/LOB/OccupancyBitmap.h"
+#include "../include/LOB/DepthKernels.h"
+
+/**
+ * @class PriceLadderTest
+ * @brief Typed fixture: every test runs once per ladder backend.
+ */
+template <typename T>
+class PriceLadderTest : public ::testing::Test {};
+
+struct MapBackend {
+    using Bids = LOB::MapPriceLadder<LOB::Side::Buy>;
+    using Asks = LOB::MapPriceLadder<LOB::Side::Sell>;
+};
+
+struct FlatBackend {
+    using Bids = LOB::FlatPriceLadder<LOB::Side::Buy>;
+    using Asks = LOB::FlatPriceLadder<LOB::Side::Sell>;
+};
+
+using Backends = ::testing::Types<MapBackend, FlatBackend>;
+TYPED_TEST_SUITE(PriceLadderTest, Backends);
+
+// 1. Best price: highest for bids, lowest for asks
+TYPED_TEST(PriceLadderTest, TracksBestPrice) {
+    LOB::BookConfig config;
+    typename TypeParam::Bids bids(config);
+    typename TypeParam::Asks asks(config);
+    std::vector<LOB::Order> orders(6);
+
+    LOB::Price prices[] = {100, 103, 101};
+    for(int i = 0; i < 3; ++i){
+        orders[i] = LOB::Order(i, prices[i], 10, LOB::Side::Buy);
+        bids.getOrCreate(prices[i])->append(&orders[i]);
+        orders[i + 3] = LOB::Order(i + 3, prices[i], 10, LOB::Side::Sell);
+        asks.getOrCreate(prices[i])->append(&orders[i + 3]);
+    }
+
+    ASSERT_NE(bids.best(), nullptr);
+    EXPECT_EQ(bids.best()->getPrice(), 103u);
+    EXPECT_EQ(asks.best()->getPrice(), 100u);
+    EXPECT_NE(bids.find(101), nullptr);
+    EXPECT_EQ(bids.find(102), nullptr);
+}
+
+// 2. Emptying the top level promotes the next best price
+TYPED_TEST(PriceLadderTest, RecoversBestAfterErase) {
+    LOB::BookConfig config;
+    typename TypeParam::Bids bids(config);
+    LOB::Order a(1, 98, 10, LOB::Side::Buy);
+    LOB::Order b(2, 95, 10, LOB::Side::Buy);
+
+    bids.getOrCreate(98)->append(&a);
+    bids.getOrCreate(95)->append(&b);
+
+    LOB::LimitLevel* top = bids.best();
+    top->remove(&a);
+    bids.erase(top);
+    EXPECT_EQ(bids.best()->getPrice(), 95u);
+
+    LOB::LimitLevel* last = bids.best();
+    last->remove(&b);
+    bids.erase(last);
+    EXPECT_TRUE(bids.empty());
+    EXPECT_EQ(bids.best(), nullptr);
+}
+
+// 3. Levels are visited best to worst
+TYPED_TEST(PriceLadderTest, IteratesBestToWorst) {
+    LOB::BookConfig config;
+    typename TypeParam::Asks asks(config);
+    std::vector<LOB::Order> orders(3);
+    LOB::Price prices[] = {105, 101, 103};
+    for(int i = 0; i < 3; ++i){
+        orders[i] = LOB::Order(i, prices[i], 10, LOB::Side::Sell);
+        asks.getOrCreate(prices[i])->append(&orders[i]);
+    }
+
+    std::vector<LOB::Price> seen;
+    asks.forEachLevel([&](const LOB::LimitLevel& level){ seen.push_back(level.getPrice()); });
+    EXPECT_EQ(seen, (std::vector<LOB::Price>{101, 103, 105}));
+
+    seen.clear();
+    asks.forEachLevelReverse([&](const LOB::LimitLevel& level){ seen.push_back(level.getPrice()); });
+    EXPECT_EQ(seen, (std::vector<LOB::Price>{105, 103, 101}));
+}
+
+// 4. Recentering keeps every resting order reachable
+TEST(FlatPriceLadderTest, RecentersOnDrift) {
+    LOB::BookConfig config;
+    config.tickSize = 5;
+    config.ladderTicks = 8;
+    LOB::FlatPriceLadder<LOB::Side::Sell> asks(config);
+    LOB::Order a(1, 1000, 10, LOB::Side::Sell);
+    LOB::Order b(2, 1200, 20, LOB::Side::Sell);
+
+    asks.getOrCreate(1000)->append(&a);
+    ASSERT_LE(asks.getBasePrice(), 1000u);
+
+    // 1200 is 40 ticks away: the window must move AND grow.
+    asks.getOrCreate(1200)->append(&b);
+    EXPECT_GE(asks.getTickCount(), 41u);
+
+    ASSERT_NE(asks.find(1000), nullptr);
+    ASSERT_NE(asks.find(1200), nullptr);
+    EXPECT_EQ(asks.find(1000)->getHead(), &a);
+    EXPECT_EQ(asks.find(1200)->getVolume(), 20u);
+    EXPECT_EQ(asks.best()->getPrice(), 1000u);
+    EXPECT_FALSE(asks.isValidPrice(1003));
+}
+
+// 5. End-to-end: the flat backend matches exactly like the map backend
+TEST(FlatOrderBookTest, MatchesAcrossLevels) {
+    LOB::FlatOrderBook book;
+
+    book.addOrder(1, 100, 10, LOB::Side::Sell);
+    book.addOrder(2, 101, 10, LOB::Side::Sell);
+    book.addOrder(3, 99, 10, LOB::Side::Buy);
+
+    book.addOrder(4, 101, 15, LOB::Side::Buy);
+
+    std::vector<LOB::Trade> trades;
+    LOB::ExecutionEvent event;
+    while(book.getSink().events().pop(event)){
+        if(event.type == LOB::EventType::Trade) trades.push_back(event.trade);
+    }
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades[0].sellOrderId, 1u);
+    EXPECT_EQ(trades[1].sellOrderId, 2u);
+    EXPECT_EQ(trades[1].quantity, 5u);
+    ASSERT_NE(book.getBestAsk(), nullptr);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 101u);
+    EXPECT_EQ(book.getBestAsk()->getVolume(), 5u);
+    EXPECT_EQ(book.getBestBid()->getPrice(), 99u);
+    EXPECT_EQ(book.getOrderCount(), 2u);
+}
+
+// 6. Bitmap search agrees with an ordered set across all three layers
+TEST(OccupancyBitmapTest, MatchesReferenceSet) {
+    const size_t bits = 70000; // 3 layers
+    LOB::OccupancyBitmap bitmap(bits);
+    std::set<size_t> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> posDist(0, bits - 1);
+
+    for(int i = 0; i < 2000; ++i){
+        size_t pos = posDist(gen);
+        if(reference.count(pos)){ bitmap.reset(pos); reference.erase(pos); }
+        else{ bitmap.set(pos); reference.insert(pos); }
+
+        size_t probe = posDist(gen);
+        auto next = reference.lower_bound(probe);
+        EXPECT_EQ(bitmap.findNext(probe), next == reference.end() ? LOB::OccupancyBitmap::npos : *next);
+
+        auto prev = reference.upper_bound(probe);
+        EXPECT_EQ(bitmap.findPrev(probe), prev == reference.begin() ? LOB::OccupancyBitmap::npos : *std::prev(prev));
+    }
+}
+
+// 7. A sweep through a sparse flat book jumps straight to the next level
+TEST(FlatPriceLadderTest, SkipsSparseGaps) {
+    LOB::BookConfig config;
+    config.basePrice = 1;
+    config.ladderTicks = 100000;
+    LOB::FlatPriceLadder<LOB::Side::Buy> bids(config);
+    LOB::Order a(1, 90000, 10, LOB::Side::Buy);
+    LOB::Order b(2, 7, 10, LOB::Side::Buy);
+
+    bids.getOrCreate(7)->append(&b);
+    bids.getOrCreate(90000)->append(&a);
+
+    LOB::LimitLevel* top = bids.best();
+    top->remove(&a);
+    bids.erase(top);
+    ASSERT_NE(bids.best(), nullptr);
+    EXPECT_EQ(bids.best()->getPrice(), 7u);
+}
+
+// 8. The map backend recycles level objects instead of new/delete
+TEST(MapPriceLadderTest, RecyclesLevels) {
+    LOB::BookConfig config;
+    LOB::MapPriceLadder<LOB::Side::Buy> bids(config);
+    LOB::Order order(1, 100, 10, LOB::Side::Buy);
+
+    LOB::LimitLevel* first = bids.getOrCreate(100);
+    first->append(&order);
+    first->remove(&order);
+    bids.erase(first);
+
+    // LIFO pool: a level at another price reuses the same slot, freshly constructed
+    LOB::LimitLevel* second = bids.getOrCreate(250);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->getPrice(), 250u);
+    EXPECT_EQ(second->getVolume(), 0u);
+    EXPECT_TRUE(second->isEmpty());
+}
+
+// 9. Every vector kernel gives the scalar answer, for any length, sparse arrays and targets at block edges
+TEST(DepthKernelsTest, MatchScalarReference) {
+    std::mt19937_64 rng(25);
+    std::vector<LOB::SimdLevel> levels = {LOB::SimdLevel::Scalar};
+    if(LOB::DepthKernels::detectSimd() >= LOB::SimdLevel::Avx2) levels.push_back(LOB::SimdLevel::Avx2);
+    if(LOB::DepthKernels::detectSimd() >= LOB::SimdLevel::Avx512) levels.push_back(LOB::SimdLevel::Avx512);
+
+    for(size_t n = 0; n <= 70; ++n){
+        std::vector<LOB::Quantity> v(n);
+        for(auto& q : v) q = (rng() % 3 == 0) ? 0 : rng() % 100;
+        LOB::Quantity total = LOB::DepthKernels::sumVolumeScalar(v.data(), n);
+
+        for(LOB::Quantity target : {LOB::Quantity{0}, LOB::Quantity{1}, total / 3, total / 2, total, total + 1}){
+            LOB::DepthScan expected = LOB::DepthKernels::scanToFillScalar(v.data(), n, target);
+            for(LOB::SimdLevel level : levels){
+                EXPECT_EQ(LOB::DepthKernels::sumVolume(v.data(), n, level), total);
+                LOB::DepthScan scan = LOB::DepthKernels::scanToFill(v.data(), n, target, level);
+                EXPECT_EQ(scan.index, expected.index) << "n=" << n << " target=" << target;
+                EXPECT_EQ(scan.before, expected.before);
+                EXPECT_EQ(scan.prefixSum, expected.prefixSum);
+                EXPECT_EQ(scan.nonEmpty, expected.nonEmpty);
+            }
+        }
+    }
+}
+
+// 10. Volume within N ticks, fill size, levels, worst price and notional: flat scans == map walk
+TEST(FlatPriceLadderTest, DepthQueriesMatchMapWalk) {
+    LOB::BookConfig config;
+    config.tickSize = 5;
+    config.ladderTicks = 16;   // small window: the flow forces recenters
+    LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::OrderIndex, LOB::NullSink> map(config);
+    LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::NullSink> flat(config);
+
+    // Exact values on a hand-built book: asks 1000 x 10, 1010 x 20, 1025 x 5
+    flat.addOrder(1, 1000, 10, LOB::Side::Sell);
+    flat.addOrder(2, 1010, 20, LOB::Side::Sell);
+    flat.addOrder(3, 1025, 5, LOB::Side::Sell);
+    EXPECT_EQ(flat.getVolumeWithin(LOB::Side::Sell, 0), 10u);
+    EXPECT_EQ(flat.getVolumeWithin(LOB::Side::Sell, 2), 30u);
+    LOB::FillEstimate est = flat.estimateFill(LOB::Side::Buy, 25);
+    EXPECT_EQ(est.filled, 25u);
+    EXPECT_EQ(est.levels, 2u);
+    EXPECT_EQ(est.worstPrice, 1010u);
+    EXPECT_EQ(est.notional, 10u * 1000 + 15u * 1010);
+    est = flat.estimateFill(LOB::Side::Buy, 100, 1020);
+    EXPECT_EQ(est.filled, 30u);
+    EXPECT_EQ(est.worstPrice, 1010u);
+    EXPECT_EQ(flat.estimateFill(LOB::Side::Buy, 100, 995).filled, 0u);
+    for(LOB::OrderId id = 1; id <= 3; ++id) flat.cancelOrder(id);
+
+    std::mt19937_64 rng(7);
+    std::vector<LOB::OrderId> live;
+    for(LOB::OrderId id = 1; id <= 4000; ++id){
+        uint64_t roll = rng() % 10;
+        if(roll < 3 && !live.empty()){
+            size_t pick = rng() % live.size();
+            map.cancelOrder(live[pick]);
+            flat.cancelOrder(live[pick]);
+            live[pick] = live.back();
+            live.pop_back();
+            continue;
+        }
+        // The mid drifts, so the flat window keeps moving; crossing orders trade.
+        LOB::Price mid = 5000 + (id / 200) * 50;
+        LOB::Side side = (rng() & 1) ? LOB::Side::Buy : LOB::Side::Sell;
+        LOB::Price price = mid + (rng() % 21) * 5 - 50;
+        LOB::Quantity qty = 1 + rng() % 50;
+        LOB::OrderType type = (roll == 9) ? LOB::OrderType::FillOrKill : LOB::OrderType::Limit;
+        map.addOrder(id, price, qty, side, type);
+        flat.addOrder(id, price, qty, side, type);
+        if(type == LOB::OrderType::Limit) live.push_back(id);
+
+        if(id % 50 == 0){
+            ASSERT_EQ(map.getOrderCount(), flat.getOrderCount());
+            for(LOB::Side s : {LOB::Side::Buy, LOB::Side::Sell}){
+                for(size_t ticks : {size_t{0}, size_t{3}, size_t{17}, size_t{1000}}){
+                    EXPECT_EQ(map.getVolumeWithin(s, ticks), flat.getVolumeWithin(s, ticks));
+                }
+                for(LOB::Quantity q : {LOB::Quantity{1}, LOB::Quantity{40}, LOB::Quantity{300}, LOB::Quantity{100000}}){
+                    for(LOB::Price limit : {mid - 20, mid, mid + 20}){
+                        LOB::FillEstimate a = map.estimateFill(s, q, limit);
+                        LOB::FillEstimate b = flat.estimateFill(s, q, limit);
+                        EXPECT_EQ(a.filled, b.filled);
+                        EXPECT_EQ(a.levels, b.levels);
+                        EXPECT_EQ(a.worstPrice, b.worstPrice);
+                        EXPECT_EQ(a.notional, b.notional);
+                    }
+                    EXPECT_EQ(map.estimateFill(s, q).notional, flat.estimateFill(s, q).notional);
+                }
+            }
+        }
+    }
+}
+
+// 11. A far-away price is an InvalidPrice reject, not a huge allocation; the book is left as it was
+TEST(FlatPriceLadderTest, WindowIsCapped) {
+    LOB::BookConfig config;
+    config.ladderTicks = 8;
+    config.maxLadderTicks = 64;
+    LOB::FlatPriceLadder<LOB::Side::Sell> asks(config);
+    LOB::Order a(1, 1000, 10, LOB::Side::Sell);
+    LOB::Order b(2, 1063, 10, LOB::Side::Sell);
+    asks.getOrCreate(1000)->append(&a);
+
+    EXPECT_TRUE(asks.isValidPrice(1063));       // 64 ticks from 1000 to 1063: exactly the cap
+    EXPECT_FALSE(asks.isValidPrice(1064));
+    EXPECT_FALSE(asks.isValidPrice(936));
+    asks.getOrCreate(1063)->append(&b);
+    EXPECT_EQ(asks.getTickCount(), 64u);
+    EXPECT_EQ(asks.find(1000)->getHead(), &a);
+    EXPECT_EQ(asks.find(1063)->getHead(), &b);
+    EXPECT_EQ(asks.best()->getPrice(), 1000u);
+
+    LOB::FlatOrderBook book(config);
+    book.addOrder(1, 1000, 10, LOB::Side::Sell);
+    book.addOrder(2, 1000000000000000, 10, LOB::Side::Sell);
+    book.addOrder(3, 999, 10, LOB::Side::Buy);      // the other side has its own window
+    book.modifyOrder(1, 1000000000000000, 10);
+    std::vector<LOB::Reject> rejects;
+    LOB::ExecutionEvent event;
+    while(book.getSink().events().pop(event)){
+        if(event.type == LOB::EventType::Reject) rejects.push_back(event.reject);
+    }
+    ASSERT_EQ(rejects.size(), 2u);
+    EXPECT_EQ(rejects[0].reason, LOB::RejectReason::InvalidPrice);
+    EXPECT_EQ(rejects[1].orderId, 1u);
+    EXPECT_EQ(rejects[1].reason, LOB::RejectReason::InvalidPrice);
+    EXPECT_EQ(book.getOrderCount(), 2u);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 1000u);
+
+    config.tickSize = 0;
+    LOB::FlatPriceLadder<LOB::Side::Buy> bids(config);
+    EXPECT_TRUE(bids.isValidPrice(101));
+}
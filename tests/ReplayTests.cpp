@@ -0,0 +1,190 @@
+/**
+ * @file ReplayTests.cpp
+ * @brief Unit Tests for the replay file format, the ITCH converter and the Replayer.
+ * @details
+ * Verified functionality:
+ * 1. ITCH add / execute / partial cancel / replace / delete translation
+ * 2. Write -> mmap -> replay round trip reproduces the book
+ * 3. Timestamp pacing honours the captured gaps
+ * 4. Corrupt / foreign files are refused
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../include/LOB/ReplayFormat.h"
+#include "../include/LOB/Replayer.h"
+#include "../include/LOB/OrderBook.h"
+
+namespace {
+    // Builds length-prefixed, big-endian ITCH 5.0 messages.
+    class ItchBuilder {
+        public:
+            std::vector<unsigned char> bytes;
+
+            void add(uint64_t ts, uint64_t ref, char side, uint32_t shares, uint32_t price, uint16_t locate = 7){
+                std::vector<unsigned char> m = header('A', locate, ts, ref);
+                m.push_back(static_cast<unsigned char>(side));
+                put(m, shares, 4);
+                for(int i = 0; i < 8; ++i) m.push_back(' '); // stock
+                put(m, price, 4);
+                frame(m);
+            }
+            void execute(uint64_t ts, uint64_t ref, uint32_t shares){
+                std::vector<unsigned char> m = header('E', 7, ts, ref);
+                put(m, shares, 4);
+                put(m, 1, 8); // match number
+                frame(m);
+            }
+            void cancel(uint64_t ts, uint64_t ref, uint32_t shares){
+                std::vector<unsigned char> m = header('X', 7, ts, ref);
+                put(m, shares, 4);
+                frame(m);
+            }
+            void remove(uint64_t ts, uint64_t ref){ frame(header('D', 7, ts, ref)); }
+            void replace(uint64_t ts, uint64_t ref, uint64_t newRef, uint32_t shares, uint32_t price){
+                std::vector<unsigned char> m = header('U', 7, ts, ref);
+                put(m, newRef, 8);
+                put(m, shares, 4);
+                put(m, price, 4);
+                frame(m);
+            }
+            void system(uint64_t ts){
+                std::vector<unsigned char> m = {'S', 0, 0, 0, 0};
+                put(m, ts, 6);
+                m.push_back('O');
+                frame(m);
+            }
+
+        private:
+            static void put(std::vector<unsigned char>& m, uint64_t v, int bytes){
+                for(int i = bytes - 1; i >= 0; --i) m.push_back(static_cast<unsigned char>(v >> (8 * i)));
+            }
+            static std::vector<unsigned char> header(char type, uint16_t locate, uint64_t ts, uint64_t ref){
+                std::vector<unsigned char> m = {static_cast<unsigned char>(type)};
+                put(m, locate, 2);
+                put(m, 0, 2); // tracking number
+                put(m, ts, 6);
+                put(m, ref, 8);
+                return m;
+            }
+            void frame(const std::vector<unsigned char>& m){
+                put(bytes, m.size(), 2);
+                bytes.insert(bytes.end(), m.begin(), m.end());
+            }
+    };
+
+    std::string tempPath(const char* name){
+        return ::testing::TempDir() + name;
+    }
+}
+
+// 1. Each ITCH order message becomes the expected record(s)
+TEST(ReplayTest, ConvertsItchMessages) {
+    ItchBuilder itch;
+    itch.system(1);
+    itch.add(10, 1, 'B', 100, 1000000);
+    itch.add(11, 2, 'S', 50, 1010000);
+    itch.execute(12, 1, 30);
+    itch.cancel(13, 1, 20);
+    itch.replace(14, 2, 3, 40, 1020000);
+    itch.remove(15, 1);
+    itch.execute(16, 99, 5); // never added
+
+    std::vector<LOB::ReplayRecord> records;
+    LOB::ItchStats stats = LOB::convertItch(itch.bytes, records);
+    EXPECT_EQ(stats.messages, 8u);
+    EXPECT_EQ(stats.skipped, 1u);
+    EXPECT_EQ(stats.orphans, 1u);
+    EXPECT_FALSE(stats.truncated);
+    ASSERT_EQ(records.size(), 7u);
+
+    EXPECT_EQ(records[0].type, LOB::ReplayEventType::Add);
+    EXPECT_EQ(records[0].side, LOB::Side::Buy);
+    EXPECT_EQ(records[0].price, 1000000u);
+    EXPECT_EQ(records[0].symbol, 7u);
+    EXPECT_EQ(records[2].type, LOB::ReplayEventType::Execute);
+    EXPECT_EQ(records[2].quantity, 30u);
+    EXPECT_EQ(records[3].type, LOB::ReplayEventType::Modify); // 100 - 30 - 20 left
+    EXPECT_EQ(records[3].quantity, 50u);
+    EXPECT_EQ(records[4].type, LOB::ReplayEventType::Cancel);  // replace = cancel old ...
+    EXPECT_EQ(records[5].type, LOB::ReplayEventType::Add);     // ... + add new, same side
+    EXPECT_EQ(records[5].orderId, 3u);
+    EXPECT_EQ(records[5].side, LOB::Side::Sell);
+    EXPECT_EQ(records[6].type, LOB::ReplayEventType::Cancel);
+
+    // A message cut off by the end of the capture is reported
+    itch.bytes.pop_back();
+    records.clear();
+    EXPECT_TRUE(LOB::convertItch(itch.bytes, records).truncated);
+}
+
+// 2. The mapped file replays into the same book state the capture describes
+TEST(ReplayTest, FileRoundTripRebuildsBook) {
+    ItchBuilder itch;
+    itch.add(1, 1, 'B', 100, 99);
+    itch.add(2, 2, 'B', 100, 98);
+    itch.add(3, 3, 'S', 70, 101);
+    itch.execute(4, 1, 40);   // bid 1 -> 60
+    itch.remove(5, 2);
+    itch.add(6, 4, 'S', 10, 102, 8); // other symbol
+
+    std::vector<LOB::ReplayRecord> records;
+    LOB::convertItch(itch.bytes, records);
+    std::string path = tempPath("roundtrip.nrep");
+    ASSERT_TRUE(LOB::writeReplayFile(path, records));
+
+    LOB::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_EQ(file.records().size(), records.size());
+
+    LOB::OrderBook book;
+    LOB::ReplayOptions options;
+    options.filterSymbol = true;
+    options.symbol = 7;
+    LOB::ReplayStats stats = LOB::replay(file.records(), book, options);
+
+    EXPECT_EQ(stats.records, 6u);
+    EXPECT_EQ(stats.filtered, 1u);
+    EXPECT_EQ(book.getOrderCount(), 2u);
+    EXPECT_EQ(book.getBestBid()->getPrice(), 99u);
+    EXPECT_EQ(book.getBestBid()->getVolume(), 60u);
+    EXPECT_EQ(book.getBestAsk()->getPrice(), 101u);
+    file.close();
+    std::remove(path.c_str());
+}
+
+// 3. Pacing reproduces a 30ms gap between two records (at speed 1)
+TEST(ReplayTest, TimestampPacing) {
+    std::vector<LOB::ReplayRecord> records = {
+        {0, 1, 100, 10, 0, LOB::ReplayEventType::Add, LOB::Side::Buy},
+        {30'000'000, 2, 101, 10, 0, LOB::ReplayEventType::Add, LOB::Side::Sell},
+    };
+    LOB::OrderBook book;
+
+    LOB::ReplayOptions paced;
+    paced.pacing = LOB::ReplayPacing::Timestamp;
+    EXPECT_GE(LOB::replay(records, book, paced).elapsedNanos, 30'000'000u);
+
+    LOB::OrderBook fast;
+    paced.speed = 1000.0;
+    EXPECT_LT(LOB::replay(records, fast, paced).elapsedNanos, 30'000'000u);
+    EXPECT_EQ(fast.getOrderCount(), 2u);
+}
+
+// 4. Files without the header are not interpreted as records
+TEST(ReplayTest, RejectsForeignFiles) {
+    std::string path = tempPath("foreign.bin");
+    FILE* f = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const char junk[64] = "definitely not a replay file";
+    std::fwrite(junk, 1, sizeof(junk), f);
+    std::fclose(f);
+
+    LOB::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_TRUE(file.records().empty());
+    EXPECT_FALSE(file.open(tempPath("does-not-exist.nrep")));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ReplayVerifierTests.cpp
+ * @brief Unit Tests for the event digests and the reference-vs-candidate replay verifier.
+ * @details
+ * Verified functionality:
+ * 1. XXH64 matches the reference implementation's test vectors
+ * 2. Digests are canonical: level-update order and coalescing do not change them, event content does
+ * 3. Every ladder x index configuration, batched or not, is bit-identical to the reference book
+ * 4. A real divergence is located at its sequence number, with both event lists captured
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/LOB/ReplayVerifier.h"
+
+namespace {
+
+    using Reference = LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::UnorderedOrderIndex, LOB::DigestSink>;
+
+    std::vector<LOB::OrderRequest> mixedFlow(size_t count, uint64_t seed){
+        std::mt19937_64 rng(seed);
+        std::vector<LOB::OrderRequest> flow;
+        std::vector<LOB::OrderId> live;
+        for(LOB::OrderId id = 1; flow.size() < count; ++id){
+            LOB::Side side = (rng() & 1) ? LOB::Side::Buy : LOB::Side::Sell;
+            LOB::Price price = 1000 + (rng() % 21) * 2;
+            LOB::Quantity qty = 1 + rng() % 30;
+            uint64_t roll = rng() % 10;
+            if(roll < 3 && !live.empty()){
+                flow.push_back({live[rng() % live.size()], 0, 0, side, LOB::RequestType::Cancel});
+            }
+            else if(roll < 5 && !live.empty()){
+                flow.push_back({live[rng() % live.size()], price, qty, side, LOB::RequestType::Modify});
+            }
+            else{
+                LOB::OrderType type = roll == 9 ? LOB::OrderType::FillOrKill : roll == 8 ? LOB::OrderType::ImmediateOrCancel : LOB::OrderType::Limit;
+                flow.push_back({id, price, qty, side, LOB::RequestType::Add, type});
+                live.push_back(id);
+            }
+        }
+        return flow;
+    }
+}
+
+// 1. Known answers
+TEST(EventDigestTest, MatchesReferenceVectors) {
+    EXPECT_EQ(LOB::XXH64::hash("", 0, 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(LOB::XXH64::hash("abc", 3, 0), 0x44BC2CF5AD770999ull);
+
+    // Stripe path (>= 32 bytes) and every tail length are deterministic and seed-sensitive
+    std::string text(100, 'x');
+    for(size_t len = 0; len <= text.size(); ++len){
+        EXPECT_EQ(LOB::XXH64::hash(text.data(), len, 7), LOB::XXH64::hash(text.data(), len, 7));
+        EXPECT_NE(LOB::XXH64::hash(text.data(), len, 7), LOB::XXH64::hash(text.data(), len, 8));
+    }
+}
+
+// 2. Canonical form
+TEST(EventDigestTest, IsCanonicalPerInstruction) {
+    LOB::BookConfig config;
+    LOB::DigestSink a(config), b(config), c(config);
+
+    a.onTrade(LOB::Trade{1, 2, 100, 5});
+    a.onBookUpdate(LOB::BookUpdate{101, 0, LOB::Side::Sell});
+    a.onBookUpdate(LOB::BookUpdate{100, 7, LOB::Side::Buy});
+    a.flush();
+
+    b.onBookUpdate(LOB::BookUpdate{100, 9, LOB::Side::Buy});
+    b.onTrade(LOB::Trade{1, 2, 100, 5});
+    b.onBookUpdate(LOB::BookUpdate{100, 7, LOB::Side::Buy});   // coalesced into the final volume
+    b.onBookUpdate(LOB::BookUpdate{101, 0, LOB::Side::Sell});
+    b.flush();
+    EXPECT_EQ(a.getDigests(), b.getDigests());
+
+    c.onTrade(LOB::Trade{1, 2, 100, 6});
+    c.onBookUpdate(LOB::BookUpdate{101, 0, LOB::Side::Sell});
+    c.onBookUpdate(LOB::BookUpdate{100, 7, LOB::Side::Buy});
+    c.flush();
+    EXPECT_NE(a.getDigest(), c.getDigest());
+
+    // Chained: equal instructions after a difference still give different digests
+    a.onCancel(LOB::Cancel{3, 1});
+    a.flush();
+    c.onCancel(LOB::Cancel{3, 1});
+    c.flush();
+    ASSERT_EQ(a.getDigests().size(), 2u);
+    EXPECT_NE(a.getDigests()[1], c.getDigests()[1]);
+}
+
+// 3. The optimized configurations are bit-identical to the reference
+TEST(ReplayVerifierTest, OptimizedConfigurationsAreIdentical) {
+    auto flow = mixedFlow(20000, 26);
+    LOB::BookConfig reference;
+    reference.orderPoolCapacity = 1024;
+    reference.orderPoolGrowable = true;
+
+    LOB::BookConfig candidate = reference;
+    candidate.ladderTicks = 8;                       // forces recenters
+    candidate.orderIndexMode = LOB::OrderIndexMode::Dense;
+    candidate.orderIndexCapacity = 32768;
+
+    auto flat = LOB::verifyReplay<Reference, LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::DigestSink>>(flow, reference, candidate, 64);
+    EXPECT_TRUE(flat.identical()) << "diverged at " << flat.firstDivergence;
+    EXPECT_EQ(flat.instructions, flow.size());
+    EXPECT_EQ(flat.referenceDigest, flat.candidateDigest);
+    EXPECT_NE(flat.referenceDigest, 0u);
+
+    auto map = LOB::verifyReplay<Reference, LOB::BasicOrderBook<LOB::MapPriceLadder, LOB::OrderIndex, LOB::DigestSink>>(flow, reference, reference, 1);
+    EXPECT_TRUE(map.identical());
+    EXPECT_EQ(map.referenceDigest, flat.referenceDigest);
+
+    auto unordered = LOB::verifyReplay<Reference, LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::UnorderedOrderIndex, LOB::DigestSink>>(flow, reference, reference, 7);
+    EXPECT_TRUE(unordered.identical());
+}
+
+// 4. A configuration that really behaves differently: tick size 4 rejects the first price off its grid
+TEST(ReplayVerifierTest, ReportsFirstDivergence) {
+    std::vector<LOB::OrderRequest> flow = {
+        {1, 1000, 10, LOB::Side::Buy, LOB::RequestType::Add},
+        {2, 1004, 10, LOB::Side::Sell, LOB::RequestType::Add},
+        {1, 0, 0, LOB::Side::Buy, LOB::RequestType::Cancel},
+        {3, 1002, 5, LOB::Side::Sell, LOB::RequestType::Add},   // off a 4-tick grid
+        {4, 1008, 5, LOB::Side::Sell, LOB::RequestType::Add},
+    };
+    LOB::BookConfig reference;
+    LOB::BookConfig candidate;
+    candidate.tickSize = 4;
+
+    auto report = LOB::verifyReplay<Reference, LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::DigestSink>>(flow, reference, candidate, 2);
+    ASSERT_FALSE(report.identical());
+    EXPECT_EQ(report.firstDivergence, 3u);
+    EXPECT_NE(report.referenceDigest, report.candidateDigest);
+
+    ASSERT_EQ(report.referenceEvents.size(), 1u);
+    EXPECT_EQ(report.referenceEvents[0].type, LOB::EventType::BookUpdate);
+    EXPECT_EQ(report.referenceEvents[0].update.price, 1002u);
+    ASSERT_EQ(report.candidateEvents.size(), 1u);
+    EXPECT_EQ(report.candidateEvents[0].type, LOB::EventType::Reject);
+    EXPECT_EQ(report.candidateEvents[0].reject.reason, LOB::RejectReason::InvalidPrice);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file RiskGateTests.cpp
+ * @brief Unit Tests for the inline pre-trade risk gate.
+ * @details
+ * Verified functionality:
+ * 1. Each limit (size, collar, position, notional, unknown account) rejects through the sink, leaving the book untouched
+ * 2. Fills move positions and release working exposure; cancels and IOC remainders release it
+ * 3. Amendments are checked against the exposure they replace
+ * 4. Book-level rejects release the submission, rejects of amendments do not
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/LOB/RiskGate.h"
+
+class RiskGateTest : public ::testing::Test {
+protected:
+    LOB::RiskCheckedOrderBook book;
+    LOB::RiskGate<LOB::RiskCheckedOrderBook> gate{book};
+
+    std::vector<LOB::Reject> drainRejects() {
+        std::vector<LOB::Reject> rejects;
+        LOB::ExecutionEvent event;
+        while(book.getSink().events().pop(event)){
+            if(event.type == LOB::EventType::Reject) rejects.push_back(event.reject);
+        }
+        return rejects;
+    }
+};
+
+// 1. Every limit, evaluated together, reported as a structured reject
+TEST_F(RiskGateTest, RejectsEachLimit) {
+    LOB::RiskLimits limits;
+    limits.maxOrderQty = 100;
+    limits.priceCollar = 5;
+    limits.maxPosition = 150;
+    limits.maxNotional = 30000;
+    ASSERT_TRUE(gate.setLimits(0, limits));
+    EXPECT_FALSE(gate.setLimits(64, limits));
+
+    // Reference quote 100 / 102 (mid 101) from an unchecked account
+    EXPECT_TRUE(gate.addOrder(1, 1, 100, 10, LOB::Side::Buy));
+    EXPECT_TRUE(gate.addOrder(1, 2, 102, 10, LOB::Side::Sell));
+    drainRejects();
+
+    EXPECT_FALSE(gate.addOrder(0, 10, 101, 101, LOB::Side::Buy));   // size
+    EXPECT_FALSE(gate.addOrder(0, 11, 101, 0, LOB::Side::Buy));     // size 0
+    EXPECT_FALSE(gate.addOrder(0, 12, 107, 10, LOB::Side::Sell));   // 6 above the mid
+    EXPECT_FALSE(gate.addOrder(99, 13, 101, 10, LOB::Side::Buy));   // account
+    EXPECT_TRUE(gate.addOrder(0, 14, 99, 100, LOB::Side::Buy));     // 100 working, 9900 notional
+    EXPECT_FALSE(gate.addOrder(0, 15, 99, 60, LOB::Side::Buy));     // 160 working > 150
+    EXPECT_TRUE(gate.addOrder(0, 16, 99, 50, LOB::Side::Buy));      // 150 working, 14850 notional
+    EXPECT_TRUE(gate.addOrder(0, 17, 103, 100, LOB::Side::Sell));   // sells count separately: 25150 notional
+    EXPECT_FALSE(gate.addOrder(0, 18, 103, 50, LOB::Side::Sell));   // notional 30300
+    EXPECT_FALSE(gate.addOrder(0, 14, 99, 1, LOB::Side::Buy));      // still working
+
+    auto rejects = drainRejects();
+    ASSERT_EQ(rejects.size(), 7u);
+    EXPECT_EQ(rejects[0].reason, LOB::RejectReason::RiskOrderSize);
+    EXPECT_EQ(rejects[1].reason, LOB::RejectReason::RiskOrderSize);
+    EXPECT_EQ(rejects[2].reason, LOB::RejectReason::RiskPriceCollar);
+    EXPECT_EQ(rejects[3].reason, LOB::RejectReason::RiskUnknownAccount);
+    EXPECT_EQ(rejects[4].reason, LOB::RejectReason::RiskPosition);
+    EXPECT_EQ(rejects[5].reason, LOB::RejectReason::RiskNotional);
+    EXPECT_EQ(rejects[6].reason, LOB::RejectReason::DuplicateOrderId);
+    EXPECT_EQ(rejects[6].orderId, 14u);
+    EXPECT_EQ(gate.getRejectCount(), 7u);
+
+    // Nothing refused reached the book
+    EXPECT_EQ(book.getOrderCount(), 5u);
+    EXPECT_EQ(book.findOrder(15), nullptr);
+    EXPECT_EQ(book.findOrder(14)->quantity, 100u);
+
+    const LOB::AccountRisk& a = gate.getAccount(0);
+    EXPECT_EQ(a.openBuy, 150u);
+    EXPECT_EQ(a.openSell, 100u);
+    EXPECT_EQ(a.openNotional, 25150u);
+}
+
+// 2. Fills move the position of both counterparties; cancels and IOC remainders release exposure
+TEST_F(RiskGateTest, TracksFillsAndCancels) {
+    gate.addOrder(0, 1, 100, 30, LOB::Side::Sell);
+    gate.addOrder(0, 2, 101, 30, LOB::Side::Sell);
+    gate.addOrder(1, 3, 101, 40, LOB::Side::Buy);   // takes 30 @100 and 10 @101
+
+    const LOB::AccountRisk& seller = gate.getAccount(0);
+    const LOB::AccountRisk& buyer = gate.getAccount(1);
+    EXPECT_EQ(seller.position, -40);
+    EXPECT_EQ(seller.openSell, 20u);
+    EXPECT_EQ(seller.openNotional, 20u * 101);
+    EXPECT_EQ(buyer.position, 40);
+    EXPECT_EQ(buyer.openBuy, 0u);
+    EXPECT_EQ(buyer.openNotional, 0u);
+
+    gate.addOrder(1, 4, 102, 50, LOB::Side::Buy, LOB::OrderType::ImmediateOrCancel);  // 20 fill, 30 discarded
+    EXPECT_EQ(buyer.position, 60);
+    EXPECT_EQ(buyer.openBuy, 0u);
+    EXPECT_EQ(seller.openSell, 0u);
+    EXPECT_EQ(seller.openNotional, 0u);
+
+    gate.addOrder(1, 5, 90, 10, LOB::Side::Buy);
+    EXPECT_EQ(buyer.openBuy, 10u);
+    gate.cancelOrder(5);
+    EXPECT_EQ(buyer.openBuy, 0u);
+    EXPECT_EQ(buyer.openNotional, 0u);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+}
+
+// 3. Amendments: exposure replaced, not added
+TEST_F(RiskGateTest, ChecksAmendments) {
+    LOB::RiskLimits limits;
+    limits.maxPosition = 100;
+    gate.setLimits(0, limits);
+
+    gate.addOrder(0, 1, 100, 80, LOB::Side::Buy);
+    EXPECT_TRUE(gate.modifyOrder(1, 100, 100));     // 100 replaces 80
+    EXPECT_FALSE(gate.modifyOrder(1, 100, 101));
+    EXPECT_EQ(book.findOrder(1)->quantity, 100u);
+
+    EXPECT_TRUE(gate.modifyOrder(1, 99, 40));
+    const LOB::AccountRisk& a = gate.getAccount(0);
+    EXPECT_EQ(a.openBuy, 40u);
+    EXPECT_EQ(a.openNotional, 40u * 99);
+
+    EXPECT_TRUE(gate.modifyOrder(1, 99, 0));        // quantity 0 = cancel
+    EXPECT_EQ(a.openBuy, 0u);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+}
+
+// 4. Rejects raised by the book itself
+TEST_F(RiskGateTest, BookRejectsReleaseOnlySubmissions) {
+    LOB::BookConfig config;
+    config.tickSize = 5;
+    config.basePrice = 1000;
+    LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::RiskSink<>> flat(config);
+    LOB::RiskGate<decltype(flat)> flatGate(flat);
+
+    EXPECT_TRUE(flatGate.addOrder(0, 1, 1003, 10, LOB::Side::Buy));   // off the tick grid: book rejects
+    EXPECT_EQ(flatGate.getAccount(0).openBuy, 0u);
+
+    EXPECT_TRUE(flatGate.addOrder(0, 2, 1000, 10, LOB::Side::Buy));
+    EXPECT_TRUE(flatGate.modifyOrder(2, 1003, 10));                    // rejected by the book, order unchanged
+    EXPECT_EQ(flatGate.getAccount(0).openBuy, 10u);
+    EXPECT_EQ(flat.findOrder(2)->price, 1000u);
+    EXPECT_EQ(flatGate.getRejectCount(), 0u);
+}
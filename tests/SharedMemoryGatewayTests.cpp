@@ -0,0 +1,156 @@
+/**
+ * @file SharedMemoryGatewayTests.cpp
+ * @brief Unit Tests for the shared-memory ring and the engine <-> client gateway region.
+ * @details
+ * Verified functionality:
+ * 1. A ring formatted through one mapping is driven through another (different address), across wraps
+ * 2. Attaching refuses missing regions, foreign contents and a different payload size
+ * 3. A client process submits orders and reads back the engine's trades and level updates
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../include/LOB/OrderBook.h"
+#include "../include/LOB/SharedMemoryGateway.h"
+
+namespace {
+
+    std::string uniqueName(const char* tag){
+        return std::string("/nanobook_") + tag + "_" + std::to_string(getpid());
+    }
+}
+
+// 1. Two views of one ring
+TEST(SharedRingTest, WorksAcrossMappings) {
+    const std::string name = uniqueName("ring");
+    LOB::SharedMemoryRegion owner;
+    ASSERT_TRUE(owner.create(name, LOB::SharedRing<uint64_t>::bytesFor(6)));
+    LOB::SharedRing<uint64_t> producer;
+    producer.format(owner.data(), 6);
+    EXPECT_EQ(producer.getCapacity(), 8u);
+
+    LOB::SharedMemoryRegion other;
+    ASSERT_TRUE(other.open(name));
+    EXPECT_NE(other.data(), owner.data());
+    LOB::SharedRing<uint64_t> consumer;
+    ASSERT_TRUE(consumer.bind(other.data(), other.size()));
+
+    uint64_t value = 0;
+    for(uint64_t round = 0; round < 5; ++round){
+        for(uint64_t i = 0; i < 8; ++i) ASSERT_TRUE(producer.push(round * 100 + i));
+        EXPECT_FALSE(producer.push(0));
+        EXPECT_EQ(consumer.size(), 8u);
+
+        auto view = consumer.peek_bulk(16);
+        ASSERT_EQ(view.size(), 8u);
+        EXPECT_EQ(view[7], round * 100 + 7);
+        consumer.release(3);
+
+        uint64_t out[8];
+        EXPECT_EQ(consumer.pop_bulk(out, 8), 5u);
+        EXPECT_EQ(out[0], round * 100 + 3);
+        EXPECT_FALSE(consumer.pop(value));
+    }
+    EXPECT_EQ(consumer.getFullCount(), 5u);
+
+    uint64_t* slot = producer.try_claim();
+    ASSERT_NE(slot, nullptr);
+    *slot = 42;
+    producer.commit();
+    ASSERT_TRUE(consumer.pop(value));
+    EXPECT_EQ(value, 42u);
+}
+
+// 2. Layout checks
+TEST(SharedRingTest, RefusesForeignLayouts) {
+    LOB::SharedMemoryGateway missing;
+    EXPECT_FALSE(missing.attach(uniqueName("missing")));
+
+    const std::string name = uniqueName("layout");
+    LOB::SharedMemoryRegion owner;
+    ASSERT_TRUE(owner.create(name, LOB::SharedRing<uint64_t>::bytesFor(16)));
+
+    LOB::SharedRing<uint64_t> ring;
+    EXPECT_FALSE(ring.bind(owner.data(), owner.size()));            // zeroed: never formatted
+    ring.format(owner.data(), 16);
+
+    LOB::SharedRing<LOB::OrderRequest> wrongSize;
+    EXPECT_FALSE(wrongSize.bind(owner.data(), owner.size()));
+    EXPECT_FALSE(ring.bind(owner.data(), 64));                      // truncated mapping
+
+    LOB::SharedMemoryGateway notAGateway;
+    EXPECT_FALSE(notAGateway.attach(name));
+    EXPECT_FALSE(notAGateway.isOpen());
+}
+
+// 3. Real client process
+TEST(SharedMemoryGatewayTest, ClientProcessTradesThroughTheEngine) {
+    using Book = LOB::BasicOrderBook<LOB::FlatPriceLadder, LOB::OrderIndex, LOB::SharedMemorySink>;
+    constexpr uint64_t ORDERS = 2000;   // buy / sell pairs at one price: every sell fills one buy
+
+    const std::string name = uniqueName("gateway");
+    LOB::SharedMemoryGateway engine;
+    ASSERT_TRUE(engine.create(name, 256, 1 << 14));
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0){
+        // Client: submit through the ingress ring while draining the drop copy.
+        LOB::SharedMemoryGateway client;
+        if(!client.attach(name)) _exit(2);
+
+        uint64_t trades = 0, traded = 0, updates = 0;
+        auto drain = [&]{
+            LOB::ExecutionEvent event;
+            while(client.egress().pop(event)){
+                if(event.type == LOB::EventType::Trade){
+                    ++trades;
+                    traded += event.trade.quantity;
+                }
+                else if(event.type == LOB::EventType::BookUpdate){
+                    ++updates;
+                }
+            }
+        };
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        for(uint64_t i = 0; i < ORDERS; ++i){
+            LOB::OrderRequest* slot;
+            while(!(slot = client.ingress().try_claim())){
+                drain();
+                if(std::chrono::steady_clock::now() > deadline) _exit(3);
+            }
+            *slot = {i + 1, 100, 10, (i % 2 == 0) ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add};
+            client.ingress().commit();
+        }
+        while(trades < ORDERS / 2 && std::chrono::steady_clock::now() < deadline) drain();
+        drain();
+        _exit(trades == ORDERS / 2 && traded == ORDERS / 2 * 10 && updates >= ORDERS ? 0 : 1);
+    }
+
+    // Engine: the matching loop of a lane, fed from another process.
+    LOB::BookConfig config;
+    config.gatewayName = name.c_str();
+    Book book(config);
+    ASSERT_TRUE(book.getSink().isAttached());
+
+    uint64_t processed = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while(processed < ORDERS && std::chrono::steady_clock::now() < deadline){
+        auto batch = engine.ingress().peek_bulk(64);
+        if(batch.empty()) continue;
+        book.applyBatch(batch);
+        engine.ingress().release(batch.size());
+        processed += batch.size();
+    }
+    EXPECT_EQ(processed, ORDERS);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+    EXPECT_EQ(book.getSink().getDroppedCount(), 0u);
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -1,8 +1,8 @@
 /**
  * @file StressTests.cpp
- * @brief Concurrency and Stability tests for the ThreadSafeOrderBook.
+ * @brief Concurrency and Stability tests for the ThreadSafeOrderBook and the GatewayIngress path.
  * @details
- * This file performs "Hammer Tests" to verify the SpinLock implementation.
+ * This file performs "Hammer Tests" to verify the SpinLock implementation and the lock-free multi-gateway ingress.
  * It spawns multiple threads that aggressively hammer the engine with orders.
  * * Pass Condition: The program does not Segfault or throw exceptions.
  * * Fail Condition: Memory corruption (Segfault) due to race conditions.
@@ -11,7 +11,11 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <vector>
+#include <atomic>
+#include <span>
 #include "../include/LOB/ThreadSafeOrderBook.h"
+#include "../include/LOB/GatewayIngress.h"
+#include "../include/LOB/OrderRequest.h"
 
 /**
  * @brief A worker function mimicking an active high-frequency trader.
@@ -67,4 +71,76 @@ TEST(ConcurrencyTest, NoCrashesUnderLoad) {
             t.join();
         }
     });
-}
\ No newline at end of file
+}
+/**
+ * @test GatewayIngressTest.LanesAreInterleavedRoundRobin
+ * @brief A flooded lane cannot starve the others: each round takes at most one quantum per lane, in lane order.
+ */
+TEST(GatewayIngressTest, LanesAreInterleavedRoundRobin) {
+    LOB::GatewayIngress<int> ingress(3, 64);
+    for(int i = 0; i < 10; ++i) ingress.lane(0).push(i);
+    ingress.lane(1).push(100);
+    ingress.lane(2).push(200);
+    ingress.lane(2).push(201);
+
+    std::vector<std::pair<size_t, int>> seen;
+    auto record = [&](std::span<const int> batch, size_t gateway){
+        for(int v : batch) seen.emplace_back(gateway, v);
+    };
+
+    EXPECT_EQ(ingress.poll(record, 2), 5u);
+    std::vector<std::pair<size_t, int>> firstRound = {{0, 0}, {0, 1}, {1, 100}, {2, 200}, {2, 201}};
+    EXPECT_EQ(seen, firstRound);
+
+    while(ingress.poll(record, 2) > 0) {}
+    EXPECT_EQ(seen.size(), 13u);
+    EXPECT_EQ(ingress.pending(), 0u);
+}
+
+/**
+ * @test GatewayIngressTest.NoLossUnderLoad
+ * @brief Same load as ConcurrencyTest.NoCrashesUnderLoad, but gateways only push into their own lane
+ * and a single engine thread owns the (unlocked) OrderBook.
+ */
+TEST(GatewayIngressTest, NoLossUnderLoad) {
+    constexpr int numThreads = 4;
+    constexpr int ordersPerThread = 20000;
+
+    LOB::BookConfig config;
+    config.orderPoolCapacity = numThreads * ordersPerThread;
+    LOB::OrderBook book(config);
+    LOB::GatewayIngress<LOB::OrderRequest> ingress(numThreads, 1024);
+    std::atomic<int> gatewaysDone{0};
+
+    std::vector<std::thread> gateways;
+    for(int g = 0; g < numThreads; ++g){
+        gateways.emplace_back([&, g]{
+            auto& lane = ingress.lane(g);
+            for(int i = 0; i < ordersPerThread; ++i){
+                LOB::OrderRequest req{static_cast<LOB::OrderId>(g * 1000000 + i), 100 + static_cast<LOB::Price>(i % 5), 10,
+                                      (i % 2 == 0) ? LOB::Side::Buy : LOB::Side::Sell, LOB::RequestType::Add};
+                while(!lane.push(req)) std::this_thread::yield();
+            }
+            gatewaysDone.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    uint64_t processed = 0, tradedVolume = 0;
+    LOB::ExecutionEvent event;
+    while(true){
+        // Read the flag BEFORE polling, so no request published before the last gateway finished is missed.
+        bool done = gatewaysDone.load(std::memory_order_acquire) == numThreads;
+        size_t n = ingress.poll([&](std::span<const LOB::OrderRequest> batch, size_t){ book.applyBatch(batch); });
+        processed += n;
+        while(book.getSink().events().pop(event)){
+            if(event.type == LOB::EventType::Trade) tradedVolume += event.trade.quantity;
+        }
+        if(done && n == 0) break;
+        if(n == 0) std::this_thread::yield();
+    }
+    for(auto& t : gateways) t.join();
+
+    EXPECT_EQ(processed, static_cast<uint64_t>(numThreads * ordersPerThread));
+    // Conservation: all orders are 10 lots, so every share either traded (once per side) or still rests.
+    EXPECT_EQ(book.getOrderCount() * 10 + tradedVolume * 2, static_cast<uint64_t>(numThreads * ordersPerThread) * 10);
+}
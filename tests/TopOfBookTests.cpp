@@ -0,0 +1,114 @@
+/**
+ * @file TopOfBookTests.cpp
+ * @brief Unit Tests for the seqlock-published best bid/offer.
+ * @details
+ * Verified functionality:
+ * 1. The quote follows adds, trades and cancels (price, volume, order count)
+ * 2. Instructions behind the top of book do not publish
+ * 3. Concurrent readers never observe a torn quote
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "../include/LOB/OrderBook.h"
+#include "../include/LOB/TopOfBook.h"
+#include "../include/LOB/ThreadSafeOrderBook.h"
+
+// 1. BBO fields after each kind of state change
+TEST(TopOfBookTest, FollowsTheBook) {
+    LOB::OrderBook book;
+    EXPECT_EQ(book.getTopOfBook().read().sequence, 0u);
+
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(2, 100, 5, LOB::Side::Buy);
+    book.addOrder(3, 102, 7, LOB::Side::Sell);
+
+    LOB::Quote q = book.getTopOfBook().read();
+    EXPECT_EQ(q.bidPrice, 100u);
+    EXPECT_EQ(q.bidVolume, 15u);
+    EXPECT_EQ(q.bidOrders, 2u);
+    EXPECT_EQ(q.askPrice, 102u);
+    EXPECT_EQ(q.askVolume, 7u);
+    EXPECT_EQ(q.askOrders, 1u);
+    EXPECT_EQ(q.sequence, 3u);
+
+    book.addOrder(4, 100, 12, LOB::Side::Sell); // fills order 1 and 2 of 5
+    q = book.getTopOfBook().read();
+    EXPECT_EQ(q.bidVolume, 3u);
+    EXPECT_EQ(q.bidOrders, 1u);
+
+    book.cancelOrder(2);
+    q = book.getTopOfBook().read();
+    EXPECT_EQ(q.bidVolume, 0u);
+    EXPECT_EQ(q.bidPrice, 0u);
+    EXPECT_EQ(q.askPrice, 102u);
+}
+
+// 2. Only BBO changes bump the sequence
+TEST(TopOfBookTest, SkipsUnchangedQuotes) {
+    LOB::OrderBook book;
+    book.addOrder(1, 100, 10, LOB::Side::Buy);
+    book.addOrder(2, 105, 10, LOB::Side::Sell);
+    uint64_t seq = book.getTopOfBook().getSequence();
+
+    book.addOrder(3, 95, 10, LOB::Side::Buy);   // behind the best bid
+    book.addOrder(4, 110, 10, LOB::Side::Sell); // behind the best ask
+    book.cancelOrder(3);
+    book.cancelOrder(42);                       // rejected
+    EXPECT_EQ(book.getTopOfBook().getSequence(), seq);
+
+    book.modifyOrder(1, 100, 4); // in-place reduce at the top
+    EXPECT_EQ(book.getTopOfBook().getSequence(), seq + 1);
+    EXPECT_EQ(book.getTopOfBook().read().bidVolume, 4u);
+}
+
+// 3. A writer publishes quotes whose fields are all derived from one counter; readers must never see a mix
+TEST(TopOfBookTest, ConcurrentReadsAreConsistent) {
+    LOB::TopOfBook top;
+    std::atomic<bool> done{false};
+    constexpr uint64_t WRITES = 200000;
+
+    std::thread writer([&]{
+        for(uint64_t k = 1; k <= WRITES; ++k){
+            LOB::Quote q;
+            q.bidPrice = k;
+            q.bidVolume = k * 2;
+            q.bidOrders = static_cast<uint32_t>(k);
+            q.askPrice = k + 1;
+            q.askVolume = k * 3;
+            q.askOrders = static_cast<uint32_t>(k + 7);
+            top.publish(q);
+            if((k & 1023) == 0) std::this_thread::yield();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint64_t reads = 0, torn = 0, lastSeq = 0;
+    while(!done.load(std::memory_order_acquire) || reads == 0){
+        LOB::Quote q = top.read();
+        uint64_t k = q.bidPrice;
+        if(q.sequence != 0){
+            if(q.bidVolume != k * 2 || q.askPrice != k + 1 || q.askVolume != k * 3 ||
+               q.bidOrders != static_cast<uint32_t>(k) || q.askOrders != static_cast<uint32_t>(k + 7) ||
+               q.sequence != k) ++torn;
+            EXPECT_GE(q.sequence, lastSeq);
+            lastSeq = q.sequence;
+        }
+        ++reads;
+        if((reads & 255) == 0) std::this_thread::yield();
+    }
+    writer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(top.read().sequence, WRITES);
+}
+
+// 4. The thread-safe wrapper serves quotes without taking its lock
+TEST(TopOfBookTest, ThreadSafeBookQuoteIsLockFree) {
+    LOB::ThreadSafeOrderBook book;
+    book.addOrder(1, 99, 10, LOB::Side::Buy);
+    book.addOrder(2, 101, 10, LOB::Side::Sell);
+    LOB::Quote q = book.getQuote();
+    EXPECT_EQ(q.bidPrice, 99u);
+    EXPECT_EQ(q.askPrice, 101u);
+}
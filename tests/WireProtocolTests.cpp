@@ -0,0 +1,204 @@
+/**
+ * @file WireProtocolTests.cpp
+ * @brief Unit Tests for the binary order-entry decoder and its socket front ends.
+ * @details
+ * Verified functionality:
+ * 1. A buffer of mixed messages decodes in order into queue slots; a cut-off tail is left unconsumed
+ * 2. Invalid messages are skipped and counted, an impossible length stops decoding
+ * 3. A full queue stops decoding at a message boundary and resumes from 'consumed'
+ * 4. The stream receiver reassembles messages split across segments
+ * 5. The datagram receiver drains a recvmmsg batch and keeps its place under back-pressure
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../include/LOB/LockFreeQueue.h"
+#include "../include/LOB/WireProtocol.h"
+#include "../include/LOB/OrderEntryReceiver.h"
+
+namespace {
+
+    LOB::Wire::NewOrder newOrder(LOB::OrderId id, LOB::Price price, LOB::Quantity qty, uint8_t side, uint8_t orderType = 0){
+        LOB::Wire::NewOrder message;
+        message.symbol = 7;
+        message.id = id;
+        message.price = price;
+        message.quantity = qty;
+        message.side = side;
+        message.orderType = orderType;
+        return message;
+    }
+
+    template <typename Message>
+    void append(std::vector<unsigned char>& bytes, const Message& message){
+        size_t at = bytes.size();
+        bytes.resize(at + sizeof(Message));
+        LOB::encodeMessage(message, bytes.data() + at);
+    }
+}
+
+// 1. Many messages per buffer
+TEST(WireProtocolTest, DecodesMixedBatch) {
+    std::vector<unsigned char> bytes;
+    append(bytes, newOrder(1, 100, 10, 0));
+    append(bytes, newOrder(2, 101, 5, 1, 2));
+    LOB::Wire::ModifyOrder modify;
+    modify.id = 1;
+    modify.price = 99;
+    modify.quantity = 4;
+    append(bytes, modify);
+    LOB::Wire::CancelOrder cancel;
+    cancel.symbol = 7;
+    cancel.id = 2;
+    append(bytes, cancel);
+    const size_t whole = bytes.size();
+    append(bytes, newOrder(3, 100, 1, 0));
+    bytes.resize(bytes.size() - 5);    // last message cut off
+
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(16);
+    LOB::DecodeResult result = LOB::decodeOrderEntry(bytes, queue);
+    EXPECT_EQ(result.decoded, 4u);
+    EXPECT_EQ(result.consumed, whole);
+    EXPECT_EQ(result.invalid, 0u);
+    EXPECT_FALSE(result.framingError);
+
+    LOB::OrderRequest out[8];
+    ASSERT_EQ(queue.pop_bulk(out, 8), 4u);
+    EXPECT_EQ(out[0].type, LOB::RequestType::Add);
+    EXPECT_EQ(out[0].id, 1u);
+    EXPECT_EQ(out[0].price, 100u);
+    EXPECT_EQ(out[0].qty, 10u);
+    EXPECT_EQ(out[0].side, LOB::Side::Buy);
+    EXPECT_EQ(out[0].symbol, 7u);
+    EXPECT_EQ(out[1].side, LOB::Side::Sell);
+    EXPECT_EQ(out[1].orderType, LOB::OrderType::ImmediateOrCancel);
+    EXPECT_EQ(out[2].type, LOB::RequestType::Modify);
+    EXPECT_EQ(out[2].price, 99u);
+    EXPECT_EQ(out[2].qty, 4u);
+    EXPECT_EQ(out[3].type, LOB::RequestType::Cancel);
+    EXPECT_EQ(out[3].id, 2u);
+}
+
+// 2. Validation and framing
+TEST(WireProtocolTest, SkipsInvalidAndStopsOnBadFraming) {
+    std::vector<unsigned char> bytes;
+    append(bytes, newOrder(1, 100, 0, 0));       // zero quantity
+    append(bytes, newOrder(2, 100, 5, 2));       // bad side
+    append(bytes, newOrder(3, 100, 5, 0, 9));    // bad order type
+    LOB::Wire::CancelOrder wrongType;
+    wrongType.header.type = 'Z';
+    append(bytes, wrongType);
+    LOB::Wire::CancelOrder wrongLength;
+    wrongLength.header.type = LOB::Wire::NewOrderType;
+    append(bytes, wrongLength);
+    append(bytes, newOrder(4, 100, 5, 0));       // the only good one
+    const size_t good = bytes.size();
+    LOB::Wire::Header garbage{2, LOB::Wire::NewOrderType};
+    append(bytes, garbage);
+    append(bytes, newOrder(5, 100, 5, 0));       // unreachable after the framing error
+
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(16);
+    LOB::DecodeResult result = LOB::decodeOrderEntry(bytes, queue);
+    EXPECT_EQ(result.decoded, 1u);
+    EXPECT_EQ(result.invalid, 5u);
+    EXPECT_EQ(result.consumed, good);
+    EXPECT_TRUE(result.framingError);
+
+    LOB::OrderRequest request;
+    ASSERT_TRUE(queue.pop(request));
+    EXPECT_EQ(request.id, 4u);
+    EXPECT_FALSE(queue.pop(request));
+}
+
+// 3. Back-pressure, including a claim that stops at the physical end of the ring
+TEST(WireProtocolTest, ResumesAfterQueueFull) {
+    std::vector<unsigned char> bytes;
+    for(LOB::OrderId id = 1; id <= 10; ++id) append(bytes, newOrder(id, 100, id, 0));
+
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(8);
+    LOB::OrderRequest out[8];
+    ASSERT_TRUE(queue.push(LOB::OrderRequest{}));
+    ASSERT_TRUE(queue.push(LOB::OrderRequest{}));
+    ASSERT_EQ(queue.pop_bulk(out, 2), 2u);     // ring now starts two slots in
+
+    std::span<const unsigned char> rest(bytes);
+    LOB::DecodeResult first = LOB::decodeOrderEntry(rest, queue);
+    EXPECT_EQ(first.decoded, 8u);
+    EXPECT_TRUE(first.queueFull);
+    EXPECT_EQ(first.consumed, 8 * sizeof(LOB::Wire::NewOrder));
+
+    ASSERT_EQ(queue.pop_bulk(out, 8), 8u);
+    for(size_t i = 0; i < 8; ++i) EXPECT_EQ(out[i].id, i + 1);
+
+    LOB::DecodeResult second = LOB::decodeOrderEntry(rest.subspan(first.consumed), queue);
+    EXPECT_EQ(second.decoded, 2u);
+    EXPECT_FALSE(second.queueFull);
+    ASSERT_EQ(queue.pop_bulk(out, 8), 2u);
+    EXPECT_EQ(out[0].id, 9u);
+    EXPECT_EQ(out[1].id, 10u);
+}
+
+// 4. TCP-style reassembly
+TEST(WireProtocolTest, StreamReassemblesSplitMessages) {
+    std::vector<unsigned char> bytes;
+    for(LOB::OrderId id = 1; id <= 5; ++id) append(bytes, newOrder(id, 100 + id, 1, 1));
+
+    LOB::OrderEntryStream stream(128);
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(16);
+    size_t sent = 0;
+    size_t decoded = 0;
+    const size_t segments[] = {3, 50, 37, 90, 20};   // 200 bytes, cut mid-header and mid-body
+    for(size_t segment : segments){
+        std::span<unsigned char> space = stream.writable();
+        ASSERT_GE(space.size(), segment);
+        std::memcpy(space.data(), bytes.data() + sent, segment);
+        stream.received(segment);
+        sent += segment;
+        decoded += stream.decode(queue).decoded;
+        EXPECT_EQ(decoded, sent / sizeof(LOB::Wire::NewOrder));
+    }
+    EXPECT_EQ(stream.getBuffered(), 0u);
+    EXPECT_EQ(stream.getDecodedCount(), 5u);
+    EXPECT_FALSE(stream.isBroken());
+
+    LOB::OrderRequest out[8];
+    ASSERT_EQ(queue.pop_bulk(out, 8), 5u);
+    EXPECT_EQ(out[4].id, 5u);
+    EXPECT_EQ(out[4].price, 105u);
+}
+
+// 5. recvmmsg batches over a datagram socket pair
+TEST(WireProtocolTest, DatagramReceiverDrainsBatches) {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+
+    LOB::OrderId id = 0;
+    for(int datagram = 0; datagram < 4; ++datagram){
+        std::vector<unsigned char> bytes;
+        for(int i = 0; i < 3; ++i) append(bytes, newOrder(++id, 100, 1, 0));
+        ASSERT_EQ(send(fds[1], bytes.data(), bytes.size(), 0), static_cast<ssize_t>(bytes.size()));
+    }
+    unsigned char junk[7] = {};
+    ASSERT_EQ(send(fds[1], junk, sizeof(junk), 0), 7);
+
+    LOB::DatagramReceiver receiver(8);
+    LOB::LockFreeQueue<LOB::OrderRequest> queue(8);
+    LOB::OrderRequest out[8];
+
+    EXPECT_EQ(receiver.poll(fds[0], queue), 8u);      // ring full mid-datagram
+    EXPECT_EQ(receiver.getDatagramCount(), 5u);
+    ASSERT_EQ(queue.pop_bulk(out, 8), 8u);
+    EXPECT_EQ(out[7].id, 8u);
+
+    EXPECT_EQ(receiver.poll(fds[0], queue), 4u);      // rest of the same batch
+    ASSERT_EQ(queue.pop_bulk(out, 8), 4u);
+    EXPECT_EQ(out[0].id, 9u);
+    EXPECT_EQ(out[3].id, 12u);
+    EXPECT_EQ(receiver.getMalformedCount(), 1u);
+
+    EXPECT_EQ(receiver.poll(fds[0], queue), 0u);      // socket drained
+    EXPECT_EQ(receiver.getDecodedCount(), 12u);
+    close(fds[0]);
+    close(fds[1]);
+}